@@ -60,45 +60,29 @@ BestNeighborStrategy::performSelectionOfBestNeighbor(const Interest& interest){
   Vector currentPosition = node->GetObject<MobilityModel> ()->GetPosition();
   //producer position
   std::tuple<double, double, double> producerLoc = getProducerLocation(interest);
-  
+  double prodX, prodY;
+  std::tie(prodX, prodY, std::ignore) = producerLoc;
+
   std::vector<uint32_t> relays;
-  std::vector<std::pair<uint32_t, double>> goodRelays;
-  std::pair<uint32_t, double> currentNode;
-  //initial values of selectedNeighbor are the current node (Id, Position)
-  double prevDistanceToProducer = 0; 
   double distanceToProducer = calculateDistanceToProducer(std::make_tuple(currentPosition.x, currentPosition.y, 0), producerLoc);
-  currentNode = std::make_pair(node->GetId(), distanceToProducer);
-
-  //search for the best neighbor, neighbor closest to the producer location
-  for (auto it = this->getNit().begin(); it != this->getNit().end(); it++) {
-    NFD_LOG_DEBUG(it->getId() << "\t [" << std::get<0>(it->getCurrentLocation()) <<", " << std::get<1>(it->getCurrentLocation()) << "]\t[" << std::get<0>(it->getPreviousLocation()) <<", " << std::get<1>(it->getPreviousLocation()) << "]");
-    prevDistanceToProducer = calculateDistanceToProducer(it->getPreviousLocation(), producerLoc); 
-    distanceToProducer = calculateDistanceToProducer(it->getCurrentLocation(), producerLoc);
-    if(distanceToProducer <= prevDistanceToProducer){ //node is getting closer to producer
-      if(distanceToProducer <= currentNode.second){ //neighbor is more closer than current node
-          goodRelays.push_back({it->getId(), distanceToProducer});
-          // selectedNeighbor.first = it->getId();
-          // selectedNeighbor.second = distanceToProducer;
-      }
-    }
-  }
 
-  //Check if potencial relays set is empty?
-  if(goodRelays.empty()){
-    return relays;
-  }
-  //Sort all potencial relays by shortest distance
-  std::sort(goodRelays.begin(), goodRelays.end(), [](auto &left, auto &right) { return left.second < right.second; });
-
-  //Select the best N neighbors
-  std::vector<std::pair<uint32_t, double>>::iterator it;
-  for (it = goodRelays.begin(); it != goodRelays.end(); it++)
-  {
-    NFD_LOG_DEBUG("Relay " << it->first << " chosen.");
-    relays.push_back(it->first);
-    if(relays.size() == m_nRelays) break;
+  //neighbor is getting closer to producer
+  auto isGettingCloser = [=] (const neighbor_table::Entry& entry) {
+    double curX, curY, prevX, prevY;
+    std::tie(curX, curY, std::ignore) = entry.getCurrentLocation();
+    std::tie(prevX, prevY, std::ignore) = entry.getPreviousLocation();
+    return (curX - prodX) * (curX - prodX) + (curY - prodY) * (curY - prodY) <=
+           (prevX - prodX) * (prevX - prodX) + (prevY - prodY) * (prevY - prodY);
+  };
+
+  //search for the best N neighbors closer to the producer location than the current node
+  auto goodRelays = this->getNit().findNearest(prodX, prodY, m_nRelays > 0 ? m_nRelays : 0,
+                                               distanceToProducer, isGettingCloser);
+  for (const neighbor_table::Entry* entry : goodRelays) {
+    NFD_LOG_DEBUG("Relay " << entry->getId() << " chosen.\t [" << std::get<0>(entry->getCurrentLocation()) <<", " << std::get<1>(entry->getCurrentLocation()) << "]\t[" << std::get<0>(entry->getPreviousLocation()) <<", " << std::get<1>(entry->getPreviousLocation()) << "]");
+    relays.push_back(entry->getId());
   }
-  
+
   return relays;
 }
 
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "broadcast-suppression.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+
+#include <ndn-cxx/util/random.hpp>
+
+#include <cmath>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT(BroadcastSuppression);
+
+const time::nanoseconds BroadcastSuppression::DEFAULT_MIN_DELAY = 1_ms;
+const time::nanoseconds BroadcastSuppression::DEFAULT_MAX_DELAY = 10_ms;
+
+BroadcastSuppression::BroadcastSuppression(const FaceTable& faceTable, SendInterest sendInterest,
+                                           time::nanoseconds minDelay, time::nanoseconds maxDelay)
+  : m_faceTable(faceTable)
+  , m_sendInterest(std::move(sendInterest))
+  , m_minDelay(minDelay)
+  , m_maxDelay(maxDelay)
+{
+  if (m_minDelay < 0_ns) {
+    NDN_THROW(std::invalid_argument("minDelay must be non-negative"));
+  }
+  if (m_maxDelay < m_minDelay) {
+    NDN_THROW(std::invalid_argument("maxDelay cannot be smaller than minDelay"));
+  }
+}
+
+bool
+BroadcastSuppression::isRebroadcast(const Face& inFace, const Face& outFace)
+{
+  return outFace.getLinkType() == ndn::nfd::LINK_TYPE_AD_HOC &&
+         inFace.getScope() == ndn::nfd::FACE_SCOPE_NON_LOCAL;
+}
+
+time::nanoseconds
+BroadcastSuppression::computeDelay(const NeighborTable& nit, double x, double y,
+                                   double targetX, double targetY) const
+{
+  size_t nNeighbors = nit.size();
+  size_t nCloser = 0;
+  if (nNeighbors > 0) {
+    double distance = std::hypot(targetX - x, targetY - y);
+    nCloser = nit.findNearest(targetX, targetY, 0, distance).size();
+  }
+
+  auto range = (m_maxDelay - m_minDelay).count();
+  std::uniform_int_distribution<time::nanoseconds::rep> jitterDist(0, range / (nNeighbors + 1));
+  auto delay = m_minDelay.count() + range * static_cast<double>(nCloser) / (nNeighbors + 1) +
+               jitterDist(ndn::random::getRandomNumberEngine());
+  return std::min(time::nanoseconds(static_cast<time::nanoseconds::rep>(delay)), m_maxDelay);
+}
+
+time::nanoseconds
+BroadcastSuppression::computeRandomDelay() const
+{
+  std::uniform_int_distribution<time::nanoseconds::rep> delayDist(m_minDelay.count(),
+                                                                  m_maxDelay.count());
+  return time::nanoseconds(delayDist(ndn::random::getRandomNumberEngine()));
+}
+
+void
+BroadcastSuppression::scheduleRebroadcast(const shared_ptr<pit::Entry>& pitEntry, Face& outFace,
+                                          const Interest& interest, time::nanoseconds delay)
+{
+  PitInfo* pi = pitEntry->insertStrategyInfo<PitInfo>().first;
+  PitInfo::Pending& pending = pi->pending[outFace.getId()];
+  pending.nonce = interest.getNonce();
+  pending.interest = make_shared<Interest>(interest);
+  pending.timer = getScheduler().schedule(delay,
+    [this, weak = weak_ptr<pit::Entry>(pitEntry), faceId = outFace.getId()] {
+      onTimeout(weak, faceId);
+    });
+  ++m_counters.nScheduled;
+
+  NFD_LOG_DEBUG("scheduleRebroadcast " << interest << " to=" << outFace.getId()
+                << " delay=" << delay);
+}
+
+void
+BroadcastSuppression::afterReceiveLoopedInterest(const FaceEndpoint& ingress,
+                                                 const Interest& interest, pit::Entry& pitEntry)
+{
+  PitInfo* pi = pitEntry.getStrategyInfo<PitInfo>();
+  if (pi == nullptr) {
+    return;
+  }
+
+  auto it = pi->pending.find(ingress.face.getId());
+  if (it == pi->pending.end() || it->second.nonce != interest.getNonce()) {
+    return;
+  }
+
+  NFD_LOG_DEBUG("afterReceiveLoopedInterest " << interest << " in=" << ingress << " suppressed");
+  pi->pending.erase(it);
+  ++m_counters.nSuppressed;
+}
+
+void
+BroadcastSuppression::onTimeout(const weak_ptr<pit::Entry>& pitEntryWeak, FaceId faceId)
+{
+  // the timer is canceled when the PIT entry is erased, or the rebroadcast replaced
+  shared_ptr<pit::Entry> pitEntry = pitEntryWeak.lock();
+  BOOST_ASSERT(pitEntry != nullptr);
+  PitInfo* pi = pitEntry->getStrategyInfo<PitInfo>();
+  BOOST_ASSERT(pi != nullptr);
+  auto it = pi->pending.find(faceId);
+  BOOST_ASSERT(it != pi->pending.end());
+  shared_ptr<const Interest> interest = std::move(it->second.interest);
+  pi->pending.erase(it);
+
+  Face* outFace = m_faceTable.get(faceId);
+  if (pitEntry->isSatisfied || outFace == nullptr) {
+    NFD_LOG_DEBUG("onTimeout " << *interest << " to=" << faceId << " canceled");
+    ++m_counters.nCanceled;
+    return;
+  }
+
+  NFD_LOG_DEBUG("onTimeout " << *interest << " to=" << faceId << " rebroadcast");
+  ++m_counters.nRebroadcast;
+  m_sendInterest(pitEntry, *outFace, *interest);
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_BROADCAST_SUPPRESSION_HPP
+#define NFD_DAEMON_FW_BROADCAST_SUPPRESSION_HPP
+
+#include "face-table.hpp"
+#include "strategy-info.hpp"
+#include "common/counter.hpp"
+#include "face/face-endpoint.hpp"
+#include "table/neighbor-table.hpp"
+#include "table/pit-entry.hpp"
+
+#include <map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief deferred rebroadcast of Interests on ad hoc faces
+ *
+ *  Instead of rebroadcasting an Interest immediately, a strategy schedules it after a delay that
+ *  is shorter for nodes closer to the target location.  If the same Interest (same name and
+ *  Nonce) is overheard on the same ad hoc face before the delay expires, a neighbor has already
+ *  rebroadcast it, and the pending rebroadcast is canceled.
+ *
+ *  Pending rebroadcasts are kept on the PIT entry, so that they are canceled when the PIT entry
+ *  is erased.  A strategy using this module should forward its afterReceiveLoopedInterest
+ *  trigger to \c afterReceiveLoopedInterest of the module.
+ */
+class BroadcastSuppression : noncopyable
+{
+public:
+  /** \brief sends an Interest to a face, usually Strategy::sendInterest
+   */
+  using SendInterest = std::function<void(const shared_ptr<pit::Entry>& pitEntry, Face& outFace,
+                                          const Interest& interest)>;
+
+  /** \brief counters of deferred rebroadcasts
+   */
+  class Counters
+  {
+  public:
+    PacketCounter nScheduled;   ///< rebroadcasts scheduled
+    PacketCounter nRebroadcast; ///< rebroadcasts sent after their delay
+    PacketCounter nSuppressed;  ///< rebroadcasts canceled by an overheard duplicate
+    PacketCounter nCanceled;    ///< rebroadcasts dropped because the Interest was satisfied
+                                ///< or the face was closed
+  };
+
+  explicit
+  BroadcastSuppression(const FaceTable& faceTable, SendInterest sendInterest,
+                       time::nanoseconds minDelay = DEFAULT_MIN_DELAY,
+                       time::nanoseconds maxDelay = DEFAULT_MAX_DELAY);
+
+  /** \return whether forwarding from \p inFace to \p outFace is a rebroadcast that can be
+   *          deferred, i.e. \p outFace is an ad hoc face and \p inFace is not a local application
+   */
+  static bool
+  isRebroadcast(const Face& inFace, const Face& outFace);
+
+  /** \brief computes the rebroadcast delay of a node at (x, y) towards (targetX, targetY)
+   *
+   *  The delay grows with the fraction of neighbors in \p nit that are closer to the target than
+   *  the node itself, so that the node closest to the target rebroadcasts first and the others
+   *  overhear it.  A random jitter smaller than the difference between two ranks separates nodes
+   *  with the same rank.
+   */
+  time::nanoseconds
+  computeDelay(const NeighborTable& nit, double x, double y,
+               double targetX, double targetY) const;
+
+  /** \brief computes a uniformly random rebroadcast delay, when no target location is known
+   */
+  time::nanoseconds
+  computeRandomDelay() const;
+
+  /** \brief schedules rebroadcast of \p interest to \p outFace after \p delay
+   *
+   *  A rebroadcast already pending on \p outFace for the same PIT entry is replaced.
+   */
+  void
+  scheduleRebroadcast(const shared_ptr<pit::Entry>& pitEntry, Face& outFace,
+                      const Interest& interest, time::nanoseconds delay);
+
+  /** \brief cancels the pending rebroadcast on \p ingress if \p interest is its duplicate
+   */
+  void
+  afterReceiveLoopedInterest(const FaceEndpoint& ingress, const Interest& interest,
+                             pit::Entry& pitEntry);
+
+  const Counters&
+  getCounters() const
+  {
+    return m_counters;
+  }
+
+public:
+  /** \brief StrategyInfo on PIT entry
+   */
+  class PitInfo : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1050;
+    }
+
+  public:
+    struct Pending
+    {
+      uint32_t nonce;
+      shared_ptr<const Interest> interest;
+      scheduler::ScopedEventId timer;
+    };
+
+    std::map<FaceId, Pending> pending;
+  };
+
+private:
+  void
+  onTimeout(const weak_ptr<pit::Entry>& pitEntryWeak, FaceId faceId);
+
+public:
+  static const time::nanoseconds DEFAULT_MIN_DELAY;
+  static const time::nanoseconds DEFAULT_MAX_DELAY;
+
+private:
+  const FaceTable& m_faceTable;
+  SendInterest m_sendInterest;
+  const time::nanoseconds m_minDelay;
+  const time::nanoseconds m_maxDelay;
+  Counters m_counters;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_BROADCAST_SUPPRESSION_HPP
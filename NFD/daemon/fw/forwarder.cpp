@@ -140,8 +140,11 @@ Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& inter
     return;
   }
 
+  // hash every prefix of the name once, for both the Dead Nonce List and the PIT
+  name_tree::HashSequence nameHashes = name_tree::computeHashes(interest.getName());
+
   // detect duplicate Nonce with Dead Nonce List
-  bool hasDuplicateNonceInDnl = m_deadNonceList.has(interest.getName(), interest.getNonce());
+  bool hasDuplicateNonceInDnl = m_deadNonceList.has(nameHashes.back(), interest.getNonce());
   if (hasDuplicateNonceInDnl) {
     // goto Interest loop pipeline
     this->onInterestLoop(ingress, interest);
@@ -157,7 +160,7 @@ Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& inter
   }
 
   // PIT insert
-  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest, nameHashes).first;
 
   // detect duplicate Nonce in PIT entry
   int dnw = fw::findDuplicateNonce(*pitEntry, interest.getNonce(), ingress.face);
@@ -624,7 +627,7 @@ Forwarder::onNewNextHop(const Name& prefix, const fib::NextHop& nextHop)
       }
       // current nte has buffered Interests but no fibEntry (except for the root nte) and the strategy
       // enables new nexthop behavior, we enumerate the current nte and keep visiting its children.
-      if (nte.getName().size() == 0 ||
+      if (nte.getDepth() == 0 ||
           (strategy != nullptr && strategy->wantNewNextHopTrigger() &&
           fibEntry == nullptr && nte.hasPitEntries())) {
         return {true, true};
@@ -677,19 +680,25 @@ Forwarder::insertDeadNonceList(pit::Entry& pitEntry, Face* upstream)
     return;
   }
 
-  // Dead Nonce List insert
+  // Dead Nonce List insert, reusing the hash of the PIT entry name from the name tree;
+  // the PIT entry is attached to a shorter prefix when its name ends with an implicit digest
+  // or exceeds NameTree::getMaxDepth(), in which case the full name must be hashed
+  const name_tree::Entry* nte = m_nameTree.getEntry(pitEntry);
+  name_tree::HashValue nameHash = nte != nullptr && nte->getDepth() == pitEntry.getName().size() ?
+                                  name_tree::getNode(*nte)->hash :
+                                  name_tree::computeHash(pitEntry.getName());
   if (upstream == nullptr) {
     // insert all outgoing Nonces
     const auto& outRecords = pitEntry.getOutRecords();
     std::for_each(outRecords.begin(), outRecords.end(), [&] (const auto& outRecord) {
-      m_deadNonceList.add(pitEntry.getName(), outRecord.getLastNonce());
+      m_deadNonceList.add(nameHash, outRecord.getLastNonce());
     });
   }
   else {
     // insert outgoing Nonce of a specific face
     auto outRecord = pitEntry.getOutRecord(*upstream);
     if (outRecord != pitEntry.getOutRecords().end()) {
-      m_deadNonceList.add(pitEntry.getName(), outRecord->getLastNonce());
+      m_deadNonceList.add(nameHash, outRecord->getLastNonce());
     }
   }
 }
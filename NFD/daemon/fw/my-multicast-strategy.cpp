@@ -1,26 +1,17 @@
 #include "my-multicast-strategy.hpp"
 #include "algorithm.hpp"
 #include "common/logger.hpp"
+#include "table/name-tree-hashtable.hpp"
 
 #include "ns3/core-module.h"
 #include "ns3/network-module.h"
 #include "ns3/mobility-module.h"
 
 #include <ndn-cxx/lp/tags.hpp>
+#include <boost/functional/hash.hpp>
 #include <cmath>
 #include <string.h>
 
-class Point
-{
-private:
-  double x, y;
-public:
-  Point(double _x, double _y): x(_x), y(_y) {};
-  
-  double getX(){ return x;}
-  double getY(){ return y;}
-};
-
 using namespace ns3;
 
 namespace nfd {
@@ -32,6 +23,35 @@ NFD_LOG_INIT(MyMulticastStrategy);
 
 const time::milliseconds MyMulticastStrategy::RETX_SUPPRESSION_INITIAL(10);
 const time::milliseconds MyMulticastStrategy::RETX_SUPPRESSION_MAX(250);
+const double MyMulticastStrategy::FORWARDING_ZONE_WIDTH(2.0);
+const size_t MyMulticastStrategy::MAX_CACHED_ZONES(4096);
+
+constexpr double ForwardingZone::EPSILON;
+
+ForwardingZone
+ForwardingZone::fromEndpoints(double x1, double y1, double x2, double y2, double width)
+{
+  double length = std::hypot(x2 - x1, y2 - y1);
+  if (length == 0) {
+    return {x1, y1, 1, 0, -1, -1};
+  }
+  return {(x1 + x2) / 2, (y1 + y2) / 2, (x2 - x1) / length, (y2 - y1) / length,
+          length / 2, width / 2};
+}
+
+std::ostream&
+operator<<(std::ostream& os, const ForwardingZone& zone)
+{
+  // corners, starting at the producer end
+  double lx = zone.axisX * zone.halfLength;
+  double ly = zone.axisY * zone.halfLength;
+  double wx = zone.axisY * zone.halfWidth;
+  double wy = -zone.axisX * zone.halfWidth;
+  return os << "[" << zone.centerX + lx - wx << "," << zone.centerY + ly - wy << "] "
+            << "[" << zone.centerX + lx + wx << "," << zone.centerY + ly + wy << "] "
+            << "[" << zone.centerX - lx + wx << "," << zone.centerY - ly + wy << "] "
+            << "[" << zone.centerX - lx - wx << "," << zone.centerY - ly - wy << "]";
+}
 
 MyMulticastStrategy::MyMulticastStrategy(Forwarder& forwarder, const Name& name)
   : Strategy(forwarder)
@@ -39,6 +59,11 @@ MyMulticastStrategy::MyMulticastStrategy(Forwarder& forwarder, const Name& name)
   , m_retxSuppression(RETX_SUPPRESSION_INITIAL,
                       RetxSuppressionExponential::DEFAULT_MULTIPLIER,
                       RETX_SUPPRESSION_MAX)
+  , m_broadcastSuppression(getFaceTable(),
+                           [this] (const shared_ptr<pit::Entry>& pitEntry, Face& outFace,
+                                   const Interest& interest) {
+                             this->sendInterest(pitEntry, FaceEndpoint(outFace, 0), interest);
+                           })
           
 {
   ParsedInstanceName parsed = parseInstanceName(name);
@@ -52,78 +77,40 @@ MyMulticastStrategy::getStrategyName()
   return strategyName;
 }
 
-double areaTriangle(Point p1, Point p2, Point p3){
-  return abs(
-            p1.getX() * (p2.getY() - p3.getY()) + 
-            p2.getX() * (p3.getY() - p1.getY()) + 
-            p3.getX() * (p1.getY() - p2.getY())
-            ) / 2;
-}
-bool
-isInsideForwardingZone(std::vector<Point> fZone, Point cNode){
-  //divide the forwarging zone with the point of current node in triangles and calculate the area of each triangle
-  //area of triangle = absolute value of Ax(By - Cy) + Bx(Cy - Ay) + Cx(Ay - By) divided by 2.
-
-  //calculate area of forwarding zone
-  double totalArea = round((areaTriangle(fZone[0], fZone[1], fZone[2]) + // (P1, P2, P3) + (P1, P4, P2)
-                    areaTriangle(fZone[0], fZone[3], fZone[2])) * 100
-                    ) / 100;
-  //std::cout << "Total Area = " << totalArea << std::endl;
-
-  //calculate the sum of all new created triangles area
-  double sumArea = round((areaTriangle(fZone[0], cNode, fZone[1]) +  // (P1, X, P2)
-                  areaTriangle(fZone[1], cNode, fZone[2]) + // (P2, X, P3)
-                  areaTriangle(fZone[2], cNode, fZone[3]) + // (P3, X, P4)
-                  areaTriangle(fZone[3], cNode, fZone[0])) * 100 // (P4, X, P1)
-                ) / 100;
-
-  //std::cout << "Sum Area = " << sumArea << std::endl;
-
-  if(sumArea <= totalArea){
-    std::cout << "Inside Forwarding Zone" << std::endl;
-    return true;
+const ForwardingZone&
+MyMulticastStrategy::getForwardingZone(const Interest& interest)
+{
+  std::shared_ptr<ndn::lp::GeoTag> consumerTag = interest.getTag<ndn::lp::GeoTag>();
+  double consumerX = std::get<0>(consumerTag->getPos());
+  double consumerY = std::get<1>(consumerTag->getPos());
+
+  size_t hash = name_tree::computeHash(interest.getName(), 2);
+  boost::hash_combine(hash, consumerX);
+  boost::hash_combine(hash, consumerY);
+
+  auto it = m_zones.find(hash);
+  if (it != m_zones.end() && it->second.consumerX == consumerX &&
+      it->second.consumerY == consumerY &&
+      interest.getName().compare(0, 2, it->second.producerPrefix) == 0) {
+    return it->second.zone;
   }
-  return false;
 
-}
-std::vector<Point>
-defForwardingZone(Point p1, Point p2, int width = 2){
-  //calculate vector between p1 and p2
-  Point V(p2.getX() - p1.getX(), p2.getY() - p1.getY());
-
-  //calculate a perpendicular to vector previously created
-  Point P(V.getY(), -V.getX());
-
-  //normalize perpendicular vector and apply half of width
-  double pLength = sqrt(P.getX() * P.getX() + P.getY() * P.getY());
-  double hWidth = width / 2;
-  Point N(hWidth * P.getX() / pLength, hWidth * P.getY() / pLength);
-
-  //calculate all 4 necessary points
-  Point r1(p2.getX() - N.getX(), p2.getY()  - N.getY());
-  Point r2(p2.getX() + N.getX(), p2.getY()  + N.getY());    
-  Point r3(p1.getX() + N.getX(), p1.getY() + N.getY());
-  Point r4(p1.getX() - N.getX(), p1.getY() - N.getY());
-  std::vector<Point> points{r1,r2,r3,r4};
-
-  for (size_t i = 0; i < points.size(); i++)
-    std::cout << "Point[" << i << "] = " << points[i].getX() << ',' << points[i].getY() << std::endl;
-
-  return points;
-}
-
-Point
-getProducerLocation(const Interest& interest){
-  Name interestName = interest.getName().getPrefix(2);  
-  Point p(std::stod(interestName.get(0).toUri()), std::stod(interestName.get(1).toUri()));
-  return p;
-}
+  if (it == m_zones.end() && m_zones.size() >= MAX_CACHED_ZONES) {
+    m_zones.clear();
+  }
 
-Point
-getConsumerLocation(const Interest& interest){
-  std::shared_ptr<ndn::lp::GeoTag> consumerTag = interest.getTag<ndn::lp::GeoTag>();
-  Point p(std::get<0>(consumerTag->getPos()), std::get<1>(consumerTag->getPos()));
-  return p;
+  //producer location is in the first two name components
+  Name producerPrefix = interest.getName().getPrefix(2);
+  double producerX = std::stod(producerPrefix.get(0).toUri());
+  double producerY = std::stod(producerPrefix.get(1).toUri());
+
+  CachedZone& cached = m_zones[hash];
+  cached = {consumerX, consumerY, std::move(producerPrefix),
+            ForwardingZone::fromEndpoints(consumerX, consumerY, producerX, producerY,
+                                          FORWARDING_ZONE_WIDTH)};
+  NFD_LOG_DEBUG("Forwarding zone " << cached.zone << " for consumer [" << consumerX << ","
+                << consumerY << "] and producer [" << producerX << "," << producerY << "]");
+  return cached.zone;
 }
 
 void
@@ -135,24 +122,19 @@ MyMulticastStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Int
   auto node = ns3::NodeList::GetNode(Simulator::GetContext());
   Vector position = node->GetObject<MobilityModel> ()->GetPosition();
 
-  Point currentPosition{ position.x, position.y};
-  Point consumerLocation = getConsumerLocation(interest);
-  Point producerLocation = getProducerLocation(interest);
-  std::cout << "Current Location: " << currentPosition.getX() <<","<< currentPosition.getY() << std::endl;
-  std::cout << "Consumer Location: " << consumerLocation.getX() <<","<< consumerLocation.getY() << std::endl;
-  std::cout << "Producer Location: " << producerLocation.getX() <<","<< producerLocation.getY() << std::endl;
-  
-  std::vector<Point> forwardingZone = defForwardingZone(consumerLocation, producerLocation);
+  const ForwardingZone& forwardingZone = getForwardingZone(interest);
+  bool isInside = forwardingZone.contains(position.x, position.y);
+  this->afterZoneCheck(interest, forwardingZone, position.x, position.y, isInside);
 
-  if(isInsideForwardingZone(forwardingZone, currentPosition)) {
+  if(isInside) {
     //Node is inside Forwarding zone
+    NFD_LOG_DEBUG("Node at position [" << position.x << "," << position.y << "] is inside forwarding zone");
     const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
     const fib::NextHopList& nexthops = fibEntry.getNextHops();
 
     int nEligibleNextHops = 0;
     bool isSuppressed = false;
     NFD_LOG_DEBUG("nexthops size= " << nexthops.size());
-    std::cout << "nexthops size= " << nexthops.size() << std::endl;
     for (const auto& nexthop : nexthops) {
       Face& outFace = nexthop.getFace();
 
@@ -169,6 +151,17 @@ MyMulticastStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Int
         continue;
       }
 
+      if (BroadcastSuppression::isRebroadcast(ingress.face, outFace)) {
+        // nodes closer to the producer end of the zone rebroadcast first
+        double targetX = forwardingZone.centerX + forwardingZone.axisX * forwardingZone.halfLength;
+        double targetY = forwardingZone.centerY + forwardingZone.axisY * forwardingZone.halfLength;
+        auto delay = m_broadcastSuppression.computeDelay(this->getNit(), position.x, position.y,
+                                                         targetX, targetY);
+        m_broadcastSuppression.scheduleRebroadcast(pitEntry, outFace, interest, delay);
+        ++nEligibleNextHops;
+        continue;
+      }
+
       this->sendInterest(pitEntry, FaceEndpoint(outFace, 0), interest);
       NFD_LOG_DEBUG(interest << " from=" << ingress << " pitEntry-to=" << outFace.getId());
       
@@ -178,7 +171,7 @@ MyMulticastStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Int
       ++nEligibleNextHops;
     }
   } else {
-    std::cout << "Node at position [" << currentPosition.getX() << "," << currentPosition.getY() << "] is not inside forwarding zone" << std::endl;
+    NFD_LOG_DEBUG("Node at position [" << position.x << "," << position.y << "] is not inside forwarding zone");
     this->rejectPendingInterest(pitEntry);
   }
 
@@ -192,6 +185,13 @@ MyMulticastStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Int
   //   this->rejectPendingInterest(pitEntry);
   // }
 }
+void
+MyMulticastStrategy::afterReceiveLoopedInterest(const FaceEndpoint& ingress, const Interest& interest,
+                                                pit::Entry& pitEntry)
+{
+  m_broadcastSuppression.afterReceiveLoopedInterest(ingress, interest, pitEntry);
+}
+
 //Como os links são ad-hoc, o pacote nack é deitado fora
 void
 MyMulticastStrategy::afterReceiveNack(const FaceEndpoint& ingress, const lp::Nack& nack,
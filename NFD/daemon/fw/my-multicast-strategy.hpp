@@ -2,12 +2,54 @@
 #define NFD_DAEMON_FW_MY_MULTICAST_STRATEGY_HPP
 
 #include "strategy.hpp"
+#include "broadcast-suppression.hpp"
 #include "process-nack-traits.hpp"
 #include "retx-suppression-exponential.hpp"
 
+#include <cmath>
+#include <unordered_map>
+
 namespace nfd {
 namespace fw {
 
+/** \brief rectangular forwarding zone between a consumer and a producer
+ *
+ *  The zone is stored as an oriented bounding box: its center, the unit vector from the
+ *  consumer towards the producer, and half of its length and width.
+ */
+struct ForwardingZone
+{
+  /** \brief constructs the zone of the segment from (x1, y1) to (x2, y2)
+   *
+   *  The zone is empty if both ends are the same point.
+   */
+  static ForwardingZone
+  fromEndpoints(double x1, double y1, double x2, double y2, double width);
+
+  /** \return whether (x, y) is inside the zone or on its border
+   */
+  bool
+  contains(double x, double y) const
+  {
+    double dx = x - centerX;
+    double dy = y - centerY;
+    return std::abs(dx * axisX + dy * axisY) <= halfLength + EPSILON &&
+           std::abs(dy * axisX - dx * axisY) <= halfWidth + EPSILON;
+  }
+
+  static constexpr double EPSILON = 1e-6;
+
+  double centerX;
+  double centerY;
+  double axisX;
+  double axisY;
+  double halfLength;
+  double halfWidth;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const ForwardingZone& zone);
+
 /** \brief a forwarding strategy that forwards Interest to all FIB nexthops
  *
  *  \note This strategy is not EndpointId-aware.
@@ -26,17 +68,58 @@ public:
   afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
                        const shared_ptr<pit::Entry>& pitEntry) override;
 
+  void
+  afterReceiveLoopedInterest(const FaceEndpoint& ingress, const Interest& interest,
+                             pit::Entry& pitEntry) override;
+
   void
   afterReceiveNack(const FaceEndpoint& ingress, const lp::Nack& nack,
                    const shared_ptr<pit::Entry>& pitEntry) override;
 
+  const BroadcastSuppression&
+  getBroadcastSuppression() const
+  {
+    return m_broadcastSuppression;
+  }
+
+public:
+  /** \brief signals the decision whether an Interest is forwarded
+   *
+   *  Arguments are the Interest, its forwarding zone, the x and y coordinates of the current
+   *  node, and whether the node is inside the zone.  Nothing is printed unless a scenario
+   *  connects to this signal.
+   */
+  signal::Signal<MyMulticastStrategy, Interest, ForwardingZone, double, double, bool> afterZoneCheck;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief gets the forwarding zone of an Interest
+   *
+   *  The zone is determined by the consumer location in the GeoTag, and the producer location
+   *  in the first two name components.  Zones are cached, so that the producer location is only
+   *  parsed when a consumer location or producer prefix is seen for the first time.
+   */
+  const ForwardingZone&
+  getForwardingZone(const Interest& interest);
+
 private:
+  struct CachedZone
+  {
+    double consumerX;
+    double consumerY;
+    Name producerPrefix;
+    ForwardingZone zone;
+  };
+
   friend ProcessNackTraits<MyMulticastStrategy>;
   RetxSuppressionExponential m_retxSuppression;
+  BroadcastSuppression m_broadcastSuppression;
+  std::unordered_map<size_t, CachedZone> m_zones; // by hash of consumer location and producer prefix
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   static const time::milliseconds RETX_SUPPRESSION_INITIAL;
   static const time::milliseconds RETX_SUPPRESSION_MAX;
+  static const double FORWARDING_ZONE_WIDTH;
+  static const size_t MAX_CACHED_ZONES;
 };
 
 } // namespace fw
@@ -22,6 +22,11 @@ NFD_LOG_INIT(NeighborhoodStrategy);
 
 NeighborhoodStrategy::NeighborhoodStrategy(Forwarder& forwarder, const Name& name)
   : Strategy(forwarder)
+  , m_broadcastSuppression(getFaceTable(),
+                           [this] (const shared_ptr<pit::Entry>& pitEntry, Face& outFace,
+                                   const Interest& interest) {
+                             this->sendInterest(pitEntry, FaceEndpoint(outFace, 0), interest);
+                           })
   , entryLifetime(5_s)
           
 {
@@ -57,12 +62,26 @@ NeighborhoodStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const In
         continue;
       }
 
+      if (BroadcastSuppression::isRebroadcast(ingress.face, outFace)) {
+        // no target location is known, so the first neighbor to rebroadcast suppresses the others
+        m_broadcastSuppression.scheduleRebroadcast(pitEntry, outFace, interest,
+                                                   m_broadcastSuppression.computeRandomDelay());
+        continue;
+      }
+
       this->sendInterest(pitEntry, FaceEndpoint(outFace, 0), interest);
       NFD_LOG_DEBUG(interest << " from=" << ingress << " pitEntry-to=" << outFace.getId());
       
     }
 }
 
+void
+NeighborhoodStrategy::afterReceiveLoopedInterest(const FaceEndpoint& ingress, const Interest& interest,
+                                                 pit::Entry& pitEntry)
+{
+  m_broadcastSuppression.afterReceiveLoopedInterest(ingress, interest, pitEntry);
+}
+
 void
 NeighborhoodStrategy::afterReceiveData(const shared_ptr<pit::Entry>& pitEntry, const FaceEndpoint& ingress, const Data& data)
 {
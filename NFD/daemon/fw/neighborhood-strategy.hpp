@@ -2,6 +2,7 @@
 #define NFD_DAEMON_FW_NEIGHBORHOOD_STRATEGY_HPP
 
 #include "strategy.hpp"
+#include "broadcast-suppression.hpp"
 
 namespace nfd {
 namespace fw {
@@ -23,13 +24,24 @@ public:
   afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
                        const shared_ptr<pit::Entry>& pitEntry) override;
 
+  void
+  afterReceiveLoopedInterest(const FaceEndpoint& ingress, const Interest& interest,
+                             pit::Entry& pitEntry) override;
+
   void
   afterReceiveData(const shared_ptr<pit::Entry>& pitEntry,
                    const FaceEndpoint& ingress, const Data& data);
   void
   onNitEntryExpires(neighbor_table::Entry *entry);
 
+  const BroadcastSuppression&
+  getBroadcastSuppression() const
+  {
+    return m_broadcastSuppression;
+  }
+
 private:
+  BroadcastSuppression m_broadcastSuppression;
   time::milliseconds entryLifetime; ///< @brief time of NIT entry lifetime
 };
 
@@ -76,6 +76,18 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
     }
   }
 
+  bool wantCsHashIndex = false;
+  OptionalConfigSection csIndexNode = section.get_child_optional("cs_index");
+  if (csIndexNode) {
+    std::string indexName = csIndexNode->get_value<std::string>();
+    if (indexName == "hash") {
+      wantCsHashIndex = true;
+    }
+    else if (indexName != "ordered") {
+      NDN_THROW(ConfigFile::Error("Unknown cs_index '" + indexName + "' in section 'tables'"));
+    }
+  }
+
   unique_ptr<fw::UnsolicitedDataPolicy> unsolicitedDataPolicy;
   OptionalConfigSection unsolicitedDataPolicyNode = section.get_child_optional("cs_unsolicited_policy");
   if (unsolicitedDataPolicyNode) {
@@ -108,6 +120,7 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
   if (cs.size() == 0 && csPolicy != nullptr) {
     cs.setPolicy(std::move(csPolicy));
   }
+  cs.enableHashIndex(wantCsHashIndex);
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
 
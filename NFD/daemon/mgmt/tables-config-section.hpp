@@ -39,6 +39,7 @@ namespace nfd {
  *  {
  *    cs_max_packets 65536
  *    cs_policy lru
+ *    cs_index ordered
  *    cs_unsolicited_policy drop-all
  *
  *    strategy_choice
@@ -58,7 +59,7 @@ namespace nfd {
  *  \endcode
  *
  *  During a configuration reload,
- *  \li cs_max_packets, cs_policy, and cs_unsolicited_policy are applied;
+ *  \li cs_max_packets, cs_policy, cs_index, and cs_unsolicited_policy are applied;
  *      defaults are used if an option is omitted.
  *  \li strategy_choice entries are inserted, but old entries are not deleted.
  *  \li network_region is applied; it's kept unchanged if the section is omitted.
@@ -44,7 +44,7 @@ cleanupOnFaceRemoval(NameTree& nt, Fib& fib, Pit& pit, const Face& face)
     }
 
     if (!nte.hasTableEntries()) {
-      maybeEmptyNtes.emplace(nte.getName().size(), &nte);
+      maybeEmptyNtes.emplace(nte.getDepth(), &nte);
     }
   }
 
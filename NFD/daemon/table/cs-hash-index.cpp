@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-hash-index.hpp"
+
+namespace nfd {
+namespace cs {
+
+static size_t
+computeMinSlots(size_t nInitialSlots)
+{
+  // the number of slots must be a power of two, so that the index is computed with a mask
+  size_t nSlots = 16;
+  while (nSlots < nInitialSlots) {
+    nSlots *= 2;
+  }
+  return nSlots;
+}
+
+HashIndex::HashIndex(size_t nInitialSlots)
+  : m_slots(computeMinSlots(nInitialSlots))
+  , m_mask(m_slots.size() - 1)
+  , m_nMinSlots(m_slots.size())
+{
+}
+
+void
+HashIndex::insert(HashValue h, Table::const_iterator entry)
+{
+  // keep load factor at or below 1/2, so that probe sequences stay short
+  if ((m_size + 1) * 2 > m_slots.size()) {
+    this->resize(m_slots.size() * 2);
+  }
+
+  this->insertSlot(h, entry);
+  ++m_size;
+}
+
+void
+HashIndex::insertSlot(HashValue h, Table::const_iterator entry)
+{
+  size_t i = h & m_mask;
+  while (m_slots[i].isOccupied) {
+    i = (i + 1) & m_mask;
+  }
+  m_slots[i].hash = h;
+  m_slots[i].entry = entry;
+  m_slots[i].isOccupied = true;
+}
+
+void
+HashIndex::erase(HashValue h, Table::const_iterator entry)
+{
+  size_t i = h & m_mask;
+  while (!(m_slots[i].isOccupied && m_slots[i].hash == h && m_slots[i].entry == entry)) {
+    BOOST_ASSERT(m_slots[i].isOccupied);
+    i = (i + 1) & m_mask;
+  }
+
+  // backward shift deletion: move later slots of the same probe sequence into the hole,
+  // so that lookups can stop at the first empty slot without tombstones
+  size_t hole = i;
+  for (size_t j = (i + 1) & m_mask; m_slots[j].isOccupied; j = (j + 1) & m_mask) {
+    size_t home = m_slots[j].hash & m_mask;
+    if (((j - home) & m_mask) >= ((j - hole) & m_mask)) {
+      m_slots[hole] = m_slots[j];
+      hole = j;
+    }
+  }
+  m_slots[hole] = Slot();
+  --m_size;
+
+  if (m_size * 8 < m_slots.size() && m_slots.size() > m_nMinSlots) {
+    this->resize(m_slots.size() / 2);
+  }
+}
+
+void
+HashIndex::clear()
+{
+  m_slots.assign(m_nMinSlots, Slot());
+  m_mask = m_slots.size() - 1;
+  m_size = 0;
+}
+
+void
+HashIndex::resize(size_t nSlots)
+{
+  std::vector<Slot> oldSlots(nSlots);
+  m_slots.swap(oldSlots);
+  m_mask = m_slots.size() - 1;
+
+  for (const Slot& slot : oldSlots) {
+    if (slot.isOccupied) {
+      this->insertSlot(slot.hash, slot.entry);
+    }
+  }
+}
+
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_HASH_INDEX_HPP
+#define NFD_DAEMON_TABLE_CS_HASH_INDEX_HPP
+
+#include "cs-entry.hpp"
+#include "name-tree-hashtable.hpp"
+
+namespace nfd {
+namespace cs {
+
+/** \brief an exact-match index of ContentStore entries
+ *
+ *  This index maps the hash of a Data name, as computed by \c name_tree::computeHash ,
+ *  to Table iterators. It is an open addressing hashtable with linear probing, so that
+ *  an exact-name lookup touches a few adjacent slots instead of walking the Table.
+ *  Several entries may share a Data name (e.g., with different implicit digests) or a hash
+ *  value; callers must verify each returned entry.
+ */
+class HashIndex : noncopyable
+{
+public:
+  using HashValue = name_tree::HashValue;
+
+  explicit
+  HashIndex(size_t nInitialSlots = 16);
+
+  /** \return number of indexed entries
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  /** \return number of slots
+   */
+  size_t
+  getNSlots() const
+  {
+    return m_slots.size();
+  }
+
+  /** \brief add \p entry whose Data name has hash value \p h
+   *  \pre \p entry is not in the index
+   */
+  void
+  insert(HashValue h, Table::const_iterator entry);
+
+  /** \brief remove \p entry whose Data name has hash value \p h
+   *  \pre \p entry is in the index
+   */
+  void
+  erase(HashValue h, Table::const_iterator entry);
+
+  /** \brief remove all entries
+   */
+  void
+  clear();
+
+  /** \brief invoke \p visit on every entry with hash value \p h
+   *  \tparam Visitor `void f(Table::const_iterator)`
+   */
+  template<typename Visitor>
+  void
+  find(HashValue h, const Visitor& visit) const
+  {
+    for (size_t i = h & m_mask; m_slots[i].isOccupied; i = (i + 1) & m_mask) {
+      if (m_slots[i].hash == h) {
+        visit(m_slots[i].entry);
+      }
+    }
+  }
+
+private:
+  void
+  resize(size_t nSlots);
+
+  void
+  insertSlot(HashValue h, Table::const_iterator entry);
+
+private:
+  struct Slot
+  {
+    HashValue hash = 0;
+    Table::const_iterator entry;
+    bool isOccupied = false;
+  };
+
+  std::vector<Slot> m_slots;
+  size_t m_mask;
+  size_t m_size = 0;
+  const size_t m_nMinSlots;
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_HASH_INDEX_HPP
@@ -80,6 +80,9 @@ Cs::insert(const Data& data, bool isUnsolicited)
     m_policy->afterRefresh(it);
   }
   else {
+    if (m_hashIndex != nullptr) {
+      m_hashIndex->insert(name_tree::computeHash(entry.getName()), it);
+    }
     m_policy->afterInsert(it);
   }
 }
@@ -104,7 +107,7 @@ Cs::eraseImpl(const Name& prefix, size_t limit)
   size_t nErased = 0;
   while (i != last && nErased < limit) {
     m_policy->beforeErase(i);
-    i = m_table.erase(i);
+    i = eraseEntry(i);
     ++nErased;
   }
   return nErased;
@@ -117,6 +120,10 @@ Cs::findImpl(const Interest& interest) const
     return m_table.end();
   }
 
+  if (m_hashIndex != nullptr && !interest.getCanBePrefix()) {
+    return findExactMatch(interest);
+  }
+
   const Name& prefix = interest.getName();
   auto range = findPrefixRange(prefix);
   auto match = std::find_if(range.first, range.second,
@@ -131,6 +138,43 @@ Cs::findImpl(const Interest& interest) const
   return match;
 }
 
+Cs::const_iterator
+Cs::findExactMatch(const Interest& interest) const
+{
+  // Entries are indexed by Data name, so an Interest name that ends with an implicit digest
+  // is also looked up without it. When several entries can satisfy the Interest, the first
+  // one in Table order is returned, as on the ordered lookup path.
+  auto match = m_table.end();
+  auto visit = [&] (const_iterator it) {
+    if (it->canSatisfy(interest) && (match == m_table.end() || *it < *match)) {
+      match = it;
+    }
+  };
+
+  const Name& name = interest.getName();
+  m_hashIndex->find(name_tree::computeHash(name), visit);
+  if (!name.empty() && name[-1].isImplicitSha256Digest()) {
+    m_hashIndex->find(name_tree::computeHash(name, name.size() - 1), visit);
+  }
+
+  if (match == m_table.end()) {
+    NFD_LOG_DEBUG("find " << name << " no-match");
+    return match;
+  }
+  NFD_LOG_DEBUG("find " << name << " matching " << match->getName());
+  m_policy->beforeUse(match);
+  return match;
+}
+
+Cs::const_iterator
+Cs::eraseEntry(const_iterator it)
+{
+  if (m_hashIndex != nullptr) {
+    m_hashIndex->erase(name_tree::computeHash(it->getName()), it);
+  }
+  return m_table.erase(it);
+}
+
 void
 Cs::dump()
 {
@@ -155,7 +199,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
 {
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
-  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { m_table.erase(it); });
+  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { eraseEntry(it); });
 
   m_policy->setCs(this);
   BOOST_ASSERT(m_policy->getCs() == this);
@@ -181,5 +225,24 @@ Cs::enableServe(bool shouldServe)
   NFD_LOG_INFO((shouldServe ? "Enabling" : "Disabling") << " Data serving");
 }
 
+void
+Cs::enableHashIndex(bool wantHashIndex)
+{
+  if (hasHashIndex() == wantHashIndex) {
+    return;
+  }
+  NFD_LOG_INFO((wantHashIndex ? "Enabling" : "Disabling") << " hash index");
+
+  if (!wantHashIndex) {
+    m_hashIndex.reset();
+    return;
+  }
+
+  m_hashIndex = make_unique<HashIndex>(m_table.size() * 2);
+  for (auto it = m_table.begin(); it != m_table.end(); ++it) {
+    m_hashIndex->insert(name_tree::computeHash(it->getName()), it);
+  }
+}
+
 } // namespace cs
 } // namespace nfd
@@ -26,6 +26,7 @@
 #ifndef NFD_DAEMON_TABLE_CS_HPP
 #define NFD_DAEMON_TABLE_CS_HPP
 
+#include "cs-hash-index.hpp"
 #include "cs-policy.hpp"
 
 namespace nfd {
@@ -40,6 +41,10 @@ namespace cs {
  *  and a few additional attributes such as when the Data becomes non-fresh.
  *
  *  The replacement policy is implemented in a subclass of \c Policy.
+ *
+ *  Optionally, a HashIndex maps Data names to Table entries. When it is enabled, an Interest
+ *  with CanBePrefix=false is answered from the HashIndex, while CanBePrefix lookups still use
+ *  the ordered Table.
  */
 class Cs : noncopyable
 {
@@ -157,6 +162,21 @@ public: // configuration
   void
   enableServe(bool shouldServe);
 
+  /** \brief get whether exact-match lookups use the hash index
+   */
+  bool
+  hasHashIndex() const
+  {
+    return m_hashIndex != nullptr;
+  }
+
+  /** \brief enable or disable the hash index for exact-match lookups
+   *
+   *  Enabling the hash index builds it from existing entries.
+   */
+  void
+  enableHashIndex(bool wantHashIndex);
+
 public: // enumeration
   using const_iterator = Table::const_iterator;
 
@@ -182,6 +202,17 @@ private:
   const_iterator
   findImpl(const Interest& interest) const;
 
+  /** \brief find the first entry in Table order that satisfies \p interest , using the hash index
+   *  \pre hasHashIndex() && !interest.getCanBePrefix()
+   */
+  const_iterator
+  findExactMatch(const Interest& interest) const;
+
+  /** \brief erase \p it from the Table and the hash index
+   */
+  const_iterator
+  eraseEntry(const_iterator it);
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
@@ -192,6 +223,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 private:
   Table m_table;
   unique_ptr<Policy> m_policy;
+  unique_ptr<HashIndex> m_hashIndex; ///< exact-match index, or nullptr if disabled
   signal::ScopedConnection m_beforeEvictConnection;
 
   bool m_shouldAdmit = true; ///< if false, no Data will be admitted
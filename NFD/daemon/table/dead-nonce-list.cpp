@@ -45,8 +45,8 @@ const size_t DeadNonceList::EVICT_LIMIT = 1 << 6;
 
 DeadNonceList::DeadNonceList(time::nanoseconds lifetime)
   : m_lifetime(lifetime)
-  , m_queue(m_index.get<0>())
-  , m_ht(m_index.get<1>())
+  , m_queue(INITIAL_CAPACITY)
+  , m_ht(INITIAL_CAPACITY * 2, MARK)
   , m_capacity(INITIAL_CAPACITY)
   , m_markInterval(m_lifetime / EXPECTED_MARK_COUNT)
   , m_adjustCapacityInterval(m_lifetime)
@@ -56,7 +56,7 @@ DeadNonceList::DeadNonceList(time::nanoseconds lifetime)
   }
 
   for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
-    m_queue.push_back(MARK);
+    this->pushBack(MARK);
   }
 
   m_markEvent = getScheduler().schedule(m_markInterval, [this] { mark(); });
@@ -71,6 +71,8 @@ DeadNonceList::~DeadNonceList()
   BOOST_ASSERT_MSG(DEFAULT_LIFETIME >= MIN_LIFETIME, "DEFAULT_LIFETIME is too small");
   static_assert(INITIAL_CAPACITY >= MIN_CAPACITY, "INITIAL_CAPACITY is too small");
   static_assert(INITIAL_CAPACITY <= MAX_CAPACITY, "INITIAL_CAPACITY is too large");
+  static_assert((INITIAL_CAPACITY & (INITIAL_CAPACITY - 1)) == 0,
+                "INITIAL_CAPACITY must be a power of two");
   BOOST_ASSERT_MSG(static_cast<size_t>(MIN_CAPACITY * CAPACITY_UP) > MIN_CAPACITY,
                    "CAPACITY_UP must be able to increase from MIN_CAPACITY");
   BOOST_ASSERT_MSG(static_cast<size_t>(MAX_CAPACITY * CAPACITY_DOWN) < MAX_CAPACITY,
@@ -83,43 +85,142 @@ DeadNonceList::~DeadNonceList()
 size_t
 DeadNonceList::size() const
 {
-  return m_queue.size() - this->countMarks();
+  return m_queueSize - this->countMarks();
 }
 
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
-  Entry entry = DeadNonceList::makeEntry(name, nonce);
-  return m_ht.find(entry) != m_ht.end();
+  return this->has(name_tree::computeHash(name), nonce);
+}
+
+bool
+DeadNonceList::has(name_tree::HashValue nameHash, uint32_t nonce) const
+{
+  Entry entry = DeadNonceList::makeEntry(nameHash, nonce);
+  return m_ht[this->findSlot(entry)] == entry;
 }
 
 void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
-  Entry entry = DeadNonceList::makeEntry(name, nonce);
-  m_queue.push_back(entry);
+  this->add(name_tree::computeHash(name), nonce);
+}
+
+void
+DeadNonceList::add(name_tree::HashValue nameHash, uint32_t nonce)
+{
+  Entry entry = DeadNonceList::makeEntry(nameHash, nonce);
+  this->pushBack(entry);
 
   this->evictEntries();
 }
 
 DeadNonceList::Entry
-DeadNonceList::makeEntry(const Name& name, uint32_t nonce)
+DeadNonceList::makeEntry(name_tree::HashValue nameHash, uint32_t nonce)
 {
-  Block nameWire = name.wireEncode();
-  return CityHash64WithSeed(reinterpret_cast<const char*>(nameWire.wire()), nameWire.size(),
-                            static_cast<uint64_t>(nonce));
+  Entry entry = Hash128to64({static_cast<uint64_t>(nameHash), static_cast<uint64_t>(nonce)});
+  return entry == MARK ? ~MARK : entry;
+}
+
+void
+DeadNonceList::pushBack(Entry entry)
+{
+  if (m_queueSize == m_queue.size()) {
+    // grow the ring buffer, moving entries so that the oldest one is at the front
+    std::rotate(m_queue.begin(), m_queue.begin() + m_queueHead, m_queue.end());
+    m_queue.resize(m_queue.size() * 2);
+    m_queueHead = 0;
+  }
+  m_queue[(m_queueHead + m_queueSize) & (m_queue.size() - 1)] = entry;
+  ++m_queueSize;
+
+  if (entry == MARK) {
+    ++m_nMarks;
+    return;
+  }
+
+  if ((m_htSize + 1) * 2 > m_ht.size()) {
+    this->resizeHashtable(m_ht.size() * 2);
+  }
+  size_t mask = m_ht.size() - 1;
+  size_t i = entry & mask;
+  while (m_ht[i] != MARK) {
+    i = (i + 1) & mask;
+  }
+  m_ht[i] = entry;
+  ++m_htSize;
+}
+
+void
+DeadNonceList::popFront()
+{
+  BOOST_ASSERT(m_queueSize > 0);
+  Entry entry = m_queue[m_queueHead];
+  m_queueHead = (m_queueHead + 1) & (m_queue.size() - 1);
+  --m_queueSize;
+
+  if (entry == MARK) {
+    --m_nMarks;
+    return;
+  }
+
+  // backward shift deletion, so that lookups can stop at the first empty slot
+  size_t mask = m_ht.size() - 1;
+  size_t hole = this->findSlot(entry);
+  BOOST_ASSERT(m_ht[hole] == entry);
+  for (size_t j = (hole + 1) & mask; m_ht[j] != MARK; j = (j + 1) & mask) {
+    size_t home = m_ht[j] & mask;
+    if (((j - home) & mask) >= ((j - hole) & mask)) {
+      m_ht[hole] = m_ht[j];
+      hole = j;
+    }
+  }
+  m_ht[hole] = MARK;
+  --m_htSize;
+}
+
+size_t
+DeadNonceList::findSlot(Entry entry) const
+{
+  size_t mask = m_ht.size() - 1;
+  size_t i = entry & mask;
+  while (m_ht[i] != entry && m_ht[i] != MARK) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+void
+DeadNonceList::resizeHashtable(size_t nSlots)
+{
+  BOOST_ASSERT(nSlots > m_htSize);
+  std::vector<Entry> oldHt(nSlots, MARK);
+  m_ht.swap(oldHt);
+
+  size_t mask = m_ht.size() - 1;
+  for (Entry entry : oldHt) {
+    if (entry == MARK) {
+      continue;
+    }
+    size_t i = entry & mask;
+    while (m_ht[i] != MARK) {
+      i = (i + 1) & mask;
+    }
+    m_ht[i] = entry;
+  }
 }
 
 size_t
 DeadNonceList::countMarks() const
 {
-  return m_ht.count(MARK);
+  return m_nMarks;
 }
 
 void
 DeadNonceList::mark()
 {
-  m_queue.push_back(MARK);
+  this->pushBack(MARK);
   size_t nMarks = this->countMarks();
   m_actualMarkCounts.insert(nMarks);
 
@@ -152,14 +253,19 @@ DeadNonceList::adjustCapacity()
 void
 DeadNonceList::evictEntries()
 {
-  ssize_t nOverCapacity = m_queue.size() - m_capacity;
+  ssize_t nOverCapacity = m_queueSize - m_capacity;
   if (nOverCapacity <= 0) // not over capacity
     return;
 
   for (ssize_t nEvict = std::min<ssize_t>(nOverCapacity, EVICT_LIMIT); nEvict > 0; --nEvict) {
-    m_queue.erase(m_queue.begin());
+    this->popFront();
+  }
+  BOOST_ASSERT(m_queueSize >= m_capacity);
+
+  // release memory after capacity has been adjusted down
+  if (m_htSize * 8 < m_ht.size() && m_ht.size() > INITIAL_CAPACITY * 2) {
+    this->resizeHashtable(m_ht.size() / 2);
   }
-  BOOST_ASSERT(m_queue.size() >= m_capacity);
 }
 
 } // namespace nfd
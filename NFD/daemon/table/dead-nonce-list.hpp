@@ -26,11 +26,7 @@
 #ifndef NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 #define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 
-#include "core/common.hpp"
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
+#include "name-tree-hashtable.hpp"
 
 namespace nfd {
 
@@ -40,10 +36,17 @@ namespace nfd {
  *  When a Nonce is erased (dead) from PIT entry, the Nonce and the Interest Name is added to
  *  Dead Nonce List, and kept for a duration in which most loops are expected to have occured.
  *
- *  To reduce memory usage, the Interest Name and Nonce are stored as a 64-bit hash.
+ *  To reduce memory usage, the Interest Name and Nonce are stored as a 64-bit hash,
+ *  which is derived from the name tree hash of the Interest Name.
  *  There could be false positives (non-looping Interest could be considered looping),
  *  but the probability is small, and the error is recoverable when consumer retransmits
  *  with a different Nonce.
+ *  Since the name tree hash combines component hashes with XOR, it does not depend on the
+ *  order of components: names that are permutations of each other (e.g., /a/b and /b/a)
+ *  collide, and are told apart only by their Nonces.
+ *
+ *  Entries are kept in insertion order in a ring buffer, and indexed by an open addressing
+ *  hashtable of the same 64-bit values, so that neither structure allocates per entry.
  *
  *  To reduce memory usage, entries do not have associated timestamps. Instead,
  *  lifetime of entries is controlled by dynamically adjusting the capacity of the container.
@@ -72,11 +75,24 @@ public:
   bool
   has(const Name& name, uint32_t nonce) const;
 
+  /** \brief Determines if name+nonce exists
+   *  \param nameHash name tree hash of the name, i.e., name_tree::computeHash(name)
+   *  \return true if name+nonce exists
+   */
+  bool
+  has(name_tree::HashValue nameHash, uint32_t nonce) const;
+
   /** \brief Records name+nonce
    */
   void
   add(const Name& name, uint32_t nonce);
 
+  /** \brief Records name+nonce
+   *  \param nameHash name tree hash of the name, i.e., name_tree::computeHash(name)
+   */
+  void
+  add(name_tree::HashValue nameHash, uint32_t nonce);
+
   /** \return number of stored Nonces
    *  \note The return value does not contain non-Nonce entries in the index, if any.
    */
@@ -95,20 +111,30 @@ private: // Entry and Index
   typedef uint64_t Entry;
 
   static Entry
-  makeEntry(const Name& name, uint32_t nonce);
+  makeEntry(name_tree::HashValue nameHash, uint32_t nonce);
 
-  typedef boost::multi_index_container<
-    Entry,
-    boost::multi_index::indexed_by<
-      boost::multi_index::sequenced<>,
-      boost::multi_index::hashed_non_unique<
-        boost::multi_index::identity<Entry>
-      >
-    >
-  > Index;
+  /** \brief Append \p entry to the queue, and add it to the hashtable unless it's a MARK
+   */
+  void
+  pushBack(Entry entry);
 
-  typedef Index::nth_index<0>::type Queue;
-  typedef Index::nth_index<1>::type Hashtable;
+  /** \brief Remove the oldest entry from the queue and the hashtable
+   *  \pre m_queueSize > 0
+   */
+  void
+  popFront();
+
+  /** \brief Find the hashtable slot of \p entry
+   *  \return slot index, or the index of an empty slot if \p entry does not exist
+   */
+  size_t
+  findSlot(Entry entry) const;
+
+  /** \brief Rehash into \p nSlots slots
+   *  \pre nSlots is a power of two, and greater than the number of hashtable entries
+   */
+  void
+  resizeHashtable(size_t nSlots);
 
 private: // actual lifetime estimation and capacity control
   /** \brief Return the number of MARKs in the index
@@ -142,9 +168,23 @@ public:
 
 private:
   time::nanoseconds m_lifetime;
-  Index m_index;
-  Queue& m_queue;
-  Hashtable& m_ht;
+
+  /** \brief Ring buffer of entries and MARKs in insertion order
+   *
+   *  Its size is a power of two; it's grown when full.
+   */
+  std::vector<Entry> m_queue;
+  size_t m_queueHead = 0; ///< position of the oldest entry
+  size_t m_queueSize = 0; ///< number of entries and MARKs
+
+  /** \brief Open addressing hashtable with linear probing
+   *
+   *  Each slot holds an entry, or MARK if the slot is empty; a duplicate entry occupies
+   *  another slot. Its size is a power of two, and it's kept at most half full.
+   */
+  std::vector<Entry> m_ht;
+  size_t m_htSize = 0; ///< number of entries in the hashtable
+  size_t m_nMarks = 0; ///< number of MARKs in the queue
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity control
 
@@ -178,8 +218,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity contr
   /** \brief The MARK for capacity
    *
    *  The MARK doesn't have a distinct type.
-   *  Entry is a hash. The hash function should have non-invertible property,
-   *  so it's unlikely for a usual Entry to have collision with the MARK.
+   *  Entry is a hash; makeEntry never returns the MARK.
    */
   static const Entry MARK;
 
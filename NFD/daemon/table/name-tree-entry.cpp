@@ -29,21 +29,100 @@
 namespace nfd {
 namespace name_tree {
 
+/** \brief copy the TLV encoding of name components [first, last) into a standalone buffer
+ */
+static ndn::ConstBufferPtr
+copyComponents(const Name& name, size_t first, size_t last)
+{
+  auto buffer = make_shared<ndn::Buffer>();
+  for (size_t i = first; i < last; ++i) {
+    const Block& comp = name[i].wireEncode();
+    buffer->insert(buffer->end(), comp.wire(), comp.wire() + comp.size());
+  }
+  return buffer;
+}
+
+/** \brief copy the last TLV element in \p wire into a standalone buffer
+ */
+static ndn::ConstBufferPtr
+copyLastElement(const ndn::Buffer& wire)
+{
+  auto begin = wire.begin();
+  auto last = begin;
+  while (begin != wire.end()) {
+    last = begin;
+    tlv::readType(begin, wire.end());
+    uint64_t length = tlv::readVarNumber(begin, wire.end());
+    begin += length;
+  }
+  return make_shared<ndn::Buffer>(last, wire.end());
+}
+
 Entry::Entry(const Name& name, Node* node)
-  : m_name(name)
+  : m_suffix(copyComponents(name, 0, name.size()))
+  , m_depth(name.size())
   , m_node(node)
 {
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(name.size() <= NameTree::getMaxDepth());
 }
 
+Name
+Entry::getName() const
+{
+  // components of the suffix share m_suffix buffer, no bytes are copied
+  Name suffix(Block(tlv::Name, m_suffix));
+  if (m_parent == nullptr) {
+    return suffix;
+  }
+
+  Name name = m_parent->getName();
+  name.append(suffix);
+  return name;
+}
+
+bool
+Entry::hasName(const Name& name, size_t prefixLen) const
+{
+  size_t end = std::min(prefixLen, name.size());
+  if (end != m_depth) {
+    return false;
+  }
+
+  for (const Entry* entry = this; entry != nullptr; entry = entry->m_parent) {
+    size_t begin = entry->m_parent == nullptr ? 0 : end - 1;
+    const uint8_t* wire = entry->m_suffix->data();
+    size_t remaining = entry->m_suffix->size();
+
+    for (size_t i = begin; i < end; ++i) {
+      const Block& comp = name[i].wireEncode();
+      if (comp.size() > remaining || std::memcmp(comp.wire(), wire, comp.size()) != 0) {
+        return false;
+      }
+      wire += comp.size();
+      remaining -= comp.size();
+    }
+
+    if (remaining != 0) {
+      return false;
+    }
+    end = begin;
+  }
+  return true;
+}
+
 void
 Entry::setParent(Entry& entry)
 {
   BOOST_ASSERT(this->getParent() == nullptr);
-  BOOST_ASSERT(!this->getName().empty());
+  BOOST_ASSERT(this->getDepth() > 0);
+  BOOST_ASSERT(entry.getDepth() + 1 == this->getDepth());
   BOOST_ASSERT(entry.getName() == this->getName().getPrefix(-1));
 
+  if (m_depth > 1) {
+    m_suffix = copyLastElement(*m_suffix);
+  }
+
   m_parent = &entry;
   m_parent->m_children.push_back(this);
 }
@@ -57,6 +136,9 @@ Entry::unsetParent()
   BOOST_ASSERT(i != m_parent->m_children.end());
   m_parent->m_children.erase(i);
 
+  if (m_depth > 1) {
+    m_suffix = copyComponents(this->getName(), 0, m_depth);
+  }
   m_parent = nullptr;
 }
 
@@ -43,12 +43,28 @@ class Entry : noncopyable
 public:
   Entry(const Name& prefix, Node* node);
 
-  const Name&
-  getName() const
+  /** \return name of this entry
+   *  \note The name is assembled from the name components stored along the parent chain,
+   *        which takes time linear to getDepth().
+   */
+  Name
+  getName() const;
+
+  /** \return number of components in getName()
+   */
+  size_t
+  getDepth() const
   {
-    return m_name;
+    return m_depth;
   }
 
+  /** \brief Check whether getName() equals name.getPrefix(prefixLen)
+   *
+   *  Unlike comparing with getName(), this does not assemble the name of this entry.
+   */
+  bool
+  hasName(const Name& name, size_t prefixLen) const;
+
   /** \return entry of getName().getPrefix(-1)
    *  \retval nullptr this entry is the root entry, i.e. getName() == Name()
    */
@@ -63,12 +79,14 @@ public:
    *  \pre getParent() == nullptr
    *  \post getParent() == &entry
    *  \post entry.getChildren() contains this
+   *  \post this entry stores only the last component of its name
    */
   void
   setParent(Entry& entry);
 
   /** \brief Unset parent of this entry
    *  \post getParent() == nullptr
+   *  \post getName() is unchanged
    *  \post parent.getChildren() does not contain this
    */
   void
@@ -164,7 +182,13 @@ public: // attached table entries
   }
 
 private:
-  Name m_name;
+  /** \brief TLV encoding of the name components that are not stored in the parent chain
+   *
+   *  This is the full name when the entry has no parent, or the last name component otherwise.
+   *  The buffer is owned by the entry, so that it does not retain the packet the name came from.
+   */
+  ndn::ConstBufferPtr m_suffix;
+  size_t m_depth;
   Node* m_node;
   Entry* m_parent = nullptr;
   std::vector<Entry*> m_children;
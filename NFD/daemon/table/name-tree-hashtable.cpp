@@ -116,7 +116,8 @@ HashtableOptions::HashtableOptions(size_t size)
 }
 
 Hashtable::Hashtable(const Options& options)
-  : m_options(options)
+  : m_nodePool(sizeof(Node), 32, 4096)
+  , m_options(options)
   , m_size(0)
 {
   BOOST_ASSERT(m_options.minSize > 0);
@@ -130,15 +131,16 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
 
   m_buckets.resize(options.initialSize);
+  m_nLevelBuckets = options.initialSize;
   this->computeThresholds();
 }
 
 Hashtable::~Hashtable()
 {
   for (size_t i = 0; i < m_buckets.size(); ++i) {
-    foreachNode(m_buckets[i], [] (Node* node) {
+    foreachNode(m_buckets[i], [this] (Node* node) {
       node->prev = node->next = nullptr;
-      delete node;
+      this->deallocateNode(node);
     });
   }
 }
@@ -183,7 +185,7 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
   size_t bucket = this->computeBucketIndex(h);
 
   for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
-    if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+    if (node->hash == h && node->entry.hasName(name, prefixLen)) {
       NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
       return {node, false};
     }
@@ -194,13 +196,13 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
     return {nullptr, false};
   }
 
-  Node* node = new Node(h, name.getPrefix(prefixLen));
+  Node* node = this->allocateNode(h, name.getPrefix(prefixLen));
   this->attach(bucket, node);
   NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " bucket=" << bucket);
   ++m_size;
 
   if (m_size > m_expandThreshold) {
-    this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
+    this->expand();
   }
 
   return {node, true};
@@ -237,16 +239,49 @@ Hashtable::erase(Node* node)
   NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
 
   this->detach(bucket, node);
-  delete node;
+  this->deallocateNode(node);
   --m_size;
 
   if (m_size < m_shrinkThreshold) {
-    size_t newNBuckets = std::max(m_options.minSize,
-      static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets()));
-    this->resize(newNBuckets);
+    this->shrink();
+  }
+}
+
+void
+Hashtable::setIncrementalResize(bool isEnabled)
+{
+  m_options.incrementalResize = isEnabled;
+
+  if (!isEnabled && m_splitPos != 0) {
+    // all buckets must be at the same level before buckets are addressed by plain modulo
+    this->countRehashedNodes(this->resize(this->getNBuckets()));
+  }
+}
+
+Node*
+Hashtable::allocateNode(HashValue h, const Name& name)
+{
+  void* memory = m_nodePool.malloc();
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  try {
+    return new (memory) Node(h, name);
+  }
+  catch (...) {
+    m_nodePool.free(memory);
+    throw;
   }
 }
 
+void
+Hashtable::deallocateNode(Node* node)
+{
+  node->~Node();
+  m_nodePool.free(node);
+}
+
 void
 Hashtable::computeThresholds()
 {
@@ -256,25 +291,128 @@ Hashtable::computeThresholds()
 }
 
 void
+Hashtable::expand()
+{
+  size_t nRehashedNodes = 0;
+  if (m_options.incrementalResize) {
+    while (m_size > m_expandThreshold) {
+      nRehashedNodes += this->splitBucket();
+    }
+  }
+  else {
+    nRehashedNodes = this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
+  }
+  this->countRehashedNodes(nRehashedNodes);
+}
+
+void
+Hashtable::shrink()
+{
+  size_t nRehashedNodes = 0;
+  if (m_options.incrementalResize) {
+    while (m_size < m_shrinkThreshold && this->canMergeBucket()) {
+      nRehashedNodes += this->mergeBucket();
+    }
+  }
+  else {
+    size_t newNBuckets = std::max(m_options.minSize,
+      static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets()));
+    nRehashedNodes = this->resize(newNBuckets);
+  }
+  this->countRehashedNodes(nRehashedNodes);
+}
+
+size_t
 Hashtable::resize(size_t newNBuckets)
 {
-  if (this->getNBuckets() == newNBuckets) {
-    return;
+  if (this->getNBuckets() == newNBuckets && m_splitPos == 0) {
+    return 0;
   }
   NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNBuckets);
 
   std::vector<Node*> oldBuckets;
   oldBuckets.swap(m_buckets);
   m_buckets.resize(newNBuckets);
+  m_nLevelBuckets = newNBuckets;
+  m_splitPos = 0;
 
+  size_t nRehashedNodes = 0;
   for (Node* head : oldBuckets) {
-    foreachNode(head, [this] (Node* node) {
+    foreachNode(head, [this, &nRehashedNodes] (Node* node) {
       size_t bucket = this->computeBucketIndex(node->hash);
       this->attach(bucket, node);
+      ++nRehashedNodes;
     });
   }
 
   this->computeThresholds();
+  return nRehashedNodes;
+}
+
+size_t
+Hashtable::splitBucket()
+{
+  size_t splitBucket = m_splitPos;
+  m_buckets.push_back(nullptr);
+  if (++m_splitPos == m_nLevelBuckets) {
+    m_nLevelBuckets *= 2;
+    m_splitPos = 0;
+  }
+  NFD_LOG_TRACE("split bucket=" << splitBucket << " into=" << this->getNBuckets() - 1);
+
+  Node* head = m_buckets[splitBucket];
+  m_buckets[splitBucket] = nullptr;
+
+  size_t nRehashedNodes = 0;
+  foreachNode(head, [this, &nRehashedNodes] (Node* node) {
+    size_t bucket = this->computeBucketIndex(node->hash);
+    this->attach(bucket, node);
+    ++nRehashedNodes;
+  });
+
+  this->computeThresholds();
+  return nRehashedNodes;
+}
+
+bool
+Hashtable::canMergeBucket() const
+{
+  return this->getNBuckets() > m_options.minSize &&
+         (m_splitPos > 0 || m_nLevelBuckets % 2 == 0);
+}
+
+size_t
+Hashtable::mergeBucket()
+{
+  BOOST_ASSERT(this->canMergeBucket());
+
+  if (m_splitPos == 0) {
+    m_nLevelBuckets /= 2;
+    m_splitPos = m_nLevelBuckets;
+  }
+  --m_splitPos;
+  BOOST_ASSERT(m_nLevelBuckets + m_splitPos + 1 == this->getNBuckets());
+  NFD_LOG_TRACE("merge bucket=" << this->getNBuckets() - 1 << " into=" << m_splitPos);
+
+  Node* head = m_buckets.back();
+  m_buckets.pop_back();
+
+  size_t nRehashedNodes = 0;
+  foreachNode(head, [this, &nRehashedNodes] (Node* node) {
+    BOOST_ASSERT(this->computeBucketIndex(node->hash) == m_splitPos);
+    this->attach(m_splitPos, node);
+    ++nRehashedNodes;
+  });
+
+  this->computeThresholds();
+  return nRehashedNodes;
+}
+
+void
+Hashtable::countRehashedNodes(size_t nRehashedNodes)
+{
+  m_nRehashedNodes += nRehashedNodes;
+  m_maxRehashedNodes = std::max(m_maxRehashedNodes, nRehashedNodes);
 }
 
 } // namespace name_tree
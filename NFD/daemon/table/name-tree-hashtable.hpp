@@ -28,6 +28,8 @@
 
 #include "name-tree-entry.hpp"
 
+#include <boost/pool/pool.hpp>
+
 namespace nfd {
 namespace name_tree {
 
@@ -137,6 +139,15 @@ public:
   /** \brief when hashtable is shrunk, its new size is max(nBuckets*shrinkFactor, minSize)
    */
   float shrinkFactor = 0.5;
+
+  /** \brief whether hashtable is resized incrementally
+   *
+   *  If false, all nodes are rehashed at once when a load factor threshold is crossed.
+   *  If true, the hashtable is resized in linear hashing style: a few buckets are split or merged
+   *  on each insertion or erasure, so that the load factor stays within the thresholds.
+   *  expandFactor and shrinkFactor are unused in this mode.
+   */
+  bool incrementalResize = false;
 };
 
 /** \brief a hashtable for fast exact name lookup
@@ -145,6 +156,12 @@ public:
  *  Each node is placed into a bucket determined by a hash value computed from its name.
  *  Hash collision is resolved through a doubly linked list in each bucket.
  *  The number of buckets is adjusted according to how many nodes are stored.
+ *
+ *  In incremental resize mode, buckets are addressed with linear hashing: with N buckets at the
+ *  current level and the first P of them already split, a hash value h is mapped to bucket h%N
+ *  if h%N >= P, and to bucket h%(2N) otherwise.
+ *  Nodes are allocated from a memory pool owned by the Hashtable, so that inserting and erasing
+ *  a node does not go through the global allocator once the pool has grown to the working set.
  */
 class Hashtable
 {
@@ -179,7 +196,11 @@ public:
   size_t
   computeBucketIndex(HashValue h) const
   {
-    return h % this->getNBuckets();
+    size_t bucket = h % m_nLevelBuckets;
+    if (bucket < m_splitPos) {
+      bucket = h % (2 * m_nLevelBuckets);
+    }
+    return bucket;
   }
 
   /** \return i-th bucket
@@ -218,6 +239,28 @@ public:
   void
   erase(Node* node);
 
+  /** \brief enable or disable incremental resize mode
+   *  \sa HashtableOptions::incrementalResize
+   */
+  void
+  setIncrementalResize(bool isEnabled);
+
+  /** \return total number of nodes moved between buckets due to resizing
+   */
+  size_t
+  getNRehashedNodes() const
+  {
+    return m_nRehashedNodes;
+  }
+
+  /** \return maximum number of nodes moved between buckets during a single insertion or erasure
+   */
+  size_t
+  getMaxRehashedNodes() const
+  {
+    return m_maxRehashedNodes;
+  }
+
 private:
   /** \brief attach node to bucket
    */
@@ -235,15 +278,58 @@ private:
   void
   computeThresholds();
 
+  /** \brief resize hashtable after an insertion
+   */
+  void
+  expand();
+
+  /** \brief resize hashtable after an erasure
+   */
   void
+  shrink();
+
+  /** \brief rehash all nodes into \p newNBuckets buckets
+   *  \return number of rehashed nodes
+   */
+  size_t
   resize(size_t newNBuckets);
 
+  /** \brief append a bucket, and split the next bucket at the current level into it
+   *  \return number of rehashed nodes
+   */
+  size_t
+  splitBucket();
+
+  /** \brief merge the last bucket into its split image, and remove the last bucket
+   *  \pre canMergeBucket()
+   *  \return number of rehashed nodes
+   */
+  size_t
+  mergeBucket();
+
+  bool
+  canMergeBucket() const;
+
+  void
+  countRehashedNodes(size_t nRehashedNodes);
+
+  Node*
+  allocateNode(HashValue h, const Name& name);
+
+  void
+  deallocateNode(Node* node);
+
 private:
   std::vector<Node*> m_buckets;
+  boost::pool<> m_nodePool;
   Options m_options;
   size_t m_size;
   size_t m_expandThreshold;
   size_t m_shrinkThreshold;
+  size_t m_nLevelBuckets; ///< number of buckets at the current linear hashing level
+  size_t m_splitPos = 0; ///< number of buckets that have been split at the current level
+  size_t m_nRehashedNodes = 0;
+  size_t m_maxRehashedNodes = 0;
 };
 
 } // namespace name_tree
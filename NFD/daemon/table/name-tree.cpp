@@ -47,7 +47,16 @@ NameTree::lookup(const Name& name, size_t prefixLen)
   BOOST_ASSERT(prefixLen <= name.size());
   BOOST_ASSERT(prefixLen <= getMaxDepth());
 
-  HashSequence hashes = computeHashes(name, prefixLen);
+  return this->lookup(name, prefixLen, computeHashes(name, prefixLen));
+}
+
+Entry&
+NameTree::lookup(const Name& name, size_t prefixLen, const HashSequence& hashes)
+{
+  BOOST_ASSERT(prefixLen <= name.size());
+  BOOST_ASSERT(prefixLen <= getMaxDepth());
+  BOOST_ASSERT(hashes.size() > prefixLen);
+
   const Node* node = nullptr;
   Entry* parent = nullptr;
 
@@ -195,9 +204,9 @@ NameTree::findLongestPrefixMatch(const pit::Entry& pitEntry, const EntrySelector
 
   const Name& name = pitEntry.getName();
   size_t depth = std::min(name.size(), getMaxDepth());
-  if (nte->getName().size() < pitEntry.getName().size()) {
+  if (nte->getDepth() < name.size()) {
     // PIT entry name either exceeds depth limit or ends with an implicit digest: go deeper
-    for (size_t i = nte->getName().size() + 1; i <= depth; ++i) {
+    for (size_t i = nte->getDepth() + 1; i <= depth; ++i) {
       const Entry* exact = this->findExactMatch(name, i);
       if (exact == nullptr) {
         break;
@@ -69,6 +69,31 @@ public: // information
     return m_ht.getNBuckets();
   }
 
+  /** \return total number of hashtable nodes moved between buckets due to resizing
+   */
+  size_t
+  getNRehashedNodes() const
+  {
+    return m_ht.getNRehashedNodes();
+  }
+
+  /** \return maximum number of hashtable nodes moved between buckets during a single operation
+   */
+  size_t
+  getMaxRehashedNodes() const
+  {
+    return m_ht.getMaxRehashedNodes();
+  }
+
+  /** \brief enable or disable incremental resizing of the hashtable
+   *  \sa HashtableOptions::incrementalResize
+   */
+  void
+  setIncrementalResize(bool isEnabled)
+  {
+    m_ht.setIncrementalResize(isEnabled);
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    */
@@ -92,6 +117,12 @@ public: // mutation
   Entry&
   lookup(const Name& name, size_t prefixLen);
 
+  /** \brief Equivalent to `lookup(name, prefixLen)`, with precomputed hashes
+   *  \param hashes computeHashes(name, n) for some n no less than \p prefixLen
+   */
+  Entry&
+  lookup(const Name& name, size_t prefixLen, const HashSequence& hashes);
+
   /** \brief Equivalent to `lookup(name, name.size())`
    */
   Entry&
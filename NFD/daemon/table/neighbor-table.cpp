@@ -28,11 +28,19 @@
 #include <ndn-cxx/util/concepts.hpp>
 #include "common/global.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <queue>
 
 namespace nfd {
 namespace neighbor_table {
-NeighborTable::NeighborTable()
+
+constexpr double NeighborTable::DEFAULT_CELL_SIZE;
+
+NeighborTable::NeighborTable(double cellSize)
+  : m_cellSize(cellSize)
 {
+  BOOST_ASSERT(cellSize > 0);
 }
 
 Entry *
@@ -47,11 +55,179 @@ NeighborTable::insert(std::pair<uint32_t, std::tuple<double, double, double>> ne
   Entry& entry = const_cast<Entry&>(*it);
   
   if(!isNewEntry){
+    CellId oldCell = getCell(entry.getCurrentLocation());
     entry.updateLocation(std::make_pair(nodeLocation, lastNeighborPosition));
+    CellId newCell = getCell(nodeLocation);
+    if (newCell != oldCell) {
+      removeFromIndex(entry, oldCell);
+      addToIndex(entry, newCell);
+    }
+  }
+  else {
+    addToIndex(entry, getCell(nodeLocation));
   }
   m_lastUpdated = ndn::time::steady_clock::now();
 
   return &entry;
 }
-} // namespace fib
+
+void
+NeighborTable::eraseEntry(Entry& entry)
+{
+  removeFromIndex(entry, getCell(entry.getCurrentLocation()));
+  m_table.erase(entry);
+}
+
+NeighborTable::CellId
+NeighborTable::getCell(const std::tuple<double, double, double>& location) const
+{
+  return {static_cast<int64_t>(std::floor(std::get<0>(location) / m_cellSize)),
+          static_cast<int64_t>(std::floor(std::get<1>(location) / m_cellSize))};
+}
+
+void
+NeighborTable::addToIndex(const Entry& entry, const CellId& cell)
+{
+  auto& entries = m_cells[cell];
+  if (entries.empty() && m_isBoundingBoxValid) {
+    m_minCell = {std::min(m_minCell.first, cell.first), std::min(m_minCell.second, cell.second)};
+    m_maxCell = {std::max(m_maxCell.first, cell.first), std::max(m_maxCell.second, cell.second)};
+  }
+  entries.push_back(&entry);
+}
+
+void
+NeighborTable::removeFromIndex(const Entry& entry, const CellId& cell)
+{
+  auto i = m_cells.find(cell);
+  BOOST_ASSERT(i != m_cells.end());
+  auto& entries = i->second;
+  auto j = std::find(entries.begin(), entries.end(), &entry);
+  BOOST_ASSERT(j != entries.end());
+  *j = entries.back();
+  entries.pop_back();
+  if (entries.empty()) {
+    m_cells.erase(i);
+    m_isBoundingBoxValid = false;
+  }
+}
+
+void
+NeighborTable::updateBoundingBox() const
+{
+  if (m_isBoundingBoxValid || m_cells.empty()) {
+    return;
+  }
+  m_minCell = m_maxCell = m_cells.begin()->first;
+  for (const auto& cell : m_cells) {
+    m_minCell = {std::min(m_minCell.first, cell.first.first),
+                 std::min(m_minCell.second, cell.first.second)};
+    m_maxCell = {std::max(m_maxCell.first, cell.first.first),
+                 std::max(m_maxCell.second, cell.first.second)};
+  }
+  m_isBoundingBoxValid = true;
+}
+
+std::vector<const Entry*>
+NeighborTable::findNearest(double x, double y, size_t k, double maxDistance,
+                           const std::function<bool(const Entry&)>& filter) const
+{
+  std::vector<const Entry*> result;
+  if (m_cells.empty() || !(maxDistance >= 0)) {
+    return result;
+  }
+  const double maxDistance2 = maxDistance * maxDistance;
+
+  // max-heap of the best candidates so far, the worst one on top
+  using Candidate = std::pair<std::pair<double, uint32_t>, const Entry*>;
+  std::vector<Candidate> best;
+  auto isFull = [&] { return k > 0 && best.size() >= k; };
+
+  auto visitCell = [&] (const std::vector<const Entry*>& entries) {
+    for (const Entry* entry : entries) {
+      auto location = entry->getCurrentLocation();
+      double dx = std::get<0>(location) - x;
+      double dy = std::get<1>(location) - y;
+      Candidate candidate{{dx * dx + dy * dy, entry->getId()}, entry};
+      if (candidate.first.first > maxDistance2 ||
+          (isFull() && !(candidate.first < best.front().first)) ||
+          (filter && !filter(*entry))) {
+        continue;
+      }
+      if (isFull()) {
+        std::pop_heap(best.begin(), best.end());
+        best.pop_back();
+      }
+      best.push_back(candidate);
+      std::push_heap(best.begin(), best.end());
+    }
+  };
+
+  updateBoundingBox();
+  const CellId center = getCell(std::make_tuple(x, y, 0.0));
+  const int64_t nCols = m_maxCell.first - m_minCell.first + 1;
+  const int64_t nRows = m_maxCell.second - m_minCell.second + 1;
+
+  if (static_cast<double>(nCols) * nRows > 4.0 * m_cells.size()) {
+    // sparse index, visiting the occupied cells is cheaper than walking rings of empty ones
+    for (const auto& cell : m_cells) {
+      visitCell(cell.second);
+    }
+  }
+  else {
+    // visit rings of cells at Chebyshev distance r from the center, clipped to the occupied range
+    const int64_t rMin = std::max({int64_t(0),
+                                   m_minCell.first - center.first, center.first - m_maxCell.first,
+                                   m_minCell.second - center.second, center.second - m_maxCell.second});
+    const int64_t rMax = std::max({center.first - m_minCell.first, m_maxCell.first - center.first,
+                                   center.second - m_minCell.second, m_maxCell.second - center.second});
+    for (int64_t r = rMin; r <= rMax; ++r) {
+      // any point in ring r is at least (r - 1) cells away from the query point
+      double bound = std::max(int64_t(0), r - 1) * m_cellSize;
+      double bound2 = bound * bound;
+      if (bound2 > maxDistance2 || (isFull() && bound2 > best.front().first.first)) {
+        break;
+      }
+
+      auto visit = [&] (int64_t cx, int64_t cy) {
+        auto cell = m_cells.find({cx, cy});
+        if (cell != m_cells.end()) {
+          visitCell(cell->second);
+        }
+      };
+
+      // rows and columns of the ring, only within the occupied range
+      int64_t xFrom = std::max(center.first - r, m_minCell.first);
+      int64_t xTo = std::min(center.first + r, m_maxCell.first);
+      for (int64_t cy : {center.second - r, center.second + r}) {
+        if (cy >= m_minCell.second && cy <= m_maxCell.second) {
+          for (int64_t cx = xFrom; cx <= xTo; ++cx) {
+            visit(cx, cy);
+          }
+        }
+        if (r == 0) {
+          break;
+        }
+      }
+      int64_t yFrom = std::max(center.second - r + 1, m_minCell.second);
+      int64_t yTo = std::min(center.second + r - 1, m_maxCell.second);
+      for (int64_t cx : {center.first - r, center.first + r}) {
+        if (r > 0 && cx >= m_minCell.first && cx <= m_maxCell.first) {
+          for (int64_t cy = yFrom; cy <= yTo; ++cy) {
+            visit(cx, cy);
+          }
+        }
+      }
+    }
+  }
+
+  std::sort_heap(best.begin(), best.end());
+  result.reserve(best.size());
+  for (const auto& candidate : best) {
+    result.push_back(candidate.second);
+  }
+  return result;
+}
+
+} // namespace neighbor_table
 } // namespace nfd
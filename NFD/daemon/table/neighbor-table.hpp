@@ -34,7 +34,9 @@
 #include <fstream>
 #include <cassert>
 #include <functional>
+#include <limits>
 #include <tuple>
+#include <unordered_map>
 
 #include "neighbor-entry.hpp"
 #include <boost/range/adaptor/transformed.hpp>
@@ -46,12 +48,18 @@ namespace nfd {
 namespace neighbor_table {
 
 /** \brief Represents the Neighbor Information Table (NIT)
+ *
+ *  Besides the table ordered by node id, entries are indexed in a uniform grid by the (x, y)
+ *  coordinates of their current location, so that the neighbors nearest to a point can be found
+ *  without visiting the whole table.  Locations must therefore only be changed through insert().
  */
 class NeighborTable : boost::noncopyable
 {
 public:
+  /** \param cellSize side length of the square cells of the spatial index
+   */
   explicit
-  NeighborTable();
+  NeighborTable(double cellSize = DEFAULT_CELL_SIZE);
 
   /** \brief inserts a Node Information
    */
@@ -63,13 +71,37 @@ public:
   void
   clear(){
     m_table.clear();
+    m_cells.clear();
+    m_isBoundingBoxValid = false;
   }
 
   /** \brief Delete an entry
    */
   void
-  eraseEntry(Entry& entry){
-    m_table.erase(entry);
+  eraseEntry(Entry& entry);
+
+  /** \brief finds the entries whose current location is nearest to a point
+   *
+   *  Cells of the spatial index are visited in rings of increasing distance from the point,
+   *  until no remaining cell can hold an entry closer than the k-th one found.  Distances are
+   *  compared squared, and only the best \p k entries are kept.
+   *
+   *  \param x x coordinate of the point
+   *  \param y y coordinate of the point
+   *  \param k maximum number of entries to return, or 0 to return all
+   *  \param maxDistance entries farther from the point are ignored
+   *  \param filter if set, entries for which it returns false are ignored
+   *  \return entries ordered by increasing distance, then by id
+   */
+  std::vector<const Entry*>
+  findNearest(double x, double y, size_t k,
+              double maxDistance = std::numeric_limits<double>::infinity(),
+              const std::function<bool(const Entry&)>& filter = nullptr) const;
+
+  double
+  getCellSize() const
+  {
+    return m_cellSize;
   }
   
   bool
@@ -108,8 +140,42 @@ public: // enumeration
     return m_lastUpdated;
   }
 
+public:
+  static constexpr double DEFAULT_CELL_SIZE = 100.0;
+
+private:
+  using CellId = std::pair<int64_t, int64_t>;
+
+  struct CellIdHash
+  {
+    size_t
+    operator()(const CellId& cell) const
+    {
+      return std::hash<uint64_t>()(static_cast<uint64_t>(cell.first) * 0x9E3779B97F4A7C15 +
+                                   static_cast<uint64_t>(cell.second));
+    }
+  };
+
+  CellId
+  getCell(const std::tuple<double, double, double>& location) const;
+
+  void
+  addToIndex(const Entry& entry, const CellId& cell);
+
+  void
+  removeFromIndex(const Entry& entry, const CellId& cell);
+
+  void
+  updateBoundingBox() const;
+
 private:
   Table m_table;
+  double m_cellSize;
+  std::unordered_map<CellId, std::vector<const Entry*>, CellIdHash> m_cells;
+  // range of occupied cells, recalculated lazily after cells are emptied
+  mutable CellId m_minCell;
+  mutable CellId m_maxCell;
+  mutable bool m_isBoundingBoxValid = false;
   bool m_rejectInterest = false;  // check if pending interest is reject or not to delete PIT entry
   ndn::time::steady_clock::TimePoint m_lastUpdated = ndn::time::steady_clock::TimePoint::min();   //last time when table was updated
   
@@ -29,7 +29,7 @@
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
 
-#include <list>
+#include <boost/container/small_vector.hpp>
 
 namespace nfd {
 
@@ -39,13 +39,24 @@ class Entry;
 
 namespace pit {
 
+/** \brief Number of face records stored inline in a PIT entry, before heap allocation
+ */
+const size_t N_INLINE_FACE_RECORDS = 2;
+
 /** \brief An unordered collection of in-records
+ *
+ *  Records are stored contiguously, and the first few records are stored inline in the
+ *  PIT entry. Iterators and references to records are invalidated when a record is inserted
+ *  into or deleted from the same collection; a record should be held by its Face, which is
+ *  a stable handle, and found again with Entry::getInRecord.
  */
-typedef std::list<InRecord> InRecordCollection;
+typedef boost::container::small_vector<InRecord, N_INLINE_FACE_RECORDS> InRecordCollection;
 
 /** \brief An unordered collection of out-records
+ *
+ *  \sa InRecordCollection for iterator invalidation rules
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef boost::container::small_vector<OutRecord, N_INLINE_FACE_RECORDS> OutRecordCollection;
 
 /** \brief An Interest table entry
  *
@@ -41,14 +41,14 @@ class FaceRecord : public StrategyInfoHost
 public:
   explicit
   FaceRecord(Face& face)
-    : m_face(face)
+    : m_face(&face)
   {
   }
 
   Face&
   getFace() const
   {
-    return m_face;
+    return *m_face;
   }
 
   uint32_t
@@ -78,7 +78,7 @@ public:
   update(const Interest& interest);
 
 private:
-  Face& m_face;
+  Face* m_face; // a pointer so that records can be moved within their collection
   uint32_t m_lastNonce = 0;
   time::steady_clock::TimePoint m_lastRenewed = time::steady_clock::TimePoint::min();
   time::steady_clock::TimePoint m_expiry = time::steady_clock::TimePoint::min();
@@ -40,7 +40,8 @@ Pit::Pit(NameTree& nameTree)
 }
 
 std::pair<shared_ptr<Entry>, bool>
-Pit::findOrInsert(const Interest& interest, bool allowInsert)
+Pit::findOrInsert(const Interest& interest, bool allowInsert,
+                  const name_tree::HashSequence* hashes)
 {
   // determine which NameTree entry should the PIT entry be attached onto
   const Name& name = interest.getName();
@@ -51,7 +52,8 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
   // ensure NameTree entry exists
   name_tree::Entry* nte = nullptr;
   if (allowInsert) {
-    nte = &m_nameTree.lookup(name, nteDepth);
+    nte = hashes != nullptr ? &m_nameTree.lookup(name, nteDepth, *hashes) :
+                              &m_nameTree.lookup(name, nteDepth);
   }
   else {
     nte = m_nameTree.findExactMatch(name, nteDepth);
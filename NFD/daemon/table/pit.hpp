@@ -79,6 +79,18 @@ public:
     return this->findOrInsert(interest, true);
   }
 
+  /** \brief Inserts a PIT entry for \p interest, with precomputed name hashes
+   *  \param interest the Interest; must be created with make_shared
+   *  \param hashes name_tree::computeHashes(interest.getName())
+   *  \return a new or existing entry with same Name and Selectors,
+   *          and true for new entry, false for existing entry
+   */
+  std::pair<shared_ptr<Entry>, bool>
+  insert(const Interest& interest, const name_tree::HashSequence& hashes)
+  {
+    return this->findOrInsert(interest, true, &hashes);
+  }
+
   /** \brief Performs a Data match
    *  \return an iterable of all PIT entries matching \p data
    */
@@ -125,13 +137,15 @@ private:
   /** \brief Finds or inserts a PIT entry for \p interest
    *  \param interest the Interest; must be created with make_shared if allowInsert
    *  \param allowInsert whether inserting a new entry is allowed
+   *  \param hashes name_tree::computeHashes(interest.getName()), or nullptr to compute them
    *  \return if allowInsert, a new or existing entry with same Name+Selectors,
    *          and true for new entry, false for existing entry;
    *          if not allowInsert, an existing entry with same Name+Selectors and false,
    *          or `{nullptr, true}` if there's no existing entry
    */
   std::pair<shared_ptr<Entry>, bool>
-  findOrInsert(const Interest& interest, bool allowInsert);
+  findOrInsert(const Interest& interest, bool allowInsert,
+               const name_tree::HashSequence* hashes = nullptr);
 
 private:
   NameTree& m_nameTree;
@@ -203,6 +203,52 @@ BOOST_AUTO_TEST_CASE(Unknown)
 
 BOOST_AUTO_TEST_SUITE_END() // CsPolicy
 
+BOOST_AUTO_TEST_SUITE(CsIndex)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  cs.enableHashIndex(true);
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(cs.hasHashIndex(), false);
+}
+
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_index hash
+    }
+  )CONFIG";
+
+  runConfig(CONFIG, true);
+  BOOST_CHECK_EQUAL(cs.hasHashIndex(), false);
+
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(cs.hasHashIndex(), true);
+}
+
+BOOST_AUTO_TEST_CASE(Unknown)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_index unknown
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsIndex
+
 class CsUnsolicitedPolicyFixture : public TablesConfigSectionFixture
 {
 protected:
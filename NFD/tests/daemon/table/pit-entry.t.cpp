@@ -166,6 +166,47 @@ BOOST_AUTO_TEST_CASE(InOutRecords)
   BOOST_CHECK(entry.getOutRecord(*face2) == entry.out_end());
 }
 
+BOOST_AUTO_TEST_CASE(ManyRecords)
+{
+  // more records than are stored inline in the entry
+  const size_t nFaces = N_INLINE_FACE_RECORDS * 3;
+  std::vector<shared_ptr<DummyFace>> faces;
+  auto interest = makeInterest("/wGc1bd9s");
+  Entry entry(*interest);
+
+  for (size_t i = 0; i < nFaces; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+    auto in = makeInterest("/wGc1bd9s", false, 4_s, static_cast<uint32_t>(i + 1));
+    entry.insertOrUpdateInRecord(*faces.back(), *in);
+    entry.insertOrUpdateOutRecord(*faces.back(), *in);
+  }
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), nFaces);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), nFaces);
+
+  // records are moved within their collections; each is still found by its face
+  for (size_t i = 0; i < nFaces; i += 2) {
+    entry.deleteInRecord(*faces[i]);
+    entry.deleteOutRecord(*faces[i]);
+  }
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), nFaces / 2);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), nFaces / 2);
+
+  for (size_t i = 0; i < nFaces; ++i) {
+    auto in = entry.getInRecord(*faces[i]);
+    auto out = entry.getOutRecord(*faces[i]);
+    if (i % 2 == 0) {
+      BOOST_CHECK(in == entry.in_end());
+      BOOST_CHECK(out == entry.out_end());
+    }
+    else {
+      BOOST_REQUIRE(in != entry.in_end());
+      BOOST_CHECK_EQUAL(in->getLastNonce(), i + 1);
+      BOOST_REQUIRE(out != entry.out_end());
+      BOOST_CHECK_EQUAL(out->getLastNonce(), i + 1);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(Lifetime)
 {
   auto interest = makeInterest("/7oIEurbgy6");
@@ -215,5 +215,32 @@ BOOST_FIXTURE_TEST_CASE(FindCanBePrefixHit, CsBenchmarkFixture)
   std::cout << "find(CanBePrefix-hit) " << (N_INTERESTS * N_CHILDREN * REPEAT) << ": " << d << std::endl;
 }
 
+// find(exact) hit, with either CS index
+BOOST_FIXTURE_TEST_CASE(FindExactHit, CsBenchmarkFixture)
+{
+  constexpr size_t REPEAT = 4;
+
+  std::vector<shared_ptr<Interest>> interestWorkload = makeInterestWorkload(CS_CAPACITY);
+  for (const auto& data : makeDataWorkload(CS_CAPACITY)) {
+    cs.insert(*data, false);
+  }
+  BOOST_REQUIRE(cs.size() == CS_CAPACITY);
+
+  for (bool wantHashIndex : {false, true}) {
+    cs.enableHashIndex(wantHashIndex);
+
+    time::microseconds d = timedRun([&] {
+      for (size_t j = 0; j < REPEAT; ++j) {
+        for (const auto& interest : interestWorkload) {
+          find(*interest);
+        }
+      }
+    });
+
+    std::cout << "find(exact-hit," << (wantHashIndex ? "hash" : "ordered") << ") "
+              << (CS_CAPACITY * REPEAT) << ": " << d << std::endl;
+  }
+}
+
 } // namespace tests
 } // namespace nfd
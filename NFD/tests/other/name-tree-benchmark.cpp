@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "table/name-tree.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// Count the bytes currently allocated through the global allocator, so that the memory retained
+// by the name tree (including packet buffers pinned by name components) can be reported.
+
+static size_t g_nAllocatedBytes = 0;
+
+static constexpr size_t ALLOCATION_HEADER_SIZE = alignof(std::max_align_t);
+
+void*
+operator new(std::size_t size)
+{
+  auto header = static_cast<uint8_t*>(std::malloc(ALLOCATION_HEADER_SIZE + size));
+  if (header == nullptr) {
+    throw std::bad_alloc();
+  }
+  *reinterpret_cast<std::size_t*>(header) = size;
+  g_nAllocatedBytes += size;
+  return header + ALLOCATION_HEADER_SIZE;
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  if (ptr == nullptr) {
+    return;
+  }
+  auto header = static_cast<uint8_t*>(ptr) - ALLOCATION_HEADER_SIZE;
+  g_nAllocatedBytes -= *reinterpret_cast<std::size_t*>(header);
+  std::free(header);
+}
+
+void*
+operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+  ::operator delete(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+  ::operator delete(ptr);
+}
+
+void
+operator delete[](void* ptr, std::size_t) noexcept
+{
+  ::operator delete(ptr);
+}
+
+namespace nfd {
+namespace tests {
+
+class NameTreeBenchmarkFixture
+{
+protected:
+  NameTreeBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+  }
+
+  /** \brief generate Interests decoded from wire, as they would arrive from a face
+   *
+   *  Names share their first \p nSharedComponents components in groups of \p groupSize,
+   *  and are unique afterwards.
+   */
+  void
+  generateInterests(size_t nInterests, size_t nameLength, size_t nSharedComponents, size_t groupSize)
+  {
+    BOOST_ASSERT(nSharedComponents < nameLength);
+
+    for (size_t i = 0; i < nInterests; ++i) {
+      Name name;
+      for (size_t j = 0; j < nSharedComponents; ++j) {
+        name.append("shared" + to_string(i / groupSize));
+      }
+      name.append(to_string(i));
+      while (name.size() < nameLength) {
+        name.append("component" + to_string(name.size()));
+      }
+
+      Interest interest(name);
+      interest.setCanBePrefix(false);
+      interests.push_back(make_shared<Interest>(interest.wireEncode()));
+    }
+  }
+
+protected:
+  std::vector<shared_ptr<Interest>> interests;
+  NameTree m_nameTree;
+};
+
+// This test case inserts PIT-like names into the name tree and reports how many bytes each name
+// tree entry retains after the Interests themselves have been released.
+BOOST_FIXTURE_TEST_CASE(BytesPerEntry, NameTreeBenchmarkFixture)
+{
+  // number of distinct Interest names
+  const size_t nInterests = 10000;
+  // number of components in each Interest name
+  const size_t nameLength = 10;
+  // number of leading components shared by a group of names
+  const size_t nSharedComponents = 2;
+  // number of names that share the leading components
+  const size_t groupSize = 100;
+
+  size_t nBytesBefore = g_nAllocatedBytes;
+  generateInterests(nInterests, nameLength, nSharedComponents, groupSize);
+
+  auto t1 = time::steady_clock::now();
+
+  for (const auto& interest : interests) {
+    m_nameTree.lookup(interest->getName());
+  }
+
+  auto t2 = time::steady_clock::now();
+
+  interests.clear();
+  size_t nBytes = g_nAllocatedBytes - nBytesBefore;
+
+  std::cout << "entries=" << m_nameTree.size()
+            << " bytes=" << nBytes
+            << " bytes-per-entry=" << nBytes / m_nameTree.size()
+            << " insert-time=" << time::duration_cast<time::microseconds>(t2 - t1)
+            << std::endl;
+}
+
+// This test case inserts and then erases many names, and reports the slowest single operation
+// and the resize cost in either resize mode of the name tree hashtable.
+BOOST_AUTO_TEST_CASE(ResizeSpikes)
+{
+  // number of distinct names
+  const size_t nNames = 1000000;
+
+  std::vector<Name> names;
+  names.reserve(nNames);
+  for (size_t i = 0; i < nNames; ++i) {
+    names.push_back(Name("/prefix" + to_string(i % 1000)).append(to_string(i)));
+    names.back().wireEncode();
+  }
+
+  for (bool isIncremental : {false, true}) {
+    NameTree nameTree;
+    nameTree.setIncrementalResize(isIncremental);
+    time::nanoseconds maxInsertTime(0);
+    time::nanoseconds maxEraseTime(0);
+
+    auto t1 = time::steady_clock::now();
+
+    for (const auto& name : names) {
+      auto t = time::steady_clock::now();
+      nameTree.lookup(name);
+      maxInsertTime = std::max(maxInsertTime, time::steady_clock::now() - t);
+    }
+    for (const auto& name : names) {
+      auto t = time::steady_clock::now();
+      nameTree.eraseIfEmpty(nameTree.findExactMatch(name));
+      maxEraseTime = std::max(maxEraseTime, time::steady_clock::now() - t);
+    }
+
+    auto t2 = time::steady_clock::now();
+
+    std::cout << (isIncremental ? "incremental" : "full")
+              << " total-time=" << time::duration_cast<time::microseconds>(t2 - t1)
+              << " max-insert-time=" << time::duration_cast<time::microseconds>(maxInsertTime)
+              << " max-erase-time=" << time::duration_cast<time::microseconds>(maxEraseTime)
+              << " rehashed-nodes=" << nameTree.getNRehashedNodes()
+              << " max-rehashed-nodes=" << nameTree.getMaxRehashedNodes()
+              << std::endl;
+  }
+}
+
+} // namespace tests
+} // namespace nfd
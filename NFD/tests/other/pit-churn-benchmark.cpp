@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "face/null-face.hpp"
+#include "table/pit.hpp"
+
+#include <iostream>
+
+#ifdef HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+class PitChurnBenchmarkFixture
+{
+protected:
+  PitChurnBenchmarkFixture()
+    : m_pit(m_nameTree)
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    for (size_t i = 0; i < N_FACES; ++i) {
+      m_faces.push_back(face::makeNullFace());
+    }
+  }
+
+  /** \brief generate Interests and the Data that satisfy them
+   */
+  void
+  generatePackets(size_t nPackets)
+  {
+    for (size_t i = 0; i < nPackets; ++i) {
+      Name name("/churn");
+      name.append(to_string(i % 1000)).append(to_string(i));
+
+      auto interest = make_shared<Interest>(name);
+      interest->setCanBePrefix(false);
+      interest->setNonce(static_cast<uint32_t>(i));
+      interests.push_back(interest);
+
+      data.push_back(make_shared<Data>(name));
+    }
+  }
+
+  /** \brief process an incoming Interest: one or two downstreams, one or two upstreams
+   */
+  shared_ptr<pit::Entry>
+  receiveInterest(size_t i)
+  {
+    const Interest& interest = *interests[i];
+    auto pitEntry = m_pit.insert(interest).first;
+    pitEntry->insertOrUpdateInRecord(*m_faces[i % N_FACES], interest);
+    if (i % 3 == 0) {
+      pitEntry->insertOrUpdateInRecord(*m_faces[(i + 1) % N_FACES], interest);
+    }
+    pitEntry->insertOrUpdateOutRecord(*m_faces[(i + 2) % N_FACES], interest);
+    if (i % 4 == 0) {
+      pitEntry->insertOrUpdateOutRecord(*m_faces[(i + 3) % N_FACES], interest);
+    }
+    return pitEntry;
+  }
+
+  /** \brief process an incoming Data, as it would arrive from the first upstream
+   */
+  void
+  receiveData(size_t i)
+  {
+    Face& upstream = *m_faces[(i + 2) % N_FACES];
+    for (const auto& pitEntry : m_pit.findAllDataMatches(*data[i])) {
+      auto outRecord = pitEntry->getOutRecord(upstream);
+      BOOST_ASSERT(outRecord != pitEntry->out_end());
+      for (const auto& inRecord : pitEntry->getInRecords()) {
+        // a pending downstream would be sent the Data
+        if (inRecord.getExpiry() > outRecord->getLastRenewed()) {
+          ++nDataSent;
+        }
+      }
+      pitEntry->clearInRecords();
+      pitEntry->deleteOutRecord(upstream);
+      m_pit.erase(pitEntry.get());
+    }
+  }
+
+protected:
+  std::vector<shared_ptr<Interest>> interests;
+  std::vector<shared_ptr<Data>> data;
+  size_t nDataSent = 0;
+
+  static constexpr size_t N_FACES = 16;
+  std::vector<shared_ptr<Face>> m_faces;
+
+  NameTree m_nameTree;
+  Pit m_pit;
+};
+
+// This test case models PIT churn: batches of Interests are inserted with their in-records and
+// out-records, then most of them are satisfied by Data, and the rest expire.
+// The time spent in each phase is reported separately.
+BOOST_FIXTURE_TEST_CASE(InsertSatisfyExpire, PitChurnBenchmarkFixture)
+{
+  // total number of Interests
+  const size_t nInterests = 1000000;
+  // number of Interests pending at the same time
+  const size_t batchSize = 20000;
+  // one in this many Interests expires instead of being satisfied
+  const size_t expireRatio = 10;
+
+  generatePackets(nInterests);
+  std::vector<shared_ptr<pit::Entry>> expiring;
+  expiring.reserve(batchSize / expireRatio + 1);
+
+  time::nanoseconds insertTime(0);
+  time::nanoseconds satisfyTime(0);
+  time::nanoseconds expireTime(0);
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+  for (size_t first = 0; first < nInterests; first += batchSize) {
+    size_t last = std::min(first + batchSize, nInterests);
+
+    auto t1 = time::steady_clock::now();
+    for (size_t i = first; i < last; ++i) {
+      auto pitEntry = receiveInterest(i);
+      if (i % expireRatio == 0) {
+        expiring.push_back(std::move(pitEntry));
+      }
+    }
+
+    auto t2 = time::steady_clock::now();
+    for (size_t i = first; i < last; ++i) {
+      if (i % expireRatio != 0) {
+        receiveData(i);
+      }
+    }
+
+    auto t3 = time::steady_clock::now();
+    for (const auto& pitEntry : expiring) {
+      m_pit.erase(pitEntry.get());
+    }
+    expiring.clear();
+
+    auto t4 = time::steady_clock::now();
+    insertTime += t2 - t1;
+    satisfyTime += t3 - t2;
+    expireTime += t4 - t3;
+  }
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+  BOOST_CHECK_EQUAL(m_pit.size(), 0);
+  BOOST_CHECK_GT(nDataSent, 0);
+
+  size_t nExpired = (nInterests + expireRatio - 1) / expireRatio;
+  size_t nSatisfied = nInterests - nExpired;
+  auto printRate = [] (const char* phase, size_t nOps, time::nanoseconds d) {
+    std::cout << phase << " " << nOps << ": " << time::duration_cast<time::microseconds>(d)
+              << " (" << static_cast<uint64_t>(nOps / time::duration<double>(d).count()) << "/s)"
+              << std::endl;
+  };
+  printRate("insert", nInterests, insertTime);
+  printRate("satisfy", nSatisfied, satisfyTime);
+  printRate("expire", nExpired, expireTime);
+}
+
+} // namespace tests
+} // namespace nfd
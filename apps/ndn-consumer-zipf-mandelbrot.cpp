@@ -134,10 +134,7 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s max -> " << m_seqMax << "\n";
 
-  while (m_retxSeqs.size()) {
-    seq = *m_retxSeqs.begin();
-    m_retxSeqs.erase(m_retxSeqs.begin());
-
+  if (m_seqWindow.popRetx(seq)) {
     // NS_ASSERT (m_seqLifetimes.find (seq) != m_seqLifetimes.end ());
     // if (m_seqLifetimes.find (seq)->time <= Simulator::Now ())
     //   {
@@ -147,8 +144,7 @@ ConsumerZipfMandelbrot::SendPacket()
     //     sequence number
     //     continue;
     //   }
-    NS_LOG_DEBUG("=interest seq " << seq << " from m_retxSeqs");
-    break;
+    NS_LOG_DEBUG("=interest seq " << seq << " from m_seqWindow");
   }
 
   if (seq == std::numeric_limits<uint32_t>::max()) // no retransmission
@@ -177,15 +173,9 @@ ConsumerZipfMandelbrot::SendPacket()
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
   NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqLastDelay.erase(seq);
-  m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
+                                << m_seqWindow.size() << " items");
 
-  m_seqRetxCounts[seq]++;
+  m_seqWindow.sent(seq, Simulator::Now());
 
   m_rtt->SentSeq(SequenceNumber32(seq), 1);
 
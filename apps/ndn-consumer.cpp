@@ -115,17 +115,9 @@ Consumer::CheckRetxTimeout()
   Time rto = m_rtt->RetransmitTimeout();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
-    {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
-      OnTimeout(seqNo);
-    }
-    else
-      break; // nothing else to do. All later packets need not be retransmitted
+  uint32_t seqNo;
+  while (m_seqWindow.popExpired(now - rto, seqNo)) { // timeout expired?
+    OnTimeout(seqNo);
   }
 
   m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
@@ -165,13 +157,7 @@ Consumer::SendPacket()
 
   uint32_t seq = std::numeric_limits<uint32_t>::max(); // invalid
 
-  while (m_retxSeqs.size()) {
-    seq = *m_retxSeqs.begin();
-    m_retxSeqs.erase(m_retxSeqs.begin());
-    break;
-  }
-
-  if (seq == std::numeric_limits<uint32_t>::max()) {
+  if (!m_seqWindow.popRetx(seq)) {
     if (m_seqMax != std::numeric_limits<uint32_t>::max()) {
       if (m_seq >= m_seqMax) {
         return; // we are totally done
@@ -232,23 +218,16 @@ Consumer::OnData(shared_ptr<const Data> data)
   }
   NS_LOG_DEBUG("Hop count: " << hopCount);
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
-  }
-
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+  SeqWindow::Entry* entry = m_seqWindow.find(seq);
+  if (entry != nullptr) {
+    if (entry->nSent > 0) {
+      m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->lastSent, hopCount);
+      m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->firstSent, entry->nSent,
+                               hopCount);
+    }
+    m_seqWindow.erase(seq);
   }
 
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
-  m_retxSeqs.erase(seq);
-
   m_rtt->AckSeq(SequenceNumber32(seq));
 }
 
@@ -272,7 +251,7 @@ Consumer::OnTimeout(uint32_t sequenceNumber)
   m_rtt->IncreaseMultiplier(); // Double the next RTO
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber),
                  1); // make sure to disable RTT calculation for this sample
-  m_retxSeqs.insert(sequenceNumber);
+  m_seqWindow.scheduleRetx(sequenceNumber);
   ScheduleNextPacket();
 }
 
@@ -280,15 +259,9 @@ void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+                                << m_seqWindow.size() << " items");
 
-  m_seqRetxCounts[sequenceNumber]++;
+  m_seqWindow.sent(sequenceNumber, Simulator::Now());
 
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
 }
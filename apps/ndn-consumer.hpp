@@ -30,14 +30,7 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
-
-#include <set>
-#include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include "ns3/ndnSIM/utils/ndn-seq-window.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -146,64 +139,9 @@ protected:
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
 
-  /// @cond include_hidden
-  /**
-   * \struct This struct contains sequence numbers of packets to be retransmitted
-   */
-  struct RetxSeqsContainer : public std::set<uint32_t> {
-  };
-
-  RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
-
-  /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
-   */
-  struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
-      : seq(_seq)
-      , time(_time)
-    {
-    }
-
-    uint32_t seq;
-    Time time;
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
+  SeqWindow m_seqWindow; ///< @brief state of outstanding and to be retransmitted Interests
 
   /// @cond include_hidden
-  /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
-
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */,
@@ -22,6 +22,7 @@ def register_types(module):
     module.add_class('Object', import_from_module='ns.core', parent=module['ns3::SimpleRefCount< ns3::Object, ns3::ObjectBase, ns3::ObjectDeleter >'])
 
     module.add_class('TypeId', import_from_module='ns.core')
+    module.add_class('Time', import_from_module='ns.core')
     module.add_class('AttributeValue', import_from_module='ns.core')
 
     module.add_class('NodeContainer', import_from_module='ns.network')
@@ -35,6 +36,11 @@ def register_types(module):
         module.add_class('AppHelper')
         module.add_class('GlobalRoutingHelper')
 
+        module.add_class('Histogram')
+        module.add_class('AppDelayTracer')
+        module.add_enum('Aggregation', ['NONE', 'PER_APP', 'PER_PREFIX'],
+                        outer_class=module['ns3::ndn::AppDelayTracer'])
+
         module.add_class('L3Protocol', parent=module.get_root()['ns3::Object'])
 
         module.add_class('Name')
@@ -152,6 +158,39 @@ def register_methods(root_module):
         cls.add_method('CalculateAllPossibleRoutes', 'void', [])
     reg_GlobalRoutingHelper(root_module['ns3::ndn::GlobalRoutingHelper'])
 
+    def reg_Histogram(cls):
+        cls.add_constructor([param('int', 'subBucketBits', default_value='7')])
+        cls.add_constructor([param('const ns3::ndn::Histogram&', 'other')])
+        cls.add_method('record', 'void', [param('uint64_t', 'value'), param('uint64_t', 'count', default_value='1')])
+        cls.add_method('merge', 'void', [param('const ns3::ndn::Histogram&', 'other')])
+        cls.add_method('reset', 'void', [])
+        cls.add_method('getCount', 'uint64_t', [], is_const=True)
+        cls.add_method('getMin', 'uint64_t', [], is_const=True)
+        cls.add_method('getMax', 'uint64_t', [], is_const=True)
+        cls.add_method('getMean', 'double', [], is_const=True)
+        cls.add_method('getPercentile', 'uint64_t', [param('double', 'percentile')], is_const=True)
+    reg_Histogram(root_module['ns3::ndn::Histogram'])
+
+    def reg_AppDelayTracer(cls):
+        cls.add_method('InstallAll', 'void', [param('const std::string&', 'file')], is_static=True)
+        cls.add_method('InstallAll', 'void', [param('const std::string&', 'file'),
+                                              param('ns3::ndn::AppDelayTracer::Aggregation', 'aggregation'),
+                                              param('ns3::Time', 'period', default_value='ns3::Seconds(1.0)')], is_static=True)
+        cls.add_method('Install', 'void', [param('const ns3::NodeContainer&', 'nodes'),
+                                           param('const std::string&', 'file')], is_static=True)
+        cls.add_method('Install', 'void', [param('const ns3::NodeContainer&', 'nodes'),
+                                           param('const std::string&', 'file'),
+                                           param('ns3::ndn::AppDelayTracer::Aggregation', 'aggregation'),
+                                           param('ns3::Time', 'period', default_value='ns3::Seconds(1.0)')], is_static=True)
+        cls.add_method('Destroy', 'void', [], is_static=True)
+        cls.add_method('GetAppHistogram', 'ns3::ndn::Histogram', [param('ns3::Ptr<ns3::Node>', 'node'),
+                                                                  param('uint32_t', 'appId'),
+                                                                  param('const std::string&', 'type')], is_static=True)
+        cls.add_method('GetPrefixHistogram', 'ns3::ndn::Histogram', [param('ns3::Ptr<ns3::Node>', 'node'),
+                                                                     param('const std::string&', 'prefix'),
+                                                                     param('const std::string&', 'type')], is_static=True)
+    reg_AppDelayTracer(root_module['ns3::ndn::AppDelayTracer'])
+
     def reg_Name(root_module, cls):
         cls.add_output_stream_operator()
         for op in ['==', '!=', '<', '<=', '>', '>=']:
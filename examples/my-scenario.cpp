@@ -34,6 +34,7 @@
 // my header files
 //#include "SimulationUtility.h"
 #include "NFD/daemon/fw/my-multicast-strategy.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
 
 namespace ns3 {
   
@@ -70,6 +71,28 @@ NS_LOG_COMPONENT_DEFINE ("Scenario");
           << ", z=" << vel.z << std::endl;
     }
 
+    // Prints forwarding zone decisions of MyMulticastStrategy on all nodes
+    static void
+    ConnectForwardingZoneTraces(NodeContainer nodes)
+    {
+      for (auto node = nodes.Begin(); node != nodes.End(); ++node) {
+        auto forwarder = (*node)->GetObject<ndn::L3Protocol>()->getForwarder();
+        auto strategy = dynamic_cast<nfd::fw::MyMulticastStrategy*>(
+          &forwarder->getStrategyChoice().findEffectiveStrategy("/"));
+        if (strategy == nullptr) {
+          continue;
+        }
+        uint32_t nodeId = (*node)->GetId();
+        strategy->afterZoneCheck.connect([nodeId] (const ndn::Interest& interest,
+                                                   const nfd::fw::ForwardingZone& zone,
+                                                   double x, double y, bool isInside) {
+            std::cout << Simulator::Now() << " Node " << nodeId << " [" << x << "," << y << "] "
+                      << interest.getName() << " zone " << zone
+                      << (isInside ? " inside" : " outside") << std::endl;
+          });
+      }
+    }
+
     //testing mobility
     void
     installTestMobility(NodeContainer &c, int simulTime) {
@@ -99,7 +122,9 @@ NS_LOG_COMPONENT_DEFINE ("Scenario");
         // Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
         
         // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
+        bool traceZone = false;
         CommandLine cmd;
+        cmd.AddValue("traceZone", "Print forwarding zone decisions of every Interest", traceZone);
         cmd.Parse(argc, argv);
         // /home/osboxes/Sumo/manhattan/data/manhattanMobility.tcl
         //SimulationUtility simulUtils = SimulationUtility("/home/osboxes/Sumo/manhattan/data/manhattanMobility.tcl");
@@ -166,6 +191,10 @@ NS_LOG_COMPONENT_DEFINE ("Scenario");
         
         //ndn::StrategyChoiceHelper::Install(nodes, "/", "/localhost/nfd/strategy/multicast");
         ndn::StrategyChoiceHelper::Install<nfd::fw::MyMulticastStrategy>(nodes, "/");
+        if (traceZone) {
+            // strategies are installed at the start of the simulation
+            Simulator::Schedule(Seconds(0), &ConnectForwardingZoneTraces, nodes);
+        }
         ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
         ndnGlobalRoutingHelper.InstallAll();
         
@@ -232,6 +232,7 @@ NS_LOG_COMPONENT_DEFINE ("NeighborScenario");
         float pConsumers = 10;    //in percentage (%) (10|25|50%)
         uint32_t nProducers = 2;
         uint32_t nLines = 3;
+        std::string fcdFile = "";
 
         // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
         CommandLine cmd;
@@ -242,6 +243,7 @@ NS_LOG_COMPONENT_DEFINE ("NeighborScenario");
         cmd.AddValue ("t", "Simulation time (seconds)", simulTime);
         cmd.AddValue ("c", "Percentage of Consumers", pConsumers);
         cmd.AddValue ("p", "Number of Producers", nProducers);
+        cmd.AddValue ("fcd", "SUMO FCD trace (XML or binary) to read while the simulation runs, instead of the ns-2 trace", fcdFile);
         cmd.Parse (argc, argv);
 
         std::cout << "Scenario: " << scenario << std::endl;
@@ -252,20 +254,22 @@ NS_LOG_COMPONENT_DEFINE ("NeighborScenario");
         std::cout << "Number of Consumers: " << nNodes * (pConsumers/100) << " ~(" << pConsumers << "%)" << std::endl;
 
         // /home/leandro/Sumo/manhattan/data/manhattanMobility.tcl
-        SimulationUtility simulUtils = SimulationUtility("/home/osboxes/Sumo/manhattan-"+ std::to_string(nLines) +"l/manhattanMobility.tcl");
+        std::string ns2TraceFile = "/home/osboxes/Sumo/manhattan-"+ std::to_string(nLines) +"l/manhattanMobility.tcl";
+        SimulationUtility simulUtils = SimulationUtility(fcdFile.empty() ? ns2TraceFile : "");
         
         //ManhattanModel -> "/home/leandro/Sumo/manhattan/data/manhattanMobility.tcl" v=30 t=2180s
         //ManhattanModel -> "/home/leandro/Sumo/manhattan-3l/data/manhattanMobility.tcl" v=60 t=4146s
         //Berlin ->"/home/leandro/Sumo/Berlin/ns2mobility.tcl" v=458 t=878s    -->testing params: c=46|115|229 (10|25|50%)
         //Guimarães ->"/home/leandro/Sumo/guimarães-300v/ns2mobility.tcl" v=326 t=814s    -->testing params: c=33|82|163 (10|25|50%)
-        Ns2MobilityHelper ns2MobHelper = Ns2MobilityHelper("/home/osboxes/Sumo/manhattan-"+ std::to_string(nLines) +"l/manhattanMobility.tcl");
-
-
         // Creating nodes
         NodeContainer nodes;
         nodes.Create(nNodes);
+        NodeContainer vehicles = nodes;
 
-        ns2MobHelper.Install();
+        if (fcdFile.empty()) {
+            Ns2MobilityHelper ns2MobHelper = Ns2MobilityHelper(ns2TraceFile);
+            ns2MobHelper.Install();
+        }
         
         //Add producers nodes
         NodeContainer producerNodes;
@@ -335,6 +339,12 @@ NS_LOG_COMPONENT_DEFINE ("NeighborScenario");
         ndnHelper.Install(nodes);
         std::cout << "Done setting NDN!" << std::endl;
 
+        if (!fcdFile.empty()) {
+            // waypoints are read a few seconds ahead, and vehicles are active only while in the trace
+            ndn::SumoMobilityHelper sumoHelper(fcdFile);
+            sumoHelper.Install(vehicles);
+        }
+
         std::cout << "Setting Strategies..." << std::endl;
         if(scenario.compare("multicast") == 0)
             ndn::StrategyChoiceHelper::Install(nodes, "/","/localhost/nfd/strategy/multicast");
@@ -386,8 +396,15 @@ NS_LOG_COMPONENT_DEFINE ("NeighborScenario");
             Ptr<Node> n = consumers.Get(i);
             auto app = consumersHelper.Install(n);
 
-            app.Start(Seconds(simulUtils.getSimulationNodeEntryTime(n->GetId())));
-            app.Stop(Seconds(simulUtils.getSimulationNodeExitTime(n->GetId())));
+            if (fcdFile.empty()) {
+                app.Start(Seconds(simulUtils.getSimulationNodeEntryTime(n->GetId())));
+                app.Stop(Seconds(simulUtils.getSimulationNodeExitTime(n->GetId())));
+            }
+            else {
+                // Interests are dropped while the vehicle is not in the trace
+                app.Start(Seconds(0));
+                app.Stop(Seconds(simulTime));
+            }
 
         }
         std::cout << "Done setting Consumers!" << std::endl;
@@ -432,7 +449,9 @@ NS_LOG_COMPONENT_DEFINE ("NeighborScenario");
         //AnimationInterface anim(animFile);
         std::string dirName = "/" + std::to_string(nNodes) +"V"+ std::to_string(static_cast<int>(pConsumers)) + "C";
         std::cout << "File Name: " << "/home/osboxes/ndnSIM/simulations/" + scenario + dirName + "/rate-trace_" + scenario + ".txt" << std::endl;
-        ndn::L3RateTracer::Install(nodes, "/home/osboxes/ndnSIM/simulations/" + scenario + dirName + "/rate-trace_" + scenario + ".txt", Seconds(1));
+        ndn::L3TracerFilter rateFilter;
+        rateFilter.prefixes = {"/parkinglot1", "/parkinglot2"};
+        ndn::L3RateTracer::Install(nodes, "/home/osboxes/ndnSIM/simulations/" + scenario + dirName + "/rate-trace_" + scenario + ".txt", Seconds(1), rateFilter);
         ndn::AppDelayTracer::Install(consumers, "/home/osboxes/ndnSIM/simulations/app-delays-trace.txt");
         pBar bar(simulTime);
         std::cout << YELLOW_CODE << BOLD_CODE << "Simulation is running: " END_CODE << std::endl;
@@ -31,20 +31,19 @@
 namespace ns3 {
 namespace ndn {
 
-using std::set;
-
 AbstractFib::AbstractFib(const Ptr<GlobalRouter> own, int numNodes)
   : nodeId{static_cast<int>(own->GetObject<ns3::Node>()->GetId())}
   , nodeName{ns3::Names::FindName(own->GetObject<ns3::Node>())}
   , numberOfNodes{numNodes}
   , nodeDegree{static_cast<int>(own->GetIncidencies().size())}
   , ownRouter{own}
-  , upwardCounter{0}
-  , totalNhCounter{0}
 {
   checkInputs();
 
-  createEmptyFib();
+  // Create empty FIB (unused slots hold a placeholder):
+  nexthops.resize(static_cast<size_t>(numberOfNodes) * nodeDegree,
+                  FibNextHop{FibNextHop::MAX_COST, 0});
+  numNhPerDst.resize(numberOfNodes, 0);
 }
 
 void
@@ -62,16 +61,11 @@ AbstractFib::checkInputs()
 }
 
 void
-AbstractFib::createEmptyFib()
+AbstractFib::checkDst(int dstId) const
 {
-  // Create empty FIB:
-  for (int dstId = 0; dstId < numberOfNodes; dstId++) {
-    if (dstId == nodeId) {
-      continue;
-    }
-    perDstFib.insert({dstId, {}});
-    upwardPerDstFib.insert({dstId, {}});
-  }
+  NS_ABORT_MSG_IF(dstId == nodeId, "Requested destination id is the same as current nodeId!");
+  NS_ABORT_MSG_IF(dstId < 0 || dstId >= numberOfNodes,
+                  "Node " << nodeId << " No nexthops for dst: " << dstId << "!");
 }
 
 Ptr<GlobalRouter>
@@ -86,77 +80,87 @@ AbstractFib::insert(int dstId, const FibNextHop& nh)
 {
   NS_ABORT_UNLESS(nh.getType() == NextHopType::DOWNWARD || nh.getType() == NextHopType::UPWARD);
   NS_ABORT_UNLESS(nh.getNexthopId() != nodeId);
-
-  bool inserted1 = perDstFib.at(dstId).insert(nh).second;
-  BOOST_VERIFY(inserted1); // Check if it didn't exist yet.
-  totalNhCounter++;
-
-  if (nh.getType() == NextHopType::UPWARD) {
-    bool inserted2 = upwardPerDstFib.at(dstId).insert(nh).second;
-    BOOST_VERIFY(inserted2);
-    upwardCounter++;
-  }
+  checkDst(dstId);
+
+  // At most one nexthop per face:
+  int& numNhs = numNhPerDst[dstId];
+  NS_ABORT_UNLESS(numNhs < nodeDegree);
+
+  auto begin = nexthops.begin() + static_cast<size_t>(dstId) * nodeDegree;
+  auto end = begin + numNhs;
+  BOOST_VERIFY(std::none_of(begin, end, [&](const FibNextHop& item) {
+    return item.getNexthopId() == nh.getNexthopId();
+  })); // Check if it didn't exist yet.
+
+  auto position = std::upper_bound(begin, end, nh);
+  std::move_backward(position, end, end + 1);
+  *position = nh;
+  numNhs++;
 }
 
 size_t
 AbstractFib::erase(int dstId, int nhId)
 {
-  auto& fib{perDstFib.at(dstId)};
+  checkDst(dstId);
+  int& numNhs = numNhPerDst[dstId];
+  auto begin = nexthops.begin() + static_cast<size_t>(dstId) * nodeDegree;
+  auto end = begin + numNhs;
 
-  auto fibNh = std::find_if(fib.begin(), fib.end(),
+  auto fibNh = std::find_if(begin, end,
                             [&](const FibNextHop& item) { return item.getNexthopId() == nhId; });
 
   // Element doesn't exist:
-  if (fibNh == fib.end()) {
+  if (fibNh == end) {
 
     // TODO: Figure out why this happens.
     return 0;
   }
 
-  NS_ABORT_UNLESS(fibNh != perDstFib.at(dstId).end());
   NS_ABORT_UNLESS(fibNh->getType() == NextHopType::UPWARD);
-  totalNhCounter--;
 
-  fib.erase(fibNh);
-  auto numErased2 = upwardPerDstFib.at(dstId).erase(*fibNh);
-  NS_ABORT_UNLESS(numErased2 == 1);
-  upwardCounter--;
+  std::move(fibNh + 1, end, fibNh);
+  numNhs--;
 
-  return numErased2;
+  return 1;
 }
 
 // O(1)
-const set<FibNextHop>&
+AbstractFib::NexthopRange
 AbstractFib::getNexthops(int dstId) const
 {
-  NS_ABORT_MSG_IF(dstId == nodeId, "Requested destination id is the same as current nodeId!");
-  NS_ABORT_MSG_IF(perDstFib.count(dstId) == 0,
-                  "Node " << nodeId << " No nexthops for dst: " << dstId << "!");
-  NS_ABORT_UNLESS(perDstFib.count(dstId) != 0);
-  return perDstFib.at(dstId);
+  checkDst(dstId);
+  auto begin = nexthops.cbegin() + static_cast<size_t>(dstId) * nodeDegree;
+  return {begin, begin + numNhPerDst[dstId]};
 }
 
-const set<FibNextHop>&
+std::vector<FibNextHop>
 AbstractFib::getUpwardNexthops(int dstId) const
 {
-  NS_ABORT_MSG_IF(dstId == nodeId, "Requested destination id is the same as current nodeId!");
-  NS_ABORT_MSG_IF(perDstFib.count(dstId) == 0,
-                  "Node " << nodeId << " No nexthops for dst: " << dstId << "!");
-  return upwardPerDstFib.at(dstId);
+  std::vector<FibNextHop> upwardNexthops;
+  for (const FibNextHop& nh : getNexthops(dstId)) {
+    if (nh.getType() == NextHopType::UPWARD) {
+      upwardNexthops.push_back(nh);
+    }
+  }
+  return upwardNexthops;
 }
 
 void
 AbstractFib::checkFib() const
 {
-  BOOST_VERIFY(perDstFib.size() > 0);
+  BOOST_VERIFY(getNumDsts() > 0);
 
-  for (const auto& fibSet : perDstFib) {
-    const size_t numNhs = fibSet.second.size();
+  for (int dstId = 0; dstId < numberOfNodes; dstId++) {
+    if (dstId == nodeId) {
+      continue;
+    }
+    const auto fibNhs = getNexthops(dstId);
+    const size_t numNhs = fibNhs.size();
 
     bool hasDownward{false};
     std::unordered_set<int> nextHopSet{};
 
-    for (const FibNextHop& nextHop : fibSet.second) {
+    for (const FibNextHop& nextHop : fibNhs) {
       BOOST_VERIFY(nextHop.getCost() > 0 && nextHop.getCost() < FibNextHop::MAX_COST);
       if (nextHop.getType() == NextHopType::DOWNWARD) {
         hasDownward = true;
@@ -167,17 +171,20 @@ AbstractFib::checkFib() const
       nextHopSet.emplace(nextHop.getNexthopId());
     }
     BOOST_VERIFY(hasDownward || numNhs == 0);
-    BOOST_VERIFY(nextHopSet.size() == fibSet.second.size());
+    BOOST_VERIFY(nextHopSet.size() == numNhs);
   }
 }
 
 std::ostream&
 operator<<(std::ostream& os, const AbstractFib& fib)
 {
-  for (const auto& entry : fib.perDstFib) {
+  for (int dstId = 0; dstId < fib.numberOfNodes; dstId++) {
+    if (dstId == fib.nodeId) {
+      continue;
+    }
     os << "\nFIB node: " << fib.nodeName << fib.nodeId << "\n";
-    os << "Dst: " << entry.first << "\n";
-    for (const auto& nh : entry.second) {
+    os << "Dst: " << dstId << "\n";
+    for (const auto& nh : fib.getNexthops(dstId)) {
       os << nh << "\n";
     }
   }
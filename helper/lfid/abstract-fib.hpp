@@ -21,8 +21,9 @@
 #ifndef LFID_ABS_FIB_H
 #define LFID_ABS_FIB_H
 
-#include <set>
-#include <unordered_map>
+#include <vector>
+
+#include <boost/range/iterator_range.hpp>
 
 #include "ns3/abort.h"
 #include "ns3/ndnSIM/helper/lfid/fib-nexthop.hpp"
@@ -35,10 +36,16 @@ class GlobalRouter;
 
 /**
  * An abstract, lightweight representation of the FIB.
+ *
+ * Nexthops are kept in one flat array, with a slice of nodeDegree entries per destination.
+ * Nexthops of different destinations can be changed from different threads.
  */
 class AbstractFib {
 public:
-  using AllNodeFib = std::unordered_map<int, AbstractFib>;
+  // Indexed by node id:
+  using AllNodeFib = std::vector<AbstractFib>;
+
+  using NexthopRange = boost::iterator_range<std::vector<FibNextHop>::const_iterator>;
 
   /**
    * @param own The GlobalRouter object representing the current router
@@ -49,15 +56,15 @@ public:
 public:
   // Getters:
   /**
-   * @return Return set of nexthops per destination
+   * @return Return nexthops per destination, ordered by (costDelta, cost, nhId)
    */
-  const std::set<FibNextHop>&
+  NexthopRange
   getNexthops(int dstId) const;
 
   /**
-   * @return Return set of upward nexthops per destination
+   * @return Return upward nexthops per destination, ordered by (costDelta, cost, nhId)
    */
-  const std::set<FibNextHop>&
+  std::vector<FibNextHop>
   getUpwardNexthops(int dstId) const;
 
   /**
@@ -101,26 +108,13 @@ public:
   int
   getNumDsts() const
   {
-    return static_cast<int>(perDstFib.size());
+    return numberOfNodes - 1;
   }
 
   bool
   contains(int dstId) const
   {
-    return perDstFib.count(dstId) > 0;
-  }
-
-  // Functions for range-based loop:
-  auto
-  begin() const
-  {
-    return perDstFib.cbegin();
-  }
-
-  auto
-  end() const
-  {
-    return perDstFib.cend();
+    return dstId >= 0 && dstId < numberOfNodes && dstId != nodeId;
   }
 
   // Setters:
@@ -135,7 +129,7 @@ private:
   checkInputs();
 
   void
-  createEmptyFib();
+  checkDst(int dstId) const;
 
 private:
   const int nodeId;           // Own node id
@@ -144,12 +138,9 @@ private:
   const int nodeDegree;
   const Ptr<GlobalRouter> ownRouter;
 
-  int upwardCounter;
-  int totalNhCounter;
-
-  // DstId -> set<FibNextHop>
-  std::unordered_map<int, std::set<FibNextHop>> perDstFib;
-  std::unordered_map<int, std::set<FibNextHop>> upwardPerDstFib;
+  // Nexthops of dstId: [dstId * nodeDegree, dstId * nodeDegree + numNhPerDst[dstId])
+  std::vector<FibNextHop> nexthops;
+  std::vector<int> numNhPerDst;
 
   friend std::ostream&
   operator<<(std::ostream&, const AbstractFib& fib);
@@ -26,7 +26,7 @@
 namespace ns3 {
 namespace ndn {
 
-constexpr int NODE_ID_LIMIT = 1000;
+constexpr int NODE_ID_LIMIT = 100 * 1000;
 
 FibNextHop::FibNextHop(int cost, int nhId, int costDelta, NextHopType type)
 {
@@ -20,153 +20,116 @@
 
 #include "ns3/ndnSIM/helper/ndn-global-routing-helper.hpp"
 
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-#include <boost/graph/graph_utility.hpp>
-
-#include "ns3/ndnSIM/helper/boost-graph-ndn-global-routing-helper.hpp"
 #include "ns3/ndnSIM/helper/lfid/abstract-fib.hpp"
 #include "ns3/ndnSIM/helper/lfid/remove-loops.hpp"
 #include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.hpp"
 #include "ns3/ndnSIM/model/ndn-global-router.hpp"
 
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+
+#include <unordered_map>
+
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelperLfid");
 
 namespace ns3 {
 namespace ndn {
 
-using std::get;
 using std::unordered_map;
+using VertexId = GlobalRoutingGraph::VertexId;
+using Distance = GlobalRoutingGraph::Distance;
 
 void
 GlobalRoutingHelper::CalculateLfidRoutes()
 {
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
-
   // Creates graph from nodeList:
-  boost::NdnGlobalRouterGraph graph{};
-
-  AbstractFib::AllNodeFib allNodeFIB;
-
-  // Store mapping nodeId -> faceId -> Ptr<Face>
-  unordered_map<int, unordered_map<nfd::FaceId, shared_ptr<Face>>> faceMap;
-
-  // For all existing nodes:
-  for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
-
-    int nodeId = static_cast<int>((*node)->GetId());
-    const Ptr<GlobalRouter>& source = (*node)->GetObject<GlobalRouter>();
-
-    AbstractFib nodeFib = AbstractFib{source, static_cast<int>(NodeList::GetNNodes())};
-
-    if (source == nullptr) {
-      NS_LOG_ERROR("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
-    }
-
-    // map: neighborId -> DistancesMap
-    unordered_map<int, boost::DistancesMap> nbSp;
-
-    // map: Destination (GlobalRouter) -> Distance
-    boost::DistancesMap distMap;
-    unordered_map<int, boost::DistancesMap> neighborSpMap;
-
-    dijkstra_shortest_paths(graph, source,
-                            distance_map(boost::ref(distMap))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
-
-    // 1. Get all neighbors of node.
-    unordered_map<nfd::FaceId, uint64_t> originalMetrics;
-    auto& originalFace = faceMap[nodeId];
-
-    const GlobalRouter::IncidencyList& neighbors = source->GetIncidencies();
-    // Set link weight of all neighbors to infinity
-    for (const auto& neighbor : neighbors) {
-      int nbId = get<2>(neighbor)->GetObject<ns3::Node>()->GetId();
-      NS_ABORT_UNLESS(nbId != nodeId);
+  GlobalRoutingGraph graph;
 
-      auto& face = get<shared_ptr<Face>>(neighbor);
-      NS_ABORT_UNLESS(face != nullptr);
+  const int numNodes = static_cast<int>(NodeList::GetNNodes());
+  const size_t numVertices = graph.getNVertices();
 
-      originalMetrics[nbId] = face->getMetric();
-      originalFace[nbId] = face; // Is only a copy
-      face->setMetric(get<uint16_t>(boost::WeightInf));
-    }
-
-    // 2. Calculate Dijkstra for neighbors
-    for (const auto& neighbor : neighbors) {
-      const auto& nSource = get<0>(neighbor);
-      const auto& target = get<2>(neighbor);
-
-      int nbId = target->GetObject<ns3::Node>()->GetId();
-      Ptr<GlobalRouter> nbRouter = target;
+  // Vertices are used as node ids, so all nodes and no channels must have a GlobalRouter:
+  NS_ABORT_MSG_IF(numVertices != static_cast<size_t>(numNodes),
+                  "LFID requires GlobalRouter on all nodes and point-to-point links only");
 
-      NS_ABORT_UNLESS(target != source && nbId != nodeId);
-      NS_ABORT_UNLESS(nSource == source);
+  std::vector<VertexId> sources;
+  AbstractFib::AllNodeFib allNodeFIB;
+  allNodeFIB.reserve(numNodes);
+  for (VertexId v = 0; v < numVertices; v++) {
+    NS_ABORT_MSG_IF(graph.getNode(v) == nullptr || graph.getNode(v)->GetId() != v,
+                    "LFID requires GlobalRouter on all nodes and point-to-point links only");
+    sources.push_back(v);
+    allNodeFIB.emplace_back(graph.getRouter(v), numNodes);
+  }
 
-      dijkstra_shortest_paths(graph, nbRouter,
-                              distance_map(boost::ref(neighborSpMap[nbId]))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
-    }
+  // 1.-4. For each node, in parallel: Calculate shortest paths via each neighbor, excluding
+  // paths that go back through the node itself, and fill its Abstract FIB.
+  graph.forEachSource<std::vector<Distance>>(sources,
+    [&] (VertexId source, std::vector<Distance>& distances) {
+      const size_t degree = graph.computeFirstHopPaths(source, distances);
+
+      // Neighbor and link cost of each face, in the order of the paths:
+      std::vector<std::pair<int, uint32_t>> neighbors;
+      graph.forEachOutEdge(source, [&] (GlobalRoutingGraph::EdgeIndex, VertexId target,
+                                        const Distance& weight) {
+          NS_ABORT_UNLESS(target != source);
+          neighbors.emplace_back(static_cast<int>(target), weight.cost);
+        });
+      NS_ABORT_UNLESS(neighbors.size() == degree);
+
+      // With parallel links, only the last one is used for a neighbor
+      std::vector<bool> isUsed(degree, true);
+      for (size_t i = 0; i < degree; i++) {
+        for (size_t j = i + 1; j < degree; j++) {
+          if (neighbors[i].first == neighbors[j].first) {
+            isUsed[i] = false;
+          }
+        }
+      }
 
-    // 3. Reset link weights
-    for (const auto& neighbor : neighbors) {
-      int nbId = get<2>(neighbor)->GetObject<ns3::Node>()->GetId();
-      NS_ABORT_UNLESS(nbId != nodeId);
+      AbstractFib& nodeFib = allNodeFIB[source];
 
-      const auto& face = get<shared_ptr<Face>>(neighbor);
-      NS_ABORT_UNLESS(face->getMetric() == get<uint16_t>(boost::WeightInf));
-      face->setMetric(originalMetrics.at(nbId));
-    }
+      // For each destination:
+      for (VertexId dst = 0; dst < numVertices; dst++) {
+        if (dst == source)
+          continue; // Skip destination == source.
 
-    // 4. Fill Abstract FIB:
-    // For each destination:
-    for (const auto& dstEntry : distMap) {
-      Ptr<GlobalRouter> dstRouter = dstEntry.first;
-      int dstId = dstRouter->GetObject<ns3::Node>()->GetId();
-      if (dstRouter == source)
-        continue; // Skip destination == source.
-
-      int spTotalCost = static_cast<int>(get<uint32_t>(dstEntry.second));
+        uint32_t spTotalCost = GlobalRoutingGraph::INF_COST;
+        for (size_t i = 0; i < degree; i++) {
+          spTotalCost = std::min(spTotalCost, distances[i * numVertices + dst].cost);
+        }
 
-      // For each neighbor:
-      for (const auto& nb : neighborSpMap) {
-        int neighborId = nb.first;
-        const uint32_t nbDist{get<uint32_t>(nb.second.at(dstRouter))};
+        // For each neighbor:
+        for (size_t i = 0; i < degree; i++) {
+          const uint32_t neighborTotalCost = distances[i * numVertices + dst].cost;
 
-        int neighborCost = static_cast<int>(nbDist);
-        int neighborTotalCost = neighborCost + static_cast<int>(originalFace.at(neighborId)->getMetric());
+          // Skip routers that would loop back
+          if (!isUsed[i] || neighborTotalCost >= GlobalRoutingGraph::INF_COST)
+            continue;
 
-        NS_ABORT_UNLESS(neighborTotalCost >= spTotalCost);
+          const uint32_t neighborCost = neighborTotalCost - neighbors[i].second;
 
-        // Skip routers that would loop back
-        if (neighborTotalCost >= static_cast<int>(get<uint16_t>(boost::WeightInf)))
-          continue;
+          NextHopType nbType;
+          if (neighborCost < spTotalCost) {
+            nbType = NextHopType::DOWNWARD;
+          }
+          else {
+            nbType = NextHopType::UPWARD;
+          }
 
-        NextHopType nbType;
-        if (neighborCost < spTotalCost) {
-          nbType = NextHopType::DOWNWARD;
-        }
-        else {
-          nbType = NextHopType::UPWARD;
+          int costDelta = static_cast<int>(neighborTotalCost - spTotalCost);
+          FibNextHop nh = {static_cast<int>(neighborTotalCost), neighbors[i].first, costDelta,
+                           nbType};
+          nodeFib.insert(static_cast<int>(dst), nh);
         }
+      } // End for all dsts
 
-        int costDelta = neighborTotalCost - spTotalCost;
-        FibNextHop nh = {neighborTotalCost, neighborId, costDelta, nbType};
-        nodeFib.insert(dstId, nh);
-      }
-
-    } // End for all dsts
-
-    nodeFib.checkFib();
-    allNodeFIB.emplace(nodeId, nodeFib);
-  } // End for all nodes
+      nodeFib.checkFib();
+    },
+    [] (VertexId, std::vector<Distance>&) {
+      // The Abstract FIB is already filled
+    });
 
   ///  4. Remove loops and Deadends ///
   removeLoops(allNodeFIB, true);
@@ -174,23 +137,30 @@ GlobalRoutingHelper::CalculateLfidRoutes()
 
   // 5. Insert from AbsFIB into real FIB!
   // For each node in the AbsFIB: Insert into real fib.
-  for (const auto& nodeEntry : allNodeFIB) {
-    int nodeId = nodeEntry.first;
-    const auto& fib = nodeEntry.second;
+  for (VertexId nodeId : sources) {
+    const auto& fib = allNodeFIB[nodeId];
+    Ptr<Node> node = graph.getNode(nodeId);
+
+    // Store mapping neighborId -> Ptr<Face>, the last one for parallel links
+    unordered_map<int, shared_ptr<Face>> faceMap;
+    graph.forEachOutEdge(nodeId, [&] (GlobalRoutingGraph::EdgeIndex, VertexId target,
+                                      const Distance& weight) {
+        faceMap[static_cast<int>(target)] = graph.getFace(weight.face);
+      });
 
     // For each destination:
-    for (const auto& dst : fib) {
-      int dstId = dst.first;
-      const auto& dstRouter = allNodeFIB.at(dstId).getGR();
+    for (VertexId dstId : sources) {
+      if (dstId == nodeId)
+        continue;
+      Ptr<GlobalRouter> dstRouter = graph.getRouter(dstId);
 
       // Each fibNexthop
-      for (const auto& nh : dst.second) {
+      for (const auto& nh : fib.getNexthops(static_cast<int>(dstId))) {
         int neighborId = nh.getNexthopId();
         int neighborTotalCost = nh.getCost();
 
         for (const auto& prefix : dstRouter->GetLocalPrefixes()) {
-          Ptr<Node> node = NodeList::GetNode(static_cast<uint32_t>(nodeId));
-          FibHelper::AddRoute(node, *prefix, faceMap.at(nodeId).at(neighborId), neighborTotalCost);
+          FibHelper::AddRoute(node, *prefix, faceMap.at(neighborId), neighborTotalCost);
         }
       }
     }
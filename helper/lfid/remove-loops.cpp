@@ -20,14 +20,13 @@
 
 #include "remove-loops.hpp"
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-#include <boost/graph/properties.hpp>
-#include <boost/property_map/property_map.hpp>
+#include <limits>
 #include <queue>
+#include <set>
 
 #include "ns3/abort.h"
 #include "ns3/ndnSIM/helper/lfid/abstract-fib.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -36,35 +35,93 @@ using std::set;
 using AllNodeFib = AbstractFib::AllNodeFib;
 
 /**
- * Fill directed graph only with edges existing in the FIB.
+ * Directed graph of the arcs existing in the FIB towards one destination.
+ *
+ * Arcs are stored per node in one flat array, and only disabled, never erased.
  */
-void
-getDigraphFromFib(DiGraph& dg, const AllNodeFib& allNodeFIB, const int dstId)
-{
+class FibDigraph {
+public:
+  static constexpr size_t NO_ARC = std::numeric_limits<size_t>::max();
 
-  // 1. Erase All Arcs:
-  dg.clear();
+  FibDigraph(const AllNodeFib& allNodeFIB, const int dstId)
+    : m_offsets(allNodeFIB.size() + 1, 0)
+    , m_visitMarks(allNodeFIB.size(), 0)
+  {
+    for (size_t nodeId = 0; nodeId < allNodeFIB.size(); nodeId++) {
+      if (static_cast<int>(nodeId) != dstId) {
+        for (const auto& fibNh : allNodeFIB[nodeId].getNexthops(dstId)) {
+          NS_ABORT_UNLESS(fibNh.getType() <= NextHopType::UPWARD);
+          m_targets.push_back(fibNh.getNexthopId());
+        }
+      }
+      m_offsets[nodeId + 1] = m_targets.size();
+    }
+    m_isEnabled.resize(m_targets.size(), true);
+  }
 
-  // 2. Add Arcs from FIB
-  for (const auto& node : allNodeFIB) {
-    int nodeId = node.first;
-    if (dstId == nodeId) {
-      continue;
+  /**
+   * @return index of the enabled arc from \p from to \p to, or NO_ARC
+   */
+  size_t
+  findArc(int from, int to) const
+  {
+    for (size_t arc = m_offsets[from]; arc < m_offsets[from + 1]; arc++) {
+      if (m_targets[arc] == to && m_isEnabled[arc]) {
+        return arc;
+      }
     }
+    return NO_ARC;
+  }
+
+  void
+  setEnabled(size_t arc, bool isEnabled)
+  {
+    m_isEnabled[arc] = isEnabled;
+  }
 
-    for (const auto& fibNh : node.second.getNexthops(dstId)) {
-      NS_ABORT_UNLESS(fibNh.getType() <= NextHopType::UPWARD);
-      boost::add_edge(static_cast<uint64_t>(nodeId), static_cast<uint64_t>(fibNh.getNexthopId()), 1, dg);
+  /**
+   * @return whether \p to can be reached from \p from over enabled arcs (BFS)
+   */
+  bool
+  isReachable(int from, int to)
+  {
+    m_visitMark++;
+    m_queue.clear();
+    m_queue.push_back(from);
+    m_visitMarks[from] = m_visitMark;
+
+    for (size_t i = 0; i < m_queue.size(); i++) {
+      int nodeId = m_queue[i];
+      if (nodeId == to) {
+        return true;
+      }
+      for (size_t arc = m_offsets[nodeId]; arc < m_offsets[nodeId + 1]; arc++) {
+        int nhId = m_targets[arc];
+        if (m_isEnabled[arc] && m_visitMarks[nhId] != m_visitMark) {
+          m_visitMarks[nhId] = m_visitMark;
+          m_queue.push_back(nhId);
+        }
+      }
     }
+    return false;
   }
-}
+
+private:
+  std::vector<size_t> m_offsets;
+  std::vector<int> m_targets;
+  std::vector<bool> m_isEnabled;
+
+  std::vector<uint32_t> m_visitMarks;
+  uint32_t m_visitMark = 0;
+  std::vector<int> m_queue;
+};
 
 class NodePrio {
 public:
-  NodePrio(int nodeId, int remainingNh, set<FibNextHop> nhSet)
+  NodePrio(int nodeId, int remainingNh, std::vector<FibNextHop> nhSet)
     : m_nodeId{nodeId}
     , m_remainingNh{remainingNh}
-    , m_uwSet{nhSet}
+    , m_uwSet{std::move(nhSet)}
   {
     NS_ABORT_UNLESS(remainingNh > 0 && m_uwSet.size() > 0);
     NS_ABORT_UNLESS(static_cast<int>(m_uwSet.size()) < remainingNh);
@@ -96,8 +153,8 @@ public:
   FibNextHop
   popHighestCostUw()
   {
-    const FibNextHop& tmp = getHighestCostUw();
-    eraseUw(tmp);
+    FibNextHop tmp = getHighestCostUw();
+    m_uwSet.pop_back();
     return tmp;
   }
 
@@ -110,26 +167,17 @@ public:
   }
 
 private:
-  void
-  eraseUw(FibNextHop nh)
-  {
-    NS_ABORT_UNLESS(m_uwSet.size() > 0);
-    auto success = m_uwSet.erase(nh);
-    NS_ABORT_UNLESS(success == 1);
-  }
-
-  FibNextHop
+  const FibNextHop&
   getHighestCostUw() const
   {
     NS_ABORT_UNLESS(m_uwSet.size() > 0);
-    NS_ABORT_UNLESS(std::prev(m_uwSet.end()) != m_uwSet.end());
-    return *(std::prev(m_uwSet.end()));
+    return m_uwSet.back();
   }
 
 private:
   int m_nodeId;
   int m_remainingNh;
-  set<FibNextHop> m_uwSet;
+  std::vector<FibNextHop> m_uwSet; // Ordered like the FIB
 
   friend std::ostream&
   operator<<(std::ostream&, const NodePrio& node);
@@ -142,110 +190,99 @@ operator<<(std::ostream& os, const NodePrio& node)
             << ", remaining UW: " << node.getRemainingUw() << " ";
 }
 
-int
-removeLoops(AllNodeFib& allNodeFIB, bool printOutput)
-{
-  int removedLoopCounter = 0;
+struct LoopCounters {
   int upwardCounter = 0;
+  int removedLoopCounter = 0;
+};
 
-  const int NUM_NODES{static_cast<int>(allNodeFIB.size())};
-
-  // Build graph with boost graph library:
-  DiGraph dg{};
-
-  // Add all Arcs that fit into FIB. // O(n)
-  for (int dstId = 0; dstId < NUM_NODES; dstId++) {
-    // 1. Get DiGraph from Fib //
-    getDigraphFromFib(dg, allNodeFIB, dstId);
-
-    // NodeId -> set<UwNexthops>
-    std::priority_queue<NodePrio> q;
+static LoopCounters
+removeLoopsToDst(AllNodeFib& allNodeFIB, const int dstId)
+{
+  LoopCounters counters;
 
-    // 2. Put nodes in the queue, ordered by # remaining nexthops, then CostDelta // O(n^2)
-    for (const auto& node : allNodeFIB) {
-      int nodeId{node.first};
-      const AbstractFib& fib{node.second};
-      if (nodeId == dstId) {
-        continue;
-      }
+  // 1. Get DiGraph from Fib //
+  FibDigraph dg{allNodeFIB, dstId};
 
-      const auto& uwNhSet = fib.getUpwardNexthops(dstId);
-      if (!uwNhSet.empty()) {
-        upwardCounter += uwNhSet.size();
+  // NodeId -> set<UwNexthops>
+  std::priority_queue<NodePrio> q;
 
-        int fibSize{fib.numEnabledNhPerDst(dstId)};
-        // NodePrio tmpNode {nodeId, fibSize, uwNhSet};
-        q.emplace(nodeId, fibSize, uwNhSet);
-      }
+  // 2. Put nodes in the queue, ordered by # remaining nexthops, then CostDelta // O(n^2)
+  for (const AbstractFib& fib : allNodeFIB) {
+    int nodeId{fib.getNodeId()};
+    if (nodeId == dstId) {
+      continue;
     }
 
-    // 3. Iterate PriorityQueue //
-    while (!q.empty()) {
-      NodePrio node = q.top();
-      q.pop();
-
-      int nodeId = node.getId();
-      int nhId = node.popHighestCostUw().getNexthopId();
-
-      // Remove opposite of Uphill link
-      //      int arcId1 {getArcId(arcMap, nhId, nodeId)};
-      auto res = boost::edge(static_cast<uint64_t>(nhId), static_cast<uint64_t>(nodeId), dg);
+    auto uwNhSet = fib.getUpwardNexthops(dstId);
+    if (!uwNhSet.empty()) {
+      counters.upwardCounter += uwNhSet.size();
 
-      auto arc = res.first;
-      bool arcExists = res.second;
-
-      if (arcExists) {
-        boost::remove_edge(arc, dg);
-      }
-
-      // 2. Loop Check: Is the current node still reachable for the uphill nexthop?
-      // Uses BFS:
-      // bool willLoop = bfs(dg).run(dg.nodeFromId(nhId), dg.nodeFromId(nodeId)); // O(m^2n)
-
-      std::vector<int> dists(num_vertices(dg));
-
-      auto weightmap = get(boost::edge_weight, dg);
+      int fibSize{fib.numEnabledNhPerDst(dstId)};
+      q.emplace(nodeId, fibSize, std::move(uwNhSet));
+    }
+  }
 
-      const auto& x = boost::edges(dg);
-      for (auto e = x.first; e != x.second; e++) {
-        int weight = get(weightmap, *e);
-        NS_ABORT_UNLESS(weight == 1); // Only use uniform weights.
-      }
+  // 3. Iterate PriorityQueue //
+  while (!q.empty()) {
+    NodePrio node = q.top();
+    q.pop();
 
-      // TODO: Could be replaced by BFS/DFS to improve speed.
-      dijkstra_shortest_paths(dg, static_cast<uint64_t>(nhId),
-                              distance_map(
-                                boost::make_iterator_property_map(dists.begin(), get(boost::vertex_index, dg))));
+    int nodeId = node.getId();
+    int nhId = node.popHighestCostUw().getNexthopId();
 
-      bool willLoop = (dists.at(static_cast<size_t>(nodeId)) < (std::numeric_limits<int>::max() - 1));
+    // Remove opposite of Uphill link
+    size_t reverseArc = dg.findArc(nhId, nodeId);
+    if (reverseArc != FibDigraph::NO_ARC) {
+      dg.setEnabled(reverseArc, false);
+    }
 
-      // Uphill nexthop loops back to original node
-      if (willLoop) {
-        node.reduceRemainingNh();
-        removedLoopCounter++;
+    // 2. Loop Check: Is the current node still reachable for the uphill nexthop?
+    bool willLoop = dg.isReachable(nhId, nodeId);
 
-        // Erase FIB entry
-        allNodeFIB.at(node.getId()).erase(dstId, nhId);
+    // Uphill nexthop loops back to original node
+    if (willLoop) {
+      node.reduceRemainingNh();
+      counters.removedLoopCounter++;
 
-        auto res2 = boost::edge(static_cast<uint64_t>(node.getId()), static_cast<uint64_t>(nhId), dg);
-        auto arc2 = res2.first;
-        NS_ABORT_UNLESS(res.second);
+      // Erase FIB entry
+      allNodeFIB.at(nodeId).erase(dstId, nhId);
 
-        boost::remove_edge(arc2, dg);
-      }
+      size_t arc = dg.findArc(nodeId, nhId);
+      NS_ABORT_UNLESS(arc != FibDigraph::NO_ARC);
+      dg.setEnabled(arc, false);
+    }
 
-      // Add opposite of UW link back:
-      if (arcExists) {
-        boost::add_edge(static_cast<uint64_t>(nhId), static_cast<uint64_t>(nodeId), 1, dg);
-      }
+    // Add opposite of UW link back:
+    if (reverseArc != FibDigraph::NO_ARC) {
+      dg.setEnabled(reverseArc, true);
+    }
 
-      // If not has further UW nexthops: Requeue.
-      if (node.getRemainingUw() > 0) {
-        q.push(node);
-      }
+    // If not has further UW nexthops: Requeue.
+    if (node.getRemainingUw() > 0) {
+      q.push(std::move(node));
     }
   }
 
+  return counters;
+}
+
+int
+removeLoops(AllNodeFib& allNodeFIB, bool printOutput)
+{
+  LoopCounters total;
+
+  // Each destination only changes its own nexthops
+  GlobalRoutingGraph::forEachIndex<LoopCounters>(allNodeFIB.size(),
+    [&](size_t dstId, LoopCounters& counters) {
+      counters = removeLoopsToDst(allNodeFIB, static_cast<int>(dstId));
+    },
+    [&](size_t, LoopCounters& counters) {
+      total.upwardCounter += counters.upwardCounter;
+      total.removedLoopCounter += counters.removedLoopCounter;
+    });
+
+  const int upwardCounter = total.upwardCounter;
+  const int removedLoopCounter = total.removedLoopCounter;
   if (printOutput) {
     std::cout << "Found " << upwardCounter << " UW nexthops, Removed " << removedLoopCounter
               << " Looping UwNhs, Remaining: " << upwardCounter - removedLoopCounter << " NHs\n";
@@ -255,79 +292,75 @@ removeLoops(AllNodeFib& allNodeFIB, bool printOutput)
   return removedLoopCounter;
 }
 
-int
-removeDeadEnds(AllNodeFib& allNodeFIB, bool printOutput)
+struct DeadEndCounters {
+  int checkedUwCounter = 0;
+  int uwCounter = 0;
+  int totalCounter = 0;
+  int removedDeadendCounter = 0;
+};
+
+static DeadEndCounters
+removeDeadEndsToDst(AllNodeFib& allNodeFIB, const int dstId)
 {
-  int NUM_NODES{static_cast<int>(allNodeFIB.size())};
-  int checkedUwCounter{0};
-  int uwCounter{0};
-  int totalCounter{0};
-  int removedDeadendCounter{0};
-
-  for (int dstId = 0; dstId < NUM_NODES; dstId++) {
-    // NodeId -> FibNexthops (Order important)
-    set<std::pair<int, FibNextHop>> nhSet;
-
-    // 1. Put all uwNexthops in set<NodeId, FibNexhtop>:
-    for (const auto& node : allNodeFIB) {
-      int nodeId{node.first};
-      if (nodeId == dstId) {
-        continue;
-      }
+  DeadEndCounters counters;
 
-      totalCounter += node.second.getNexthops(dstId).size();
+  // NodeId -> FibNexthops (Order important)
+  set<std::pair<int, FibNextHop>> nhSet;
 
-      const auto& uwNhSet = node.second.getUpwardNexthops(dstId);
-      uwCounter += uwNhSet.size();
-      for (const FibNextHop& fibNh : uwNhSet) {
+  // 1. Put all uwNexthops in set<NodeId, FibNexhtop>:
+  for (const AbstractFib& fib : allNodeFIB) {
+    int nodeId{fib.getNodeId()};
+    if (nodeId == dstId) {
+      continue;
+    }
+
+    for (const FibNextHop& fibNh : fib.getNexthops(dstId)) {
+      counters.totalCounter++;
+      if (fibNh.getType() == NextHopType::UPWARD) {
+        counters.uwCounter++;
         nhSet.emplace(nodeId, fibNh);
       }
     }
+  }
 
-    // FibNexthops ordered by (costDelta, cost, nhId).
-    // Start with nexthop with highest cost:
-    while (!nhSet.empty()) {
-      checkedUwCounter++;
-
-      // Pop from queue:
-      const auto& nhPair = nhSet.begin();
-      NS_ABORT_UNLESS(nhPair != nhSet.end());
-      nhSet.erase(nhPair);
-
-      int nodeId = nhPair->first;
-      const FibNextHop& nh = nhPair->second;
-      AbstractFib& fib = allNodeFIB.at(nodeId);
+  // FibNexthops ordered by (costDelta, cost, nhId).
+  // Start with nexthop with highest cost:
+  while (!nhSet.empty()) {
+    counters.checkedUwCounter++;
 
-      if (nh.getNexthopId() == dstId) {
-        continue;
-      }
+    // Pop from queue:
+    const auto nhPair = *nhSet.begin();
+    nhSet.erase(nhSet.begin());
 
-      int reverseEntries{allNodeFIB.at(nh.getNexthopId()).numEnabledNhPerDst(dstId)};
+    int nodeId = nhPair.first;
+    const FibNextHop& nh = nhPair.second;
+    AbstractFib& fib = allNodeFIB.at(nodeId);
 
-      // Must have at least one FIB entry.
-      NS_ABORT_UNLESS(reverseEntries > 0);
+    if (nh.getNexthopId() == dstId) {
+      continue;
+    }
 
-      // If it has exactly 1 entry -> Is downward back through the upward nexthop!
-      // Higher O-Complexity below:
-      if (reverseEntries <= 1) {
-        removedDeadendCounter++;
+    int reverseEntries{allNodeFIB.at(nh.getNexthopId()).numEnabledNhPerDst(dstId)};
 
-        // Erase NhEntry from FIB:
-        fib.erase(dstId, nh.getNexthopId());
+    // Must have at least one FIB entry.
+    NS_ABORT_UNLESS(reverseEntries > 0);
 
-        // Push into Queue: All NhEntries that lead to m_nodeId!
-        const auto& nexthops = fib.getNexthops(dstId);
+    // If it has exactly 1 entry -> Is downward back through the upward nexthop!
+    // Higher O-Complexity below:
+    if (reverseEntries <= 1) {
+      counters.removedDeadendCounter++;
 
-        for (const auto& ownNhs : nexthops) {
-          if (ownNhs.getType() == NextHopType::DOWNWARD && ownNhs.getNexthopId() != dstId) {
-            const auto& reverseNh = allNodeFIB.at(ownNhs.getNexthopId()).getNexthops(dstId);
+      // Erase NhEntry from FIB:
+      fib.erase(dstId, nh.getNexthopId());
 
-            for (const auto& y : reverseNh) {
-              if (y.getNexthopId() == nodeId) {
-                NS_ABORT_UNLESS(y.getType() == NextHopType::UPWARD);
-                nhSet.emplace(ownNhs.getNexthopId(), y);
-                break;
-              }
+      // Push into Queue: All NhEntries that lead to m_nodeId!
+      for (const auto& ownNhs : fib.getNexthops(dstId)) {
+        if (ownNhs.getType() == NextHopType::DOWNWARD && ownNhs.getNexthopId() != dstId) {
+          for (const auto& y : allNodeFIB.at(ownNhs.getNexthopId()).getNexthops(dstId)) {
+            if (y.getNexthopId() == nodeId) {
+              NS_ABORT_UNLESS(y.getType() == NextHopType::UPWARD);
+              nhSet.emplace(ownNhs.getNexthopId(), y);
+              break;
             }
           }
         }
@@ -335,13 +368,33 @@ removeDeadEnds(AllNodeFib& allNodeFIB, bool printOutput)
     }
   }
 
+  return counters;
+}
+
+int
+removeDeadEnds(AllNodeFib& allNodeFIB, bool printOutput)
+{
+  DeadEndCounters total;
+
+  GlobalRoutingGraph::forEachIndex<DeadEndCounters>(allNodeFIB.size(),
+    [&](size_t dstId, DeadEndCounters& counters) {
+      counters = removeDeadEndsToDst(allNodeFIB, static_cast<int>(dstId));
+    },
+    [&](size_t, DeadEndCounters& counters) {
+      total.checkedUwCounter += counters.checkedUwCounter;
+      total.uwCounter += counters.uwCounter;
+      total.totalCounter += counters.totalCounter;
+      total.removedDeadendCounter += counters.removedDeadendCounter;
+    });
+
   if (printOutput) {
-    std::cout << "Checked " << checkedUwCounter << " Upward NHs, Removed " << removedDeadendCounter
-              << " Deadend UwNhs, Remaining: " << uwCounter - removedDeadendCounter << " UW NHs, "
-              << totalCounter - removedDeadendCounter << " total nexthops\n";
+    std::cout << "Checked " << total.checkedUwCounter << " Upward NHs, Removed "
+              << total.removedDeadendCounter << " Deadend UwNhs, Remaining: "
+              << total.uwCounter - total.removedDeadendCounter << " UW NHs, "
+              << total.totalCounter - total.removedDeadendCounter << " total nexthops\n";
   }
 
-  return removedDeadendCounter;
+  return total.removedDeadendCounter;
 }
 
 } // namespace ndn
@@ -21,25 +21,29 @@
 #ifndef LFID_REMOVE_LOOPS_H
 #define LFID_REMOVE_LOOPS_H
 
-#include <boost/graph/adjacency_list.hpp>
-
 #include "ns3/ndnSIM/helper/lfid/abstract-fib.hpp"
 
 namespace ns3 {
 namespace ndn {
 
-// No Vertex Property
-// Edge Property: Weight.
-using DiGraph =
-  boost::adjacency_list<boost::listS, boost::vecS, boost::bidirectionalS, boost::no_property,
-                        boost::property<boost::edge_weight_t, int>>;
-
-void
-getDigraphFromFib(DiGraph& dg, const AbstractFib::AllNodeFib& allNodeFIB, const int dstId);
-
+/**
+ * Remove upward nexthops that would cause loops.
+ *
+ * Destinations are independent of each other and processed in parallel, on the number of
+ * threads set with GlobalRoutingHelper::SetNThreads().
+ *
+ * @return number of removed nexthops
+ */
 int
 removeLoops(AbstractFib::AllNodeFib& allNodeFIB, bool printOutput = true);
 
+/**
+ * Remove upward nexthops that lead to dead ends, i.e., to nodes whose only nexthop leads back.
+ *
+ * Destinations are processed in parallel, as in removeLoops().
+ *
+ * @return number of removed nexthops
+ */
 int
 removeDeadEnds(AbstractFib::AllNodeFib& allNodeFIB, bool printOutput = true);
 
@@ -39,6 +39,7 @@
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/fw/forwarder.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
@@ -47,9 +48,47 @@ namespace ndn {
 
 NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 
+static bool g_isDirectMode = false;
+
+void
+FibHelper::SetDirectMode(bool isEnabled)
+{
+  g_isDirectMode = isEnabled;
+}
+
+bool
+FibHelper::IsDirect(Ptr<L3Protocol> ndn)
+{
+  // lightweight nodes have no FIB manager to send commands to
+  return g_isDirectMode || ndn->isLightweight();
+}
+
+void
+FibHelper::AddNextHopDirect(Ptr<L3Protocol> ndn, const Name& prefix, Face& face, uint64_t cost)
+{
+  if (prefix.size() > nfd::Fib::getMaxDepth()) {
+    NS_LOG_DEBUG("Cannot add next hop for " << prefix << ": prefix is too long");
+    return;
+  }
+
+  nfd::Fib& fib = ndn->getForwarder()->getFib();
+  fib.addOrUpdateNextHop(*fib.insert(prefix).first, face, cost);
+}
+
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (IsDirect(l3protocol)) {
+    nfd::Face* face = l3protocol->getFaceTable().get(parameters.getFaceId());
+    if (face == nullptr) {
+      NS_LOG_DEBUG("Cannot add next hop: face " << parameters.getFaceId() << " does not exist");
+      return;
+    }
+    AddNextHopDirect(l3protocol, parameters.getName(), *face, parameters.getCost());
+    return;
+  }
+
   Block encodedParameters(parameters.wireEncode());
 
   Name commandName("/localhost/nfd/fib");
@@ -60,13 +99,23 @@ FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
   command->setCanBePrefix(false);
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
 void
 FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (IsDirect(l3protocol)) {
+    nfd::Face* face = l3protocol->getFaceTable().get(parameters.getFaceId());
+    nfd::Fib& fib = l3protocol->getForwarder()->getFib();
+    nfd::fib::Entry* entry = fib.findExactMatch(parameters.getName());
+    if (face != nullptr && entry != nullptr) {
+      fib.removeNextHop(*entry, *face);
+    }
+    return;
+  }
+
   Block encodedParameters(parameters.wireEncode());
 
   Name commandName("/localhost/nfd/fib");
@@ -77,10 +126,29 @@ FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
   command->setCanBePrefix(false);
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
+void
+FibHelper::AddRoutes(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  if (!IsDirect(ndn)) {
+    for (const auto& route : routes) {
+      AddRoute(node, route.prefix, route.face, route.metric);
+    }
+    return;
+  }
+
+  for (const auto& route : routes) {
+    NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << route.prefix << " via "
+                     << route.face->getLocalUri() << " metric " << route.metric);
+    AddNextHopDirect(ndn, route.prefix, *route.face, route.metric);
+  }
+}
+
 void
 FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, int32_t metric)
 {
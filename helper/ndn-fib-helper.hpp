@@ -31,6 +31,8 @@
 namespace ns3 {
 namespace ndn {
 
+class L3Protocol;
+
 using ::ndn::nfd::ControlParameters;
 
 /**
@@ -40,9 +42,44 @@ using ::ndn::nfd::ControlParameters;
  * The FIB helper interacts with the FIB manager of NFD by sending special Interest
  * commands to the manager in order to add/remove a next hop from FIB entries or add
  * routes to the FIB manually (manual configuration of FIB).
+ *
+ * In direct mode, and on lightweight nodes, the helper instead writes next hops into
+ * NFD's FIB in-process, without signing and processing a command Interest per route.
  */
 class FibHelper {
 public:
+  /**
+   * @brief Forwarding entry to be added to FIB
+   */
+  struct Route
+  {
+    Name prefix;
+    shared_ptr<Face> face;
+    int32_t metric;
+  };
+
+  /**
+   * @brief Write routes directly into NFD's FIB instead of sending FIB management commands
+   *
+   * Direct updates take effect immediately, while commands are processed by the FIB manager
+   * in simulated time.  Both bypass the RIB, so the resulting FIB is the same.  Disabled by
+   * default.
+   */
+  static void
+  SetDirectMode(bool isEnabled);
+
+  /**
+   * \brief Add a batch of forwarding entries to the FIB of a node
+   *
+   * In direct mode, or if the node is lightweight, all routes are written to the FIB at once.
+   * Otherwise, this is equivalent to calling AddRoute for each of them.
+   *
+   * \param node   Node
+   * \param routes Forwarding entries, the faces of which belong to \p node
+   */
+  static void
+  AddRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+
   /**
    * \brief Add forwarding entry to FIB
    *
@@ -154,6 +191,12 @@ private:
   static void
   GenerateCommand(Interest& interest);
 
+  static bool
+  IsDirect(Ptr<L3Protocol> ndn);
+
+  static void
+  AddNextHopDirect(Ptr<L3Protocol> ndn, const Name& prefix, Face& face, uint64_t cost);
+
   static void
   AddNextHop(const ControlParameters& parameters, Ptr<Node> node);
 
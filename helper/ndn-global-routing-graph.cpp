@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-graph.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/channel.h"
+#include "ns3/channel-list.h"
+#include "ns3/node-list.h"
+
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+namespace ns3 {
+namespace ndn {
+
+const GlobalRoutingGraph::VertexId GlobalRoutingGraph::NO_VERTEX =
+  std::numeric_limits<GlobalRoutingGraph::VertexId>::max();
+
+const GlobalRoutingGraph::FaceIndex GlobalRoutingGraph::NO_FACE =
+  std::numeric_limits<GlobalRoutingGraph::FaceIndex>::max();
+
+const uint32_t GlobalRoutingGraph::INF_COST = std::numeric_limits<uint16_t>::max();
+
+static size_t g_nThreads = 0;
+
+namespace {
+
+// same semantics as boost::WeightCompare and boost::WeightCombine
+struct DistanceCompare {
+  bool
+  operator()(const GlobalRoutingGraph::Distance& a, const GlobalRoutingGraph::Distance& b) const
+  {
+    return a.cost < b.cost;
+  }
+};
+
+struct DistanceCombine {
+  GlobalRoutingGraph::Distance
+  operator()(const GlobalRoutingGraph::Distance& a, const GlobalRoutingGraph::Distance& b) const
+  {
+    return {a.face == GlobalRoutingGraph::NO_FACE ? b.face : a.face, a.cost + b.cost};
+  }
+};
+
+} // namespace
+
+GlobalRoutingGraph::GlobalRoutingGraph()
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr != nullptr) {
+      m_routers.push_back(gr);
+      m_nodes.push_back(*node);
+    }
+  }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr != nullptr) {
+      m_routers.push_back(gr);
+      m_nodes.push_back(nullptr);
+    }
+  }
+
+  for (VertexId v = 0; v < m_routers.size(); ++v) {
+    m_vertexIds.emplace(PeekPointer(m_routers[v]), v);
+  }
+
+  // edges are added source by source, so they are already sorted
+  std::unordered_map<const Face*, FaceIndex> faceIndices;
+  std::vector<std::pair<VertexId, VertexId>> edges;
+  std::vector<Edge> edgeWeights;
+  for (VertexId v = 0; v < m_routers.size(); ++v) {
+    for (const auto& incidency : m_routers[v]->GetIncidencies()) {
+      auto target = m_vertexIds.find(PeekPointer(std::get<2>(incidency)));
+      NS_ASSERT_MSG(target != m_vertexIds.end(), "GlobalRouter is not installed on a neighbor");
+
+      Distance weight{NO_FACE, 0};
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      if (face != nullptr) {
+        auto index = faceIndices.emplace(face.get(), m_faces.size());
+        if (index.second) {
+          m_faces.push_back(face);
+        }
+        weight = {index.first->second, static_cast<uint16_t>(face->getMetric())};
+      }
+
+      edges.emplace_back(v, target->second);
+      edgeWeights.push_back({weight});
+    }
+  }
+  m_csr = Csr(boost::edges_are_sorted, edges.begin(), edges.end(), edgeWeights.begin(),
+              m_routers.size());
+
+  // index of in-edges, used to repair shortest path trees
+  m_edgeSources.resize(edges.size());
+  m_inEdgeOffsets.assign(m_routers.size() + 1, 0);
+  for (EdgeIndex e = 0; e < edges.size(); ++e) {
+    m_edgeSources[e] = edges[e].first;
+    ++m_inEdgeOffsets[edges[e].second + 1];
+  }
+  std::partial_sum(m_inEdgeOffsets.begin(), m_inEdgeOffsets.end(), m_inEdgeOffsets.begin());
+  m_inEdges.resize(edges.size());
+  std::vector<size_t> next(m_inEdgeOffsets.begin(), m_inEdgeOffsets.end() - 1);
+  for (EdgeIndex e = 0; e < edges.size(); ++e) {
+    m_inEdges[next[edges[e].second]++] = e;
+  }
+
+  m_routeOrder.resize(m_routers.size());
+  std::iota(m_routeOrder.begin(), m_routeOrder.end(), 0);
+  std::sort(m_routeOrder.begin(), m_routeOrder.end(), [this] (VertexId a, VertexId b) {
+      return m_routers[a] < m_routers[b];
+    });
+}
+
+GlobalRoutingGraph::VertexId
+GlobalRoutingGraph::findVertex(Ptr<GlobalRouter> router) const
+{
+  auto i = m_vertexIds.find(PeekPointer(router));
+  return i != m_vertexIds.end() ? i->second : NO_VERTEX;
+}
+
+std::vector<GlobalRoutingGraph::EdgeIndex>
+GlobalRoutingGraph::findEdges(VertexId u, VertexId v) const
+{
+  std::vector<EdgeIndex> edges;
+  forEachOutEdge(u, [&] (EdgeIndex e, VertexId target, const Distance&) {
+      if (target == v) {
+        edges.push_back(e);
+      }
+    });
+  return edges;
+}
+
+GlobalRoutingGraph::FaceIndex
+GlobalRoutingGraph::getOutFace(VertexId source, size_t i) const
+{
+  auto edge = *std::next(boost::out_edges(source, m_csr).first, i);
+  return m_csr[edge].weight.face;
+}
+
+void
+GlobalRoutingGraph::computeShortestPaths(VertexId source, std::vector<Distance>& distances) const
+{
+  distances.resize(getNVertices());
+
+  boost::dijkstra_shortest_paths(m_csr, source,
+                                 boost::weight_map(boost::get(&Edge::weight, m_csr))
+                                   .distance_map(boost::make_iterator_property_map(
+                                     distances.begin(), boost::get(boost::vertex_index, m_csr)))
+                                   .distance_inf(Distance{NO_FACE, INF_COST})
+                                   .distance_zero(Distance{NO_FACE, 0})
+                                   .distance_compare(DistanceCompare())
+                                   .distance_combine(DistanceCombine()));
+}
+
+void
+GlobalRoutingGraph::computeShortestPaths(VertexId source, std::vector<Distance>& distances,
+                                         std::vector<VertexId>& parents) const
+{
+  distances.resize(getNVertices());
+  parents.resize(getNVertices());
+
+  auto index = boost::get(boost::vertex_index, m_csr);
+  boost::dijkstra_shortest_paths(m_csr, source,
+                                 boost::weight_map(boost::get(&Edge::weight, m_csr))
+                                   .predecessor_map(boost::make_iterator_property_map(
+                                     parents.begin(), index))
+                                   .distance_map(boost::make_iterator_property_map(
+                                     distances.begin(), index))
+                                   .distance_inf(Distance{NO_FACE, INF_COST})
+                                   .distance_zero(Distance{NO_FACE, 0})
+                                   .distance_compare(DistanceCompare())
+                                   .distance_combine(DistanceCombine()));
+
+  // the predecessor of the source and of unreachable vertices is the vertex itself
+  for (VertexId v = 0; v < parents.size(); ++v) {
+    if (distances[v].face == NO_FACE) {
+      parents[v] = NO_VERTEX;
+    }
+  }
+}
+
+size_t
+GlobalRoutingGraph::computeFirstHopPaths(VertexId source, std::vector<Distance>& distances) const
+{
+  const size_t nVertices = getNVertices();
+  const size_t degree = boost::out_degree(source, m_csr);
+  distances.assign(degree * nVertices, Distance{NO_FACE, INF_COST});
+
+  // Dijkstra over (first out-edge, vertex) labels, identified as in the distances vector
+  using QueueItem = std::pair<uint32_t, size_t>;
+  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+
+  size_t i = 0;
+  for (auto edge : boost::make_iterator_range(boost::out_edges(source, m_csr))) {
+    size_t label = i * nVertices + boost::target(edge, m_csr);
+    const Distance& weight = m_csr[edge].weight;
+    if (weight.cost < distances[label].cost) {
+      distances[label] = weight;
+      queue.emplace(weight.cost, label);
+    }
+    ++i;
+  }
+
+  while (!queue.empty()) {
+    QueueItem item = queue.top();
+    queue.pop();
+
+    const size_t label = item.second;
+    const Distance distance = distances[label];
+    if (item.first > distance.cost) {
+      continue; // stale item
+    }
+
+    const size_t offset = label - label % nVertices;
+    const VertexId u = label % nVertices;
+    for (auto edge : boost::make_iterator_range(boost::out_edges(u, m_csr))) {
+      VertexId v = boost::target(edge, m_csr);
+      if (v == source) {
+        continue;
+      }
+
+      Distance& next = distances[offset + v];
+      uint32_t cost = distance.cost + m_csr[edge].weight.cost;
+      if (cost < next.cost) {
+        next = {distance.face, cost};
+        queue.emplace(cost, offset + v);
+      }
+    }
+  }
+
+  return degree;
+}
+
+void
+GlobalRoutingGraph::setNThreads(size_t nThreads)
+{
+  g_nThreads = nThreads;
+}
+
+size_t
+GlobalRoutingGraph::getNThreads()
+{
+  if (g_nThreads != 0) {
+    return g_nThreads;
+  }
+  return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,326 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GLOBAL_ROUTING_GRAPH_H
+#define NDN_GLOBAL_ROUTING_GRAPH_H
+
+/// @cond include_hidden
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+
+#include "ns3/node.h"
+
+#include <boost/graph/compressed_sparse_row_graph.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Snapshot of the GlobalRouter graph for route calculation
+ *
+ * Vertices are the GlobalRouters of nodes (in NodeList order) followed by those of channels
+ * (in ChannelList order), with dense IDs.  Edges are stored in compressed sparse row form, in
+ * the order of GlobalRouter::GetIncidencies(), and weighted with the face metric at the time
+ * of the snapshot.  As vertices and edges are visited in the same order as in
+ * boost::NdnGlobalRouterGraph, shortest paths, including the choice among paths of equal
+ * cost, are the same.
+ *
+ * Shortest path calculations only read the snapshot, so they can run in parallel.
+ */
+class GlobalRoutingGraph : boost::noncopyable {
+public:
+  using VertexId = uint32_t;
+  using FaceIndex = uint32_t;
+  using EdgeIndex = uint32_t;
+
+  static const VertexId NO_VERTEX;
+  static const FaceIndex NO_FACE;
+
+  /**
+   * @brief Cost of unreachable vertices; paths of this or higher cost are never used
+   */
+  static const uint32_t INF_COST;
+
+  /**
+   * @brief Cost of the shortest path to a vertex, and the face of its first hop
+   */
+  struct Distance {
+    FaceIndex face;
+    uint32_t cost;
+  };
+
+  /**
+   * @brief Take a snapshot of all GlobalRouters and their incidencies
+   */
+  GlobalRoutingGraph();
+
+  size_t
+  getNVertices() const
+  {
+    return m_routers.size();
+  }
+
+  Ptr<GlobalRouter>
+  getRouter(VertexId v) const
+  {
+    return m_routers[v];
+  }
+
+  /**
+   * @return node of the vertex, or nullptr if the vertex is a channel
+   */
+  Ptr<Node>
+  getNode(VertexId v) const
+  {
+    return m_nodes[v];
+  }
+
+  const shared_ptr<Face>&
+  getFace(FaceIndex i) const
+  {
+    return m_faces[i];
+  }
+
+  /**
+   * @return vertex of \p router, or NO_VERTEX if it is not part of the snapshot
+   */
+  VertexId
+  findVertex(Ptr<GlobalRouter> router) const;
+
+  /**
+   * @brief Get vertices in the order of their Ptr<GlobalRouter>
+   *
+   * Routes are installed in this order, which is that of boost::DistancesMap.
+   */
+  const std::vector<VertexId>&
+  getRouteOrder() const
+  {
+    return m_routeOrder;
+  }
+
+  /**
+   * @brief Calculate shortest paths from \p source to all vertices
+   * @param[out] distances distance of every vertex; unreachable vertices have NO_FACE
+   */
+  void
+  computeShortestPaths(VertexId source, std::vector<Distance>& distances) const;
+
+  /**
+   * @brief Calculate the shortest path tree of \p source
+   * @param[out] distances distance of every vertex; unreachable vertices have NO_FACE
+   * @param[out] parents parent of every vertex in the tree; NO_VERTEX for \p source and
+   *                     unreachable vertices
+   */
+  void
+  computeShortestPaths(VertexId source, std::vector<Distance>& distances,
+                       std::vector<VertexId>& parents) const;
+
+  /**
+   * @brief Calculate, for each out-edge of \p source, shortest paths that start with it
+   *
+   * This is equivalent to calculating shortest paths with all other out-edges of \p source
+   * disabled, for every out-edge in turn, but takes a single pass.
+   *
+   * @param[out] distances distances of paths starting with the i-th out-edge of \p source,
+   *                       at offset i * getNVertices()
+   * @return out-degree of \p source
+   */
+  size_t
+  computeFirstHopPaths(VertexId source, std::vector<Distance>& distances) const;
+
+  /**
+   * @brief Get the face of the i-th out-edge of \p source
+   */
+  FaceIndex
+  getOutFace(VertexId source, size_t i) const;
+
+  /**
+   * @brief Get the edges from \p u to \p v
+   */
+  std::vector<EdgeIndex>
+  findEdges(VertexId u, VertexId v) const;
+
+  VertexId
+  getEdgeSource(EdgeIndex e) const
+  {
+    return m_edgeSources[e];
+  }
+
+  VertexId
+  getEdgeTarget(EdgeIndex e) const
+  {
+    return boost::target(Csr::edge_descriptor(m_edgeSources[e], e), m_csr);
+  }
+
+  /**
+   * @return face and cost of the edge; the face is NO_FACE for edges that start at a channel
+   */
+  const Distance&
+  getEdgeWeight(EdgeIndex e) const
+  {
+    return m_csr[Csr::edge_descriptor(m_edgeSources[e], e)].weight;
+  }
+
+  /**
+   * @brief Change the cost of an edge, e.g., to INF_COST when its link fails
+   *
+   * This must not be called while shortest paths are calculated.
+   */
+  void
+  setEdgeCost(EdgeIndex e, uint32_t cost)
+  {
+    m_csr[Csr::edge_descriptor(m_edgeSources[e], e)].weight.cost = cost;
+  }
+
+  /**
+   * @brief Call \p f(e, v, weight) for every edge e from \p u to v
+   */
+  template<typename F>
+  void
+  forEachOutEdge(VertexId u, const F& f) const
+  {
+    for (auto edge : boost::make_iterator_range(boost::out_edges(u, m_csr))) {
+      f(boost::get(boost::edge_index, m_csr, edge), boost::target(edge, m_csr), m_csr[edge].weight);
+    }
+  }
+
+  /**
+   * @brief Call \p f(e, u, weight) for every edge e from u to \p v
+   */
+  template<typename F>
+  void
+  forEachInEdge(VertexId v, const F& f) const
+  {
+    for (size_t i = m_inEdgeOffsets[v]; i < m_inEdgeOffsets[v + 1]; ++i) {
+      EdgeIndex e = m_inEdges[i];
+      f(e, m_edgeSources[e], getEdgeWeight(e));
+    }
+  }
+
+  /**
+   * @brief Run \p compute for each of \p sources on a pool of threads, then \p apply in order
+   *
+   * Sources are processed in blocks, so that only the results of one block are kept in memory.
+   * \p compute must only read the graph; \p apply runs on the calling thread.
+   */
+  template<typename Result>
+  void
+  forEachSource(const std::vector<VertexId>& sources,
+                const std::function<void(VertexId, Result&)>& compute,
+                const std::function<void(VertexId, Result&)>& apply) const;
+
+  /**
+   * @brief Run \p compute for indices 0 to \p n - 1 on a pool of threads, then \p apply in order
+   *
+   * Indices are handed out one by one, so that threads with cheaper items take more of them.
+   * Items are processed in blocks as in forEachSource().
+   */
+  template<typename Result>
+  static void
+  forEachIndex(size_t n, const std::function<void(size_t, Result&)>& compute,
+               const std::function<void(size_t, Result&)>& apply);
+
+  /**
+   * @brief Set the number of threads used to calculate routes (0: number of hardware threads)
+   */
+  static void
+  setNThreads(size_t nThreads);
+
+  static size_t
+  getNThreads();
+
+private:
+  struct Edge {
+    Distance weight;
+  };
+
+  using Csr = boost::compressed_sparse_row_graph<boost::directedS, boost::no_property, Edge,
+                                                 boost::no_property, VertexId, EdgeIndex>;
+
+  std::vector<Ptr<GlobalRouter>> m_routers;
+  std::vector<Ptr<Node>> m_nodes;
+  std::vector<shared_ptr<Face>> m_faces;
+  std::vector<VertexId> m_routeOrder;
+  std::unordered_map<const GlobalRouter*, VertexId> m_vertexIds;
+  Csr m_csr;
+
+  std::vector<VertexId> m_edgeSources;
+  std::vector<size_t> m_inEdgeOffsets;
+  std::vector<EdgeIndex> m_inEdges;
+};
+
+template<typename Result>
+void
+GlobalRoutingGraph::forEachSource(const std::vector<VertexId>& sources,
+                                  const std::function<void(VertexId, Result&)>& compute,
+                                  const std::function<void(VertexId, Result&)>& apply) const
+{
+  forEachIndex<Result>(sources.size(),
+                       [&] (size_t i, Result& result) { compute(sources[i], result); },
+                       [&] (size_t i, Result& result) { apply(sources[i], result); });
+}
+
+template<typename Result>
+void
+GlobalRoutingGraph::forEachIndex(size_t n, const std::function<void(size_t, Result&)>& compute,
+                                 const std::function<void(size_t, Result&)>& apply)
+{
+  const size_t nThreads = std::min(getNThreads(), std::max<size_t>(n, 1));
+  const size_t blockSize = nThreads * 16;
+  std::vector<Result> results(std::min(blockSize, n));
+
+  for (size_t blockBegin = 0; blockBegin < n; blockBegin += blockSize) {
+    const size_t blockEnd = std::min(blockBegin + blockSize, n);
+
+    std::atomic<size_t> next(blockBegin);
+    auto worker = [&] {
+      for (size_t i = next++; i < blockEnd; i = next++) {
+        compute(i, results[i - blockBegin]);
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nThreads; ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (size_t i = blockBegin; i < blockEnd; ++i) {
+      apply(i, results[i - blockBegin]);
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
+
+/// @endcond
+
+#endif // NDN_GLOBAL_ROUTING_GRAPH_H
@@ -46,15 +46,17 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/simulator.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
 
+#include <map>
+#include <set>
 #include <unordered_map>
 
-#include "boost-graph-ndn-global-routing-helper.hpp"
+#include "ndn-global-routing-graph.hpp"
+#include "ndn-global-routing-trees.hpp"
 
 #include <math.h>
 
@@ -63,6 +65,134 @@ NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 namespace ns3 {
 namespace ndn {
 
+/**
+ * @brief Get the vertices of all nodes with GlobalRouter, in NodeList order
+ */
+static std::vector<GlobalRoutingGraph::VertexId>
+getSources(const GlobalRoutingGraph& graph)
+{
+  std::vector<GlobalRoutingGraph::VertexId> sources;
+  for (GlobalRoutingGraph::VertexId v = 0; v < graph.getNVertices(); ++v) {
+    if (graph.getNode(v) != nullptr) {
+      sources.push_back(v);
+    }
+  }
+  return sources;
+}
+
+/**
+ * @brief Install routes from \p source to the prefixes of all reachable vertices
+ */
+static void
+installRoutes(const GlobalRoutingGraph& graph, GlobalRoutingGraph::VertexId source,
+              const std::vector<GlobalRoutingGraph::Distance>& distances)
+{
+  Ptr<Node> node = graph.getNode(source);
+  NS_LOG_DEBUG("Reachability from Node: " << node->GetId());
+
+  std::vector<FibHelper::Route> routes;
+  for (auto v : graph.getRouteOrder()) {
+    const GlobalRoutingGraph::Distance& distance = distances[v];
+    if (v == source || distance.face == GlobalRoutingGraph::NO_FACE) {
+      continue; // unreachable
+    }
+
+    const shared_ptr<Face>& face = graph.getFace(distance.face);
+    for (const auto& prefix : graph.getRouter(v)->GetLocalPrefixes()) {
+      NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face " << *face
+                   << " with distance " << distance.cost);
+
+      routes.push_back({*prefix, face, static_cast<int32_t>(distance.cost)});
+    }
+  }
+  FibHelper::AddRoutes(node, routes);
+}
+
+static bool g_isDynamicMode = false;
+
+/**
+ * @brief State kept by CalculateRoutes() in dynamic mode
+ */
+struct DynamicRoutes {
+  GlobalRoutingTrees trees;
+  /// prefixes of every vertex at the time of CalculateRoutes()
+  std::vector<std::vector<Name>> prefixes;
+  /// origins of every prefix, in route order
+  std::map<Name, std::vector<GlobalRoutingGraph::VertexId>> origins;
+};
+
+static unique_ptr<DynamicRoutes> g_dynamicRoutes;
+
+static void
+resetDynamicRoutes()
+{
+  g_dynamicRoutes.reset();
+}
+
+/**
+ * @brief Update FIB of \p source after distances to some vertices have changed
+ *
+ * Next hops are added, updated, or removed only for prefixes of the changed vertices, taking
+ * into account all origins of these prefixes.
+ */
+static void
+updateRoutes(GlobalRoutingGraph::VertexId source,
+             const std::vector<GlobalRoutingTrees::Change>& changes)
+{
+  const GlobalRoutingGraph& graph = g_dynamicRoutes->trees.getGraph();
+  const auto& distances = g_dynamicRoutes->trees.getTree(source).distances;
+
+  std::unordered_map<GlobalRoutingGraph::VertexId, GlobalRoutingGraph::Distance> previous;
+  std::set<Name> prefixes;
+  for (const auto& change : changes) {
+    previous.emplace(change.vertex, change.distance);
+    const auto& vertexPrefixes = g_dynamicRoutes->prefixes[change.vertex];
+    prefixes.insert(vertexPrefixes.begin(), vertexPrefixes.end());
+  }
+
+  // with several origins, the route to the last one in route order sets the cost of a face
+  auto getNextHops = [&] (const Name& prefix, bool isPrevious) {
+    std::map<GlobalRoutingGraph::FaceIndex, uint32_t> nextHops;
+    for (auto origin : g_dynamicRoutes->origins.at(prefix)) {
+      if (origin == source) {
+        continue;
+      }
+      auto i = previous.find(origin);
+      const auto& distance = isPrevious && i != previous.end() ? i->second : distances[origin];
+      if (distance.face != GlobalRoutingGraph::NO_FACE) {
+        nextHops[distance.face] = distance.cost;
+      }
+    }
+    return nextHops;
+  };
+
+  Ptr<Node> node = graph.getNode(source);
+  std::vector<FibHelper::Route> routes;
+  for (const Name& prefix : prefixes) {
+    auto oldNextHops = getNextHops(prefix, true);
+    auto newNextHops = getNextHops(prefix, false);
+
+    for (const auto& nextHop : oldNextHops) {
+      if (newNextHops.count(nextHop.first) == 0) {
+        NS_LOG_DEBUG("Node " << node->GetId() << ": prefix " << prefix
+                     << " no longer reachable via face " << *graph.getFace(nextHop.first));
+        FibHelper::RemoveRoute(node, prefix, graph.getFace(nextHop.first));
+      }
+    }
+
+    for (const auto& nextHop : newNextHops) {
+      auto old = oldNextHops.find(nextHop.first);
+      if (old == oldNextHops.end() || old->second != nextHop.second) {
+        NS_LOG_DEBUG("Node " << node->GetId() << ": prefix " << prefix << " reachable via face "
+                     << *graph.getFace(nextHop.first) << " with distance " << nextHop.second);
+        routes.push_back({prefix, graph.getFace(nextHop.first),
+                          static_cast<int32_t>(nextHop.second)});
+      }
+    }
+  }
+  FibHelper::AddRoutes(node, routes);
+}
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -217,173 +347,150 @@ GlobalRoutingHelper::AddOriginsForAll()
 void
 GlobalRoutingHelper::CalculateRoutes()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
-
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
-
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
-
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
+  using Distances = std::vector<GlobalRoutingGraph::Distance>;
+
+  if (g_isDynamicMode) {
+    // shortest path trees are kept, so that routes can be repaired by UpdateLink()
+    g_dynamicRoutes = make_unique<DynamicRoutes>();
+    Simulator::ScheduleDestroy(&resetDynamicRoutes);
+
+    const GlobalRoutingTrees& trees = g_dynamicRoutes->trees;
+    const GlobalRoutingGraph& graph = trees.getGraph();
+    g_dynamicRoutes->prefixes.resize(graph.getNVertices());
+    for (auto v : graph.getRouteOrder()) {
+      for (const auto& prefix : graph.getRouter(v)->GetLocalPrefixes()) {
+        g_dynamicRoutes->prefixes[v].push_back(*prefix);
+        g_dynamicRoutes->origins[*prefix].push_back(v);
+      }
     }
 
-    boost::DistancesMap distances;
-
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
-
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
-
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
-        }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
-
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
-        }
-      }
+    for (auto source : trees.getSources()) {
+      installRoutes(graph, source, trees.getTree(source).distances);
     }
+    return;
   }
+
+  GlobalRoutingGraph graph;
+
+  // Shortest path trees of all nodes are calculated in parallel on a snapshot of the graph,
+  // while routes are installed on the main thread, node by node in NodeList order.
+  graph.forEachSource<Distances>(getSources(graph),
+    [&graph] (GlobalRoutingGraph::VertexId source, Distances& distances) {
+      graph.computeShortestPaths(source, distances);
+    },
+    [&graph] (GlobalRoutingGraph::VertexId source, Distances& distances) {
+      installRoutes(graph, source, distances);
+    });
 }
 
 void
 GlobalRoutingHelper::CalculateAllPossibleRoutes()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
-
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
-
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
-
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
-    }
-
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
-
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
-
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
-    NS_ASSERT(l3 != 0);
-
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& nfdFace : l3->getFaceTable()) {
-      faceIds.push_back(nfdFace.getId());
-      originalMetrics[nfdFace.getId()] = nfdFace.getMetric();
-      nfdFace.setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
-    }
-
-    for (auto& faceId : faceIds) {
-      auto* face = l3->getFaceTable().get(faceId);
-      NS_ASSERT(face != nullptr);
-      auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
-      if (transport == nullptr) {
-        NS_LOG_DEBUG("Skipping non ndnSIM-specific transport face");
-        continue;
-      }
-
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
-
-      boost::DistancesMap distances;
+  using Distances = std::vector<GlobalRoutingGraph::Distance>;
+
+  GlobalRoutingGraph graph;
+  const size_t nVertices = graph.getNVertices();
+
+  // Instead of rerunning Dijkstra with only one face of the node enabled for each face in turn,
+  // shortest paths that start with each of the faces are calculated in a single pass.
+  graph.forEachSource<Distances>(getSources(graph),
+    [&graph] (GlobalRoutingGraph::VertexId source, Distances& distances) {
+      graph.computeFirstHopPaths(source, distances);
+    },
+    [&graph, nVertices] (GlobalRoutingGraph::VertexId source, Distances& distances) {
+      Ptr<Node> node = graph.getNode(source);
+      NS_LOG_DEBUG("Reachability from Node: " << node->GetId() << " ("
+                   << Names::FindName(node) << ")");
+
+      Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+      NS_ASSERT(l3 != 0);
+
+      const size_t degree = distances.size() / nVertices;
+      std::vector<FibHelper::Route> routes;
+      for (const auto& nfdFace : l3->getFaceTable()) {
+        if (dynamic_cast<NetDeviceTransport*>(nfdFace.getTransport()) == nullptr) {
+          NS_LOG_DEBUG("Skipping non ndnSIM-specific transport face");
+          continue;
+        }
+        // value std::numeric_limits<uint16_t>::max () - 1 marks disabled faces
+        if (nfdFace.getMetric() == std::numeric_limits<uint16_t>::max() - 1) {
+          continue;
+        }
 
-      NS_LOG_DEBUG("-----------");
+        for (size_t i = 0; i < degree; ++i) {
+          GlobalRoutingGraph::FaceIndex faceIndex = graph.getOutFace(source, i);
+          if (faceIndex == GlobalRoutingGraph::NO_FACE
+              || graph.getFace(faceIndex).get() != &nfdFace) {
+            continue;
+          }
 
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
+          for (auto v : graph.getRouteOrder()) {
+            const GlobalRoutingGraph::Distance& distance = distances[i * nVertices + v];
+            if (v == source || distance.cost >= GlobalRoutingGraph::INF_COST) {
+              continue; // unreachable
+            }
 
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+            for (const auto& prefix : graph.getRouter(v)->GetLocalPrefixes()) {
+              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face " << nfdFace
+                           << " with distance " << distance.cost);
 
-      for (const auto& dist : distances) {
-        if (dist.first == source)
-          continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
+              routes.push_back({*prefix, graph.getFace(faceIndex),
+                                static_cast<int32_t>(distance.cost)});
             }
           }
         }
       }
+      FibHelper::AddRoutes(node, routes);
+    });
+}
 
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
-    }
+void
+GlobalRoutingHelper::SetNThreads(size_t nThreads)
+{
+  GlobalRoutingGraph::setNThreads(nThreads);
+}
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getFaceTable().get(i.first)->setMetric(i.second);
+void
+GlobalRoutingHelper::SetDynamicMode(bool isEnabled)
+{
+  g_isDynamicMode = isEnabled;
+  if (!isEnabled) {
+    g_dynamicRoutes.reset();
+  }
+}
+
+void
+GlobalRoutingHelper::UpdateLink(Ptr<Node> node1, Ptr<Node> node2, bool isUp)
+{
+  if (g_dynamicRoutes == nullptr) {
+    NS_LOG_DEBUG("Routes were not calculated in dynamic mode, nothing to update");
+    return;
+  }
+
+  GlobalRoutingTrees& trees = g_dynamicRoutes->trees;
+  const GlobalRoutingGraph& graph = trees.getGraph();
+
+  auto v1 = graph.findVertex(node1->GetObject<GlobalRouter>());
+  auto v2 = graph.findVertex(node2->GetObject<GlobalRouter>());
+  NS_ASSERT_MSG(v1 != GlobalRoutingGraph::NO_VERTEX && v2 != GlobalRoutingGraph::NO_VERTEX,
+                "GlobalRouter is not installed on the nodes");
+
+  // edges in both directions get the current metric of their face, or are disabled
+  std::vector<std::pair<GlobalRoutingGraph::EdgeIndex, uint32_t>> costs;
+  auto addEdges = [&] (GlobalRoutingGraph::VertexId u, GlobalRoutingGraph::VertexId v) {
+    for (auto e : graph.findEdges(u, v)) {
+      const shared_ptr<Face>& face = graph.getFace(graph.getEdgeWeight(e).face);
+      costs.emplace_back(e, isUp ? static_cast<uint16_t>(face->getMetric())
+                                 : GlobalRoutingGraph::INF_COST);
     }
+  };
+  addEdges(v1, v2);
+  addEdges(v2, v1);
+  if (costs.empty()) {
+    NS_FATAL_ERROR("There is no link between the requested nodes");
   }
+
+  trees.updateEdges(costs, &updateRoutes);
 }
 
 } // namespace ndn
@@ -108,6 +108,9 @@ public:
    *
    * https://github.com/schneiderklaus/ndnSIM-routing
    *
+   * All nodes need a GlobalRouter and a name, and have to be connected with point-to-point
+   * links.
+   *
    * @sa https://named-data.net/publications/techreports/mp_routing_tech_report/
    */
   static void
@@ -124,6 +127,49 @@ public:
   static void
   CalculateAllPossibleRoutes();
 
+  /**
+   * @brief Set the number of threads used by CalculateRoutes(), CalculateLfidRoutes(), and
+   *        CalculateAllPossibleRoutes()
+   *
+   * Shortest paths from different nodes, and loop removal for different destinations of
+   * CalculateLfidRoutes(), are calculated in parallel, while routes are still installed from
+   * the main thread in NodeList order, so that results do not depend on the number of threads.
+   *
+   * @param nThreads number of threads, or 0 (default) to use all hardware threads
+   */
+  static void
+  SetNThreads(size_t nThreads);
+
+  /**
+   * @brief Enable or disable dynamic mode of CalculateRoutes()
+   *
+   * In dynamic mode, CalculateRoutes() keeps the shortest path trees of all nodes, so that
+   * UpdateLink() can repair them after a link fails, is restored, or changes its metric.
+   * This takes memory proportional to the square of the number of nodes.
+   *
+   * Only the topology and origins known at the time of CalculateRoutes() are considered.
+   */
+  static void
+  SetDynamicMode(bool isEnabled);
+
+  /**
+   * @brief Update routes after the link between two nodes has changed
+   *
+   * Only the parts of shortest path trees affected by the change are recalculated, and only
+   * the FIB next hops that differ are added, updated, or removed.  Among paths of equal cost,
+   * the chosen one may differ from what a new CalculateRoutes() would choose.
+   *
+   * Links in both directions are updated with the current metric of their faces, or disabled
+   * if \p isUp is false.  This method does nothing unless routes were calculated in dynamic
+   * mode, and it is called by LinkControlHelper::FailLink and LinkControlHelper::UpLink.
+   *
+   * @param node1 one node
+   * @param node2 another node
+   * @param isUp whether the link is up; to apply a new face metric, use true
+   */
+  static void
+  UpdateLink(Ptr<Node> node1, Ptr<Node> node2, bool isUp = true);
+
 private:
   void
   Install(Ptr<Channel> channel);
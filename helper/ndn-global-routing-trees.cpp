@@ -0,0 +1,265 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-trees.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+using Distance = GlobalRoutingGraph::Distance;
+using VertexId = GlobalRoutingGraph::VertexId;
+
+using QueueItem = std::pair<uint32_t, VertexId>;
+using Queue = std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>>;
+
+Distance
+combine(const Distance& a, const Distance& b)
+{
+  return {a.face == GlobalRoutingGraph::NO_FACE ? b.face : a.face, a.cost + b.cost};
+}
+
+bool
+isReachable(const Distance& distance)
+{
+  return distance.cost < GlobalRoutingGraph::INF_COST;
+}
+
+} // namespace
+
+GlobalRoutingTrees::GlobalRoutingTrees()
+{
+  m_treeIds.resize(m_graph.getNVertices(), std::numeric_limits<size_t>::max());
+  for (VertexId v = 0; v < m_graph.getNVertices(); ++v) {
+    if (m_graph.getNode(v) != nullptr) {
+      m_treeIds[v] = m_sources.size();
+      m_sources.push_back(v);
+    }
+  }
+  m_trees.resize(m_sources.size());
+
+  m_graph.forEachSource<Tree>(m_sources,
+    [this] (VertexId source, Tree& tree) {
+      m_graph.computeShortestPaths(source, tree.distances, tree.parents);
+    },
+    [this] (VertexId source, Tree& tree) {
+      m_trees[m_treeIds[source]] = std::move(tree);
+    });
+}
+
+void
+GlobalRoutingTrees::updateEdges(const std::vector<std::pair<EdgeIndex, uint32_t>>& costs,
+                                const std::function<void(VertexId,
+                                                         const std::vector<Change>&)>& onChange)
+{
+  std::vector<std::vector<Change>> changes(m_sources.size());
+
+  // edges are changed one by one, so that the trees are valid for the graph before each change
+  for (const auto& cost : costs) {
+    const EdgeIndex e = cost.first;
+    const Distance oldWeight = m_graph.getEdgeWeight(e);
+    if (oldWeight.cost == cost.second) {
+      continue;
+    }
+    m_graph.setEdgeCost(e, cost.second);
+    const Distance weight = m_graph.getEdgeWeight(e);
+
+    VertexId u = m_graph.getEdgeSource(e);
+    VertexId v = m_graph.getEdgeTarget(e);
+    m_graph.forEachSource<std::vector<Change>>(m_sources,
+      [&] (VertexId source, std::vector<Change>& result) {
+        result.clear();
+        Tree& tree = m_trees[m_treeIds[source]];
+        if (weight.cost > oldWeight.cost) {
+          increaseCost(tree, u, v, result);
+        }
+        else {
+          decreaseCost(source, tree, u, v, weight, result);
+        }
+      },
+      [&] (VertexId source, std::vector<Change>& result) {
+        auto& sourceChanges = changes[m_treeIds[source]];
+        sourceChanges.insert(sourceChanges.end(), result.begin(), result.end());
+      });
+  }
+
+  for (size_t i = 0; i < m_sources.size(); ++i) {
+    auto& sourceChanges = changes[i];
+    if (sourceChanges.empty()) {
+      continue;
+    }
+
+    // keep the oldest distance of every vertex, and only if the distance has really changed
+    std::stable_sort(sourceChanges.begin(), sourceChanges.end(),
+                     [] (const Change& a, const Change& b) { return a.vertex < b.vertex; });
+    sourceChanges.erase(std::unique(sourceChanges.begin(), sourceChanges.end(),
+                                    [] (const Change& a, const Change& b) {
+                                      return a.vertex == b.vertex;
+                                    }),
+                        sourceChanges.end());
+
+    const Tree& tree = m_trees[i];
+    sourceChanges.erase(std::remove_if(sourceChanges.begin(), sourceChanges.end(),
+                                       [&tree] (const Change& change) {
+                                         const Distance& distance = tree.distances[change.vertex];
+                                         return distance.face == change.distance.face
+                                                && distance.cost == change.distance.cost;
+                                       }),
+                        sourceChanges.end());
+
+    if (!sourceChanges.empty()) {
+      onChange(m_sources[i], sourceChanges);
+    }
+  }
+}
+
+void
+GlobalRoutingTrees::increaseCost(Tree& tree, VertexId u, VertexId v,
+                                 std::vector<Change>& changes) const
+{
+  if (tree.parents[v] != u) {
+    return; // not a tree edge, so no path gets longer
+  }
+
+  // find the subtree below the edge
+  enum : char { UNKNOWN, INSIDE, OUTSIDE };
+  const size_t nVertices = m_graph.getNVertices();
+  std::vector<char> state(nVertices, UNKNOWN);
+  state[v] = INSIDE;
+
+  std::vector<VertexId> path;
+  for (VertexId x = 0; x < nVertices; ++x) {
+    VertexId y = x;
+    while (state[y] == UNKNOWN && tree.parents[y] != GlobalRoutingGraph::NO_VERTEX) {
+      path.push_back(y);
+      y = tree.parents[y];
+    }
+    if (state[y] == UNKNOWN) {
+      state[y] = OUTSIDE; // source or unreachable vertex
+    }
+    for (VertexId z : path) {
+      state[z] = state[y];
+    }
+    path.clear();
+  }
+
+  std::vector<VertexId> subtree;
+  for (VertexId x = 0; x < nVertices; ++x) {
+    if (state[x] == INSIDE) {
+      subtree.push_back(x);
+      changes.push_back({x, tree.distances[x]});
+      tree.distances[x] = {GlobalRoutingGraph::NO_FACE, GlobalRoutingGraph::INF_COST};
+      tree.parents[x] = GlobalRoutingGraph::NO_VERTEX;
+    }
+  }
+
+  // distances of the other vertices did not change, so they are the starting points
+  Queue queue;
+  for (VertexId x : subtree) {
+    Distance& distance = tree.distances[x];
+    m_graph.forEachInEdge(x, [&] (EdgeIndex, VertexId y, const Distance& weight) {
+        if (state[y] == INSIDE || !isReachable(tree.distances[y])) {
+          return;
+        }
+        Distance candidate = combine(tree.distances[y], weight);
+        if (candidate.cost < distance.cost) {
+          distance = candidate;
+          tree.parents[x] = y;
+        }
+      });
+    if (isReachable(distance)) {
+      queue.emplace(distance.cost, x);
+    }
+  }
+
+  while (!queue.empty()) {
+    QueueItem item = queue.top();
+    queue.pop();
+
+    const VertexId x = item.second;
+    const Distance distance = tree.distances[x];
+    if (item.first > distance.cost) {
+      continue; // stale item
+    }
+
+    m_graph.forEachOutEdge(x, [&] (EdgeIndex, VertexId z, const Distance& weight) {
+        if (state[z] != INSIDE) {
+          return;
+        }
+        Distance candidate = combine(distance, weight);
+        if (candidate.cost < tree.distances[z].cost) {
+          tree.distances[z] = candidate;
+          tree.parents[z] = x;
+          queue.emplace(candidate.cost, z);
+        }
+      });
+  }
+}
+
+void
+GlobalRoutingTrees::decreaseCost(VertexId source, Tree& tree, VertexId u, VertexId v,
+                                 const Distance& weight, std::vector<Change>& changes) const
+{
+  if (v == source || !isReachable(tree.distances[u])) {
+    return;
+  }
+
+  Distance candidate = combine(tree.distances[u], weight);
+  if (candidate.cost >= tree.distances[v].cost) {
+    return;
+  }
+  changes.push_back({v, tree.distances[v]});
+  tree.distances[v] = candidate;
+  tree.parents[v] = u;
+
+  // only vertices whose distance improves are visited
+  Queue queue;
+  queue.emplace(candidate.cost, v);
+  while (!queue.empty()) {
+    QueueItem item = queue.top();
+    queue.pop();
+
+    const VertexId x = item.second;
+    const Distance distance = tree.distances[x];
+    if (item.first > distance.cost) {
+      continue; // stale item
+    }
+
+    m_graph.forEachOutEdge(x, [&] (EdgeIndex, VertexId z, const Distance& edgeWeight) {
+        if (z == source) {
+          return;
+        }
+        Distance next = combine(distance, edgeWeight);
+        if (next.cost < tree.distances[z].cost) {
+          changes.push_back({z, tree.distances[z]});
+          tree.distances[z] = next;
+          tree.parents[z] = x;
+          queue.emplace(next.cost, z);
+        }
+      });
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GLOBAL_ROUTING_TREES_H
+#define NDN_GLOBAL_ROUTING_TREES_H
+
+/// @cond include_hidden
+
+#include "ndn-global-routing-graph.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Shortest path trees of all nodes, kept up to date when edge costs change
+ *
+ * When the cost of an edge increases, only the subtrees below it are recalculated, starting
+ * from the distances of the vertices around them.  When it decreases, only the vertices whose
+ * distance improves are visited.  Among paths of equal cost, a repaired tree may keep a
+ * different one than a complete recalculation would choose.
+ *
+ * Memory use is proportional to the number of nodes times the number of vertices.
+ */
+class GlobalRoutingTrees : boost::noncopyable {
+public:
+  using VertexId = GlobalRoutingGraph::VertexId;
+  using EdgeIndex = GlobalRoutingGraph::EdgeIndex;
+  using Distance = GlobalRoutingGraph::Distance;
+
+  struct Tree {
+    std::vector<Distance> distances;
+    std::vector<VertexId> parents;
+  };
+
+  /**
+   * @brief Previous distance from a source to a vertex whose distance has changed
+   */
+  struct Change {
+    VertexId vertex;
+    Distance distance;
+  };
+
+  /**
+   * @brief Take a snapshot of the graph and calculate the trees of all nodes
+   */
+  GlobalRoutingTrees();
+
+  const GlobalRoutingGraph&
+  getGraph() const
+  {
+    return m_graph;
+  }
+
+  /**
+   * @brief Get vertices of all nodes with GlobalRouter, in NodeList order
+   */
+  const std::vector<VertexId>&
+  getSources() const
+  {
+    return m_sources;
+  }
+
+  const Tree&
+  getTree(VertexId source) const
+  {
+    return m_trees[m_treeIds[source]];
+  }
+
+  /**
+   * @brief Change the cost of edges and repair the trees
+   *
+   * Trees are repaired in parallel.  Then \p onChange is called on the calling thread, in
+   * NodeList order, for each source whose distance to at least one vertex has changed.
+   *
+   * @param costs new costs of edges
+   * @param onChange called with a source and the previous distances of the changed vertices
+   */
+  void
+  updateEdges(const std::vector<std::pair<EdgeIndex, uint32_t>>& costs,
+              const std::function<void(VertexId, const std::vector<Change>&)>& onChange);
+
+private:
+  void
+  increaseCost(Tree& tree, VertexId u, VertexId v, std::vector<Change>& changes) const;
+
+  void
+  decreaseCost(VertexId source, Tree& tree, VertexId u, VertexId v, const Distance& weight,
+               std::vector<Change>& changes) const;
+
+private:
+  GlobalRoutingGraph m_graph;
+  std::vector<VertexId> m_sources;
+  std::vector<size_t> m_treeIds;
+  std::vector<Tree> m_trees;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+/// @endcond
+
+#endif // NDN_GLOBAL_ROUTING_TREES_H
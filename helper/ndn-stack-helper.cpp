@@ -116,6 +116,15 @@ StackHelper::setCsSize(size_t maxSize)
   m_maxCsSize = maxSize;
 }
 
+void
+StackHelper::setCsIndex(const std::string& index)
+{
+  if (index != "ordered" && index != "hash") {
+    NS_FATAL_ERROR("Content Store index " << index << " not found");
+  }
+  m_csIndex = index;
+}
+
 void
 StackHelper::setPolicy(const std::string& policy)
 {
@@ -132,6 +141,18 @@ StackHelper::setPolicy(const std::string& policy)
   }
 }
 
+void
+StackHelper::setSharedWire(bool isEnabled)
+{
+  m_isSharedWireEnabled = isEnabled;
+}
+
+void
+StackHelper::setLightweight(bool isEnabled)
+{
+  m_isLightweight = isEnabled;
+}
+
 void
 StackHelper::Install(const NodeContainer& c) const
 {
@@ -172,7 +193,12 @@ StackHelper::doInstall(Ptr<Node> node) const
     ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
   }
 
+  if (m_isLightweight) {
+    ndn->getConfig().put("ndnSIM.lightweight", true);
+  }
+
   ndn->getConfig().put("tables.cs_max_packets", m_maxCsSize);
+  ndn->getConfig().put("tables.cs_index", m_csIndex);
 
   ndn->setCsReplacementPolicy(m_csPolicyCreationFunc);
 
@@ -288,6 +314,9 @@ StackHelper::PointToPointNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   auto transport = make_unique<NetDeviceTransport>(node, netDevice,
                                                    constructFaceUri(netDevice),
                                                    constructFaceUri(remoteNetDevice));
+  if (m_isSharedWireEnabled) {
+    transport->enableSharedWire();
+  }
 
   auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
   face->setMetric(1);
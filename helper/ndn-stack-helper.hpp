@@ -85,6 +85,41 @@ public:
   void
   setPolicy(const std::string& policy);
 
+  /**
+   * @brief Set the lookup index for NFD's Content Store
+   * @param index "ordered" (default) or "hash"
+   *
+   * With "hash", Interests with CanBePrefix=false are looked up in a hash index on Data names,
+   * which corresponds to `tables.cs_index` in the NFD configuration.
+   */
+  void
+  setCsIndex(const std::string& index);
+
+  /**
+   * @brief Pass NDN packets over point-to-point links by reference instead of copying them
+   *
+   * Point-to-point faces created afterwards send each packet as a virtual ns-3 payload tagged
+   * with a reference to the NDN block, so forwarding does not copy the wire encoding at every
+   * hop.  Pcap traces of these links contain zero-filled payload; leave disabled if needed.
+   *
+   * @sa NetDeviceTransport::enableSharedWire
+   */
+  void
+  setSharedWire(bool isEnabled);
+
+  /**
+   * @brief Install NFD without management and RIB service on nodes installed afterwards
+   *
+   * Intended for consumer-only and leaf nodes in large topologies: such a node gets only the
+   * forwarder and its tables.  FibHelper and StrategyChoiceHelper update the tables directly,
+   * while applications that register prefixes through ndn::Face (e.g., via the RIB) and
+   * management commands are not supported on these nodes.
+   *
+   * @sa L3Protocol::isLightweight
+   */
+  void
+  setLightweight(bool isEnabled);
+
   typedef Callback<shared_ptr<Face>, Ptr<Node>, Ptr<L3Protocol>, Ptr<NetDevice>>
     FaceCreateCallback;
 
@@ -255,7 +290,10 @@ private:
   ObjectFactory m_ndnFactory;
 
   bool m_needSetDefaultRoutes;
+  bool m_isSharedWireEnabled = false;
+  bool m_isLightweight = false;
   size_t m_maxCsSize = 100;
+  std::string m_csIndex = "ordered";
 
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
   PolicyCreationCallback m_csPolicyCreationFunc;
@@ -31,6 +31,17 @@ NS_LOG_COMPONENT_DEFINE("ndn.StrategyChoiceHelper");
 void
 StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (l3protocol->isLightweight()) {
+    // no management on lightweight nodes, update the strategy choice table directly
+    auto result = l3protocol->getForwarder()->getStrategyChoice().insert(parameters.getName(),
+                                                                         parameters.getStrategy());
+    if (!result) {
+      NS_LOG_DEBUG("Cannot set strategy " << parameters.getStrategy() << ": " << result);
+    }
+    return;
+  }
+
   NS_LOG_DEBUG("Strategy choice command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -42,7 +53,6 @@ StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node>
   command->setCanBePrefix(false);
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
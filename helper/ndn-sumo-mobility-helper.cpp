@@ -0,0 +1,521 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-sumo-mobility-helper.hpp"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-net-device-transport.hpp"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/simulator.h"
+#include "ns3/waypoint-mobility-model.h"
+
+#include <cctype>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SumoMobilityHelper");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+const char BINARY_MAGIC[8] = {'N', 'D', 'N', 'F', 'C', 'D', '1', '\n'};
+
+struct FcdRecord {
+  uint32_t vehicle;
+  double x;
+  double y;
+};
+
+/**
+ * @brief Reads an FCD trace one timestep at a time
+ */
+class FcdReader {
+public:
+  virtual ~FcdReader() = default;
+
+  /**
+   * @brief Read the next timestep
+   * @return false at the end of the trace
+   */
+  virtual bool
+  readTimestep(double& time, std::vector<FcdRecord>& records) = 0;
+};
+
+/**
+ * @brief Reads `<timestep>` and `<vehicle>` elements of SUMO FCD XML output
+ *
+ * Vehicles are numbered in the order of their first appearance.  Other elements (e.g., persons
+ * and containers) are skipped.
+ */
+class XmlFcdReader : public FcdReader {
+public:
+  explicit XmlFcdReader(const std::string& fileName)
+    : m_fileName(fileName)
+    , m_is(fileName)
+  {
+    if (!m_is) {
+      NS_FATAL_ERROR("Cannot open FCD trace " << fileName);
+    }
+  }
+
+  bool
+  readTimestep(double& time, std::vector<FcdRecord>& records) override
+  {
+    records.clear();
+
+    bool isInTimestep = false;
+    while (readTag()) {
+      std::string name = m_tag.substr(0, m_tag.find_first_of(" \t\r\n/", 1));
+      if (name == "timestep") {
+        time = std::stod(getAttribute("time"));
+        if (m_tag.back() == '/') {
+          return true; // empty timestep
+        }
+        isInTimestep = true;
+      }
+      else if (name == "/timestep") {
+        return true;
+      }
+      else if (name == "vehicle" && isInTimestep) {
+        auto id = m_vehicleIds.emplace(getAttribute("id"), m_vehicleIds.size()).first->second;
+        records.push_back({static_cast<uint32_t>(id), std::stod(getAttribute("x")),
+                           std::stod(getAttribute("y"))});
+      }
+    }
+
+    if (isInTimestep) {
+      NS_FATAL_ERROR("FCD trace " << m_fileName << " ends inside a timestep");
+    }
+    return false;
+  }
+
+private:
+  /**
+   * @brief Read the contents of the next tag, without the angle brackets, into m_tag
+   *
+   * Comments, which contain the SUMO configuration as XML, are skipped.
+   */
+  bool
+  readTag()
+  {
+    while (true) {
+      m_is.ignore(std::numeric_limits<std::streamsize>::max(), '<');
+      if (!std::getline(m_is, m_tag, '>')) {
+        return false;
+      }
+      if (m_tag.empty()) {
+        NS_FATAL_ERROR("Empty tag in FCD trace " << m_fileName);
+      }
+      if (m_tag.compare(0, 3, "!--") != 0) {
+        return true;
+      }
+
+      std::string rest;
+      while (m_tag.size() < 5 || m_tag.compare(m_tag.size() - 2, 2, "--") != 0) {
+        if (!std::getline(m_is, rest, '>')) {
+          NS_FATAL_ERROR("Unterminated comment in FCD trace " << m_fileName);
+        }
+        m_tag += '>';
+        m_tag += rest;
+      }
+    }
+  }
+
+  std::string
+  getAttribute(const char* name) const
+  {
+    const size_t nameLength = std::strlen(name);
+    for (size_t pos = m_tag.find(name); pos != std::string::npos;
+         pos = m_tag.find(name, pos + 1)) {
+      size_t valuePos = pos + nameLength;
+      if (pos > 0 && std::isspace(m_tag[pos - 1]) && m_tag.compare(valuePos, 2, "=\"") == 0) {
+        valuePos += 2;
+        return m_tag.substr(valuePos, m_tag.find('"', valuePos) - valuePos);
+      }
+    }
+    NS_FATAL_ERROR("Missing attribute " << name << " in <" << m_tag << "> of FCD trace "
+                   << m_fileName);
+    return "";
+  }
+
+private:
+  std::string m_fileName;
+  std::ifstream m_is;
+  std::string m_tag;
+  std::unordered_map<std::string, size_t> m_vehicleIds;
+};
+
+/**
+ * @brief Reads the binary format written by SumoMobilityHelper::ConvertToBinary
+ *
+ * After the magic, each timestep is its time (double) and number of records (uint32_t),
+ * followed by the vehicle (uint32_t), x (double), and y (double) of each record, all in host
+ * byte order.
+ */
+class BinaryFcdReader : public FcdReader {
+public:
+  explicit BinaryFcdReader(const std::string& fileName)
+    : m_fileName(fileName)
+    , m_is(fileName, std::ios::binary)
+  {
+    char magic[sizeof(BINARY_MAGIC)];
+    if (!m_is.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0) {
+      NS_FATAL_ERROR("Cannot open binary FCD trace " << fileName);
+    }
+  }
+
+  bool
+  readTimestep(double& time, std::vector<FcdRecord>& records) override
+  {
+    records.clear();
+
+    uint32_t nRecords = 0;
+    if (!read(time)) {
+      return false;
+    }
+    if (!read(nRecords)) {
+      NS_FATAL_ERROR("Truncated binary FCD trace " << m_fileName);
+    }
+
+    records.resize(nRecords);
+    for (auto& record : records) {
+      if (!read(record.vehicle) || !read(record.x) || !read(record.y)) {
+        NS_FATAL_ERROR("Truncated binary FCD trace " << m_fileName);
+      }
+    }
+    return true;
+  }
+
+private:
+  template<typename T>
+  bool
+  read(T& value)
+  {
+    return static_cast<bool>(m_is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+  }
+
+private:
+  std::string m_fileName;
+  std::ifstream m_is;
+};
+
+std::unique_ptr<FcdReader>
+openFcdReader(const std::string& fileName)
+{
+  char magic[sizeof(BINARY_MAGIC)] = {};
+  std::ifstream is(fileName, std::ios::binary);
+  if (!is) {
+    NS_FATAL_ERROR("Cannot open FCD trace " << fileName);
+  }
+  is.read(magic, sizeof(magic));
+
+  if (std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0) {
+    return make_unique<BinaryFcdReader>(fileName);
+  }
+  return make_unique<XmlFcdReader>(fileName);
+}
+
+/**
+ * @brief State of a trace while the simulation runs, kept alive by its scheduled events
+ */
+class SumoMobilityLoader : public SimpleRefCount<SumoMobilityLoader> {
+public:
+  SumoMobilityLoader(std::unique_ptr<FcdReader> reader, const NodeContainer& nodes,
+                     Time lookAhead, Time window,
+                     SumoMobilityHelper::ActivationCallback activationCallback)
+    : m_reader(std::move(reader))
+    , m_lookAhead(lookAhead)
+    , m_window(window)
+    , m_activationCallback(std::move(activationCallback))
+  {
+    for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+      m_freeNodes.push_back({*node, false, 0});
+    }
+  }
+
+  void
+  ReadAhead()
+  {
+    const Time horizon = Simulator::Now() + m_lookAhead;
+
+    while (true) {
+      if (!m_hasPending) {
+        if (!m_reader->readTimestep(m_pendingTime, m_pending)) {
+          // vehicles that are still present leave after their last timestep
+          for (auto& vehicle : m_vehicles) {
+            Deactivate(vehicle.second);
+          }
+          m_vehicles.clear();
+          NS_LOG_DEBUG("End of FCD trace");
+          return;
+        }
+        m_hasPending = true;
+      }
+
+      if (Seconds(m_pendingTime) > horizon) {
+        break;
+      }
+      ProcessTimestep(m_pendingTime, m_pending);
+      m_hasPending = false;
+    }
+
+    Simulator::Schedule(m_window, &SumoMobilityLoader::ReadAhead, Ptr<SumoMobilityLoader>(this));
+  }
+
+  void
+  ScheduleActivation(Ptr<Node> node, double time, bool isActive)
+  {
+    Time delay = Max(Seconds(time) - Simulator::Now(), Time(0));
+    Simulator::ScheduleWithContext(node->GetId(), delay, &SumoMobilityLoader::Activate,
+                                   Ptr<SumoMobilityLoader>(this), node, isActive);
+  }
+
+private:
+  struct Vehicle {
+    Ptr<Node> node; // nullptr while no node is left for the vehicle
+    double firstSeen;
+    double lastSeen;
+  };
+
+  struct FreeNode {
+    Ptr<Node> node;
+    bool hasWaypoints;
+    double lastWaypoint; // time of the last waypoint of the previous vehicle
+  };
+
+  void
+  ProcessTimestep(double time, const std::vector<FcdRecord>& records)
+  {
+    // entering vehicles, and vehicles that are still waiting for a node
+    std::vector<const FcdRecord*> unassigned;
+    for (const auto& record : records) {
+      auto result = m_vehicles.emplace(record.vehicle, Vehicle{nullptr, time, time});
+      Vehicle& vehicle = result.first->second;
+      if (!result.second) {
+        if (vehicle.lastSeen == time) {
+          continue; // duplicate record
+        }
+        vehicle.lastSeen = time;
+      }
+
+      if (vehicle.node == nullptr) {
+        unassigned.push_back(&record);
+      }
+      else {
+        AddWaypoint(vehicle.node, Seconds(time), record);
+      }
+    }
+
+    // vehicles missing from this timestep have left, so their nodes can be reused right away
+    for (auto it = m_vehicles.begin(); it != m_vehicles.end();) {
+      if (it->second.lastSeen < time) {
+        Deactivate(it->second);
+        it = m_vehicles.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+
+    for (const FcdRecord* record : unassigned) {
+      Vehicle& vehicle = m_vehicles.at(record->vehicle);
+      if (m_freeNodes.empty()) {
+        if (vehicle.firstSeen == time) {
+          NS_LOG_WARN("No node left for vehicle " << record->vehicle << " at " << time << "s");
+        }
+        continue;
+      }
+      FreeNode freeNode = m_freeNodes.front();
+      m_freeNodes.pop_front();
+      vehicle.node = freeNode.node;
+
+      NS_LOG_DEBUG("Vehicle " << record->vehicle << " enters at " << time << "s as node "
+                   << vehicle.node->GetId());
+      if (freeNode.hasWaypoints) {
+        // move the node right after the previous vehicle has left, instead of interpolating
+        // between the positions of the two vehicles
+        Time jump = Seconds(freeNode.lastWaypoint) + TimeStep(1);
+        if (jump < Seconds(time)) {
+          AddWaypoint(vehicle.node, jump, *record);
+        }
+      }
+      AddWaypoint(vehicle.node, Seconds(time), *record);
+      ScheduleActivation(vehicle.node, time, true);
+    }
+  }
+
+  void
+  AddWaypoint(Ptr<Node> node, Time time, const FcdRecord& record)
+  {
+    node->GetObject<WaypointMobilityModel>()->AddWaypoint(
+      Waypoint(time, Vector(record.x, record.y, 0)));
+  }
+
+  /**
+   * @brief Deactivate the node of a vehicle after its last timestep, and make it reusable
+   */
+  void
+  Deactivate(const Vehicle& vehicle)
+  {
+    if (vehicle.node == nullptr) {
+      return;
+    }
+    NS_LOG_DEBUG("Node " << vehicle.node->GetId() << " leaves at " << vehicle.lastSeen << "s");
+    ScheduleActivation(vehicle.node, vehicle.lastSeen, false);
+    m_freeNodes.push_back({vehicle.node, true, vehicle.lastSeen});
+  }
+
+  void
+  Activate(Ptr<Node> node, bool isActive)
+  {
+    if (m_activationCallback) {
+      m_activationCallback(node, isActive);
+    }
+  }
+
+private:
+  std::unique_ptr<FcdReader> m_reader;
+  std::map<uint32_t, Vehicle> m_vehicles; // present vehicles, ordered for reproducible node reuse
+  std::deque<FreeNode> m_freeNodes;
+  bool m_hasPending = false;
+  double m_pendingTime = 0;
+  std::vector<FcdRecord> m_pending; // first timestep after the look-ahead time
+
+  Time m_lookAhead;
+  Time m_window;
+  SumoMobilityHelper::ActivationCallback m_activationCallback;
+};
+
+} // namespace
+
+SumoMobilityHelper::SumoMobilityHelper(const std::string& fileName)
+  : m_fileName(fileName)
+  , m_lookAhead(Seconds(5))
+  , m_window(Seconds(1))
+  , m_activationCallback(&SumoMobilityHelper::SetNdnStackEnabled)
+{
+}
+
+void
+SumoMobilityHelper::SetLookAhead(Time lookAhead)
+{
+  m_lookAhead = lookAhead;
+}
+
+void
+SumoMobilityHelper::SetWindow(Time window)
+{
+  NS_ABORT_MSG_IF(window <= Time(0), "Window must be positive");
+  m_window = window;
+}
+
+void
+SumoMobilityHelper::SetActivationCallback(ActivationCallback callback)
+{
+  m_activationCallback = std::move(callback);
+}
+
+void
+SumoMobilityHelper::Install(const NodeContainer& nodes) const
+{
+  NS_ABORT_MSG_IF(m_lookAhead < m_window,
+                  "Look-ahead time must not be shorter than the window, so that waypoints are "
+                  "added before they are reached");
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    NS_ABORT_MSG_IF((*node)->GetObject<MobilityModel>() != nullptr,
+                    "Node " << (*node)->GetId() << " already has a mobility model");
+
+    // positions are only calculated when they are queried, rather than at every waypoint
+    Ptr<WaypointMobilityModel> mobility = CreateObject<WaypointMobilityModel>();
+    mobility->SetAttribute("LazyNotify", BooleanValue(true));
+    (*node)->AggregateObject(mobility);
+
+  }
+
+  Ptr<SumoMobilityLoader> loader = Create<SumoMobilityLoader>(openFcdReader(m_fileName), nodes,
+                                                              m_lookAhead, m_window,
+                                                              m_activationCallback);
+  // nodes are inactive until their vehicles enter
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    loader->ScheduleActivation(*node, 0, false);
+  }
+  Simulator::Schedule(Seconds(0), &SumoMobilityLoader::ReadAhead, loader);
+}
+
+void
+SumoMobilityHelper::SetNdnStackEnabled(Ptr<Node> node, bool isEnabled)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != nullptr, "NDN stack is not installed on node " << node->GetId());
+
+  for (const auto& face : ndn->getFaceTable()) {
+    auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
+    if (transport != nullptr) {
+      transport->setEnabled(isEnabled);
+    }
+  }
+}
+
+void
+SumoMobilityHelper::ConvertToBinary(const std::string& xmlFileName,
+                                    const std::string& binaryFileName)
+{
+  XmlFcdReader reader(xmlFileName);
+  std::ofstream os(binaryFileName, std::ios::binary);
+  if (!os) {
+    NS_FATAL_ERROR("Cannot open " << binaryFileName);
+  }
+
+  auto write = [&os] (const auto& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  os.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+  double time = 0;
+  std::vector<FcdRecord> records;
+  while (reader.readTimestep(time, records)) {
+    write(time);
+    write(static_cast<uint32_t>(records.size()));
+    for (const auto& record : records) {
+      write(record.vehicle);
+      write(record.x);
+      write(record.y);
+    }
+  }
+
+  if (!os) {
+    NS_FATAL_ERROR("Cannot write " << binaryFileName);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SUMO_MOBILITY_HELPER_H
+#define NDN_SUMO_MOBILITY_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to drive vehicle mobility from a SUMO floating car data (FCD) trace
+ *
+ * Unlike converting the trace to an ns-2 mobility trace and scheduling all of its waypoints
+ * before the simulation starts, the trace is read while the simulation runs.  Every window, the
+ * timesteps up to the look-ahead time are read, and their positions are added as waypoints of
+ * the WaypointMobilityModel of the vehicles, so that memory use does not depend on the length
+ * of the trace.
+ *
+ * Vehicles are assigned to nodes in the order they appear in the trace.  A node is activated
+ * when its vehicle enters the trace and deactivated after the last timestep in which the vehicle
+ * appears.  By default, activation enables the NDN faces of the node (see SetNdnStackEnabled),
+ * so that vehicles outside of the trace neither send nor receive packets.  Nodes of vehicles
+ * that have left are reused for new vehicles when no unused node is left; a reused node is
+ * moved to the position of its new vehicle right after the previous vehicle has left.  Vehicles
+ * that enter while all nodes are in use get a node as soon as one is released.
+ *
+ * Supported trace formats are the FCD XML output of SUMO (`sumo --fcd-output`) and its binary
+ * form written by ConvertToBinary, which is faster to read and smaller.  Files are recognized
+ * by their content.
+ *
+ * Example:
+ *
+ *     SumoMobilityHelper sumoHelper("fcd.xml");
+ *     sumoHelper.Install(vehicles); // after ndn::StackHelper::Install
+ */
+class SumoMobilityHelper {
+public:
+  /**
+   * @brief Callback to activate or deactivate the node of a vehicle
+   */
+  typedef std::function<void(Ptr<Node> node, bool isActive)> ActivationCallback;
+
+  /**
+   * @param fileName FCD trace, in XML or binary format
+   */
+  explicit SumoMobilityHelper(const std::string& fileName);
+
+  /**
+   * @brief Set how far ahead of the simulation time the trace is read (default 5 seconds)
+   */
+  void
+  SetLookAhead(Time lookAhead);
+
+  /**
+   * @brief Set how often the trace is read (default 1 second)
+   */
+  void
+  SetWindow(Time window);
+
+  /**
+   * @brief Set the callback to activate and deactivate nodes (default SetNdnStackEnabled)
+   */
+  void
+  SetActivationCallback(ActivationCallback callback);
+
+  /**
+   * @brief Install WaypointMobilityModel on nodes, deactivate them, and start reading the trace
+   *
+   * Must be called after the NDN stack is installed on the nodes, and before the simulation
+   * starts.
+   *
+   * @param nodes nodes that can be assigned to vehicles
+   */
+  void
+  Install(const NodeContainer& nodes) const;
+
+  /**
+   * @brief Enable or disable all NetDevice faces of a node
+   */
+  static void
+  SetNdnStackEnabled(Ptr<Node> node, bool isEnabled);
+
+  /**
+   * @brief Convert an FCD XML trace into the binary format
+   *
+   * Vehicles are numbered in the order of their first appearance.  Only positions are kept.
+   */
+  static void
+  ConvertToBinary(const std::string& xmlFileName, const std::string& binaryFileName);
+
+private:
+  std::string m_fileName;
+  Time m_lookAhead;
+  Time m_window;
+  ActivationCallback m_activationCallback;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SUMO_MOBILITY_HELPER_H
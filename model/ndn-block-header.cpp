@@ -19,16 +19,13 @@
 
 #include "ndn-block-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
+#include <limits>
 
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
-namespace io = boost::iostreams;
 namespace nfdFace = nfd::face;
 
 namespace ns3 {
@@ -73,37 +70,54 @@ BlockHeader::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_block.wire(), m_block.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+/**
+ * \brief Read a TLV-TYPE or TLV-LENGTH VAR-NUMBER from ns-3 buffer
+ */
+static uint64_t
+readVarNumber(ns3::Buffer::Iterator& i)
+{
+  if (i.GetRemainingSize() < 1) {
+    throw ::ndn::tlv::Error("Insufficient data during TLV parsing");
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  uint8_t firstOctet = i.ReadU8();
+  size_t nOctets = firstOctet < 253 ? 0 : (1 << (firstOctet - 252));
+  if (i.GetRemainingSize() < nOctets) {
+    throw ::ndn::tlv::Error("Insufficient data during TLV parsing");
   }
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  switch (nOctets) {
+    case 2:
+      return i.ReadNtohU16();
+    case 4:
+      return i.ReadNtohU32();
+    case 8:
+      return i.ReadNtohU64();
+    default:
+      return firstOctet;
+  }
+}
 
 uint32_t
 BlockHeader::Deserialize(ns3::Buffer::Iterator start)
 {
-  io::stream<Ns3BufferIteratorSource> is(start);
-  m_block = ::ndn::Block::fromStream(is);
+  // Peek TLV-TYPE and TLV-LENGTH, so the whole block can be pulled into a pre-sized buffer with
+  // a single read instead of going byte-by-byte through a std::istream
+  ns3::Buffer::Iterator i = start;
+  uint64_t type = readVarNumber(i);
+  uint64_t length = readVarNumber(i);
+
+  if (type == 0 || type > std::numeric_limits<uint32_t>::max()) {
+    throw ::ndn::tlv::Error("Illegal TLV-TYPE " + std::to_string(type));
+  }
+  if (length > i.GetRemainingSize()) {
+    throw ::ndn::tlv::Error("Not enough bytes in the packet to fully parse TLV");
+  }
+
+  auto buffer = make_shared<::ndn::Buffer>(i.GetDistanceFrom(start) + length);
+  start.Read(buffer->data(), buffer->size());
+
+  m_block = Block(std::move(buffer));
   return m_block.size();
 }
 
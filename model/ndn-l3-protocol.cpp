@@ -109,10 +109,13 @@ L3Protocol::GetTypeId(void)
   return tid;
 }
 
-class L3Protocol::Impl {
-private:
-  Impl()
-  {
+/**
+ * \brief Parse the initial NFD config once; every node starts from a copy of it
+ */
+static const nfd::ConfigSection&
+getInitialConfig()
+{
+  static const nfd::ConfigSection config = [] {
     // Do not modify initial config file. Use helpers to set specific NFD parameters
     std::string initialConfig =
       "general\n"
@@ -162,8 +165,19 @@ private:
       "}\n"
       "\n";
 
+    nfd::ConfigSection section;
     std::istringstream input(initialConfig);
-    boost::property_tree::read_info(input, m_config);
+    boost::property_tree::read_info(input, section);
+    return section;
+  }();
+  return config;
+}
+
+class L3Protocol::Impl {
+private:
+  Impl()
+    : m_config(getInitialConfig())
+  {
   }
 
   friend class L3Protocol;
@@ -192,6 +206,7 @@ private:
   std::unique_ptr<::nfd::rib::Service> m_ribService;
 
   nfd::ConfigSection m_config;
+  bool m_isLightweight = false;
 
   PolicyCreationCallback m_policy;
 };
@@ -212,10 +227,17 @@ L3Protocol::initialize()
 {
   m_impl->m_faceTable = make_unique<::nfd::FaceTable>();
   m_impl->m_forwarder = make_shared<::nfd::Forwarder>(*m_impl->m_faceTable);
-  m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(*m_impl->m_faceTable, nullptr);
 
-  initializeManagement();
-  initializeRibManager();
+  m_impl->m_isLightweight = this->getConfig().get<bool>("ndnSIM.lightweight", false);
+  if (m_impl->m_isLightweight) {
+    initializeTables();
+  }
+  else {
+    m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(*m_impl->m_faceTable, nullptr);
+
+    initializeManagement();
+    initializeRibManager();
+  }
 
   m_impl->m_forwarder->beforeSatisfyInterest.connect(std::ref(m_satisfiedInterests));
   m_impl->m_forwarder->beforeExpirePendingInterest.connect(std::ref(m_timedOutInterests));
@@ -245,6 +267,11 @@ private:
 void
 L3Protocol::injectInterest(const Interest& interest)
 {
+  if (m_impl->m_internalClientFaceForInjects == nullptr) {
+    // lightweight nodes create the internal face on first use
+    initializeInjectFace();
+  }
+
   m_impl->m_internalClientFaceForInjects->expressInterest(interest, nullptr, nullptr, nullptr);
 }
 
@@ -257,14 +284,12 @@ L3Protocol::setCsReplacementPolicy(const PolicyCreationCallback& policy)
 void
 L3Protocol::initializeManagement()
 {
-  auto& forwarder = m_impl->m_forwarder;
   using namespace nfd;
 
   std::tie(m_impl->m_internalFace, m_impl->m_internalClientFace) = face::makeInternalFace(StackHelper::getKeyChain());
   m_impl->m_faceTable->addReserved(m_impl->m_internalFace, face::FACEID_INTERNAL_FACE);
 
-  std::tie(m_impl->m_internalFaceForInjects, m_impl->m_internalClientFaceForInjects) = face::makeInternalFace(StackHelper::getKeyChain());
-  m_impl->m_faceTable->addReserved(m_impl->m_internalFaceForInjects, face::FACEID_INTERNAL_FACE + 1);
+  initializeInjectFace();
 
   m_impl->m_dispatcher = make_unique<::ndn::mgmt::Dispatcher>(*m_impl->m_internalClientFace, StackHelper::getKeyChain());
   m_impl->m_authenticator = ::nfd::CommandAuthenticator::create();
@@ -286,29 +311,56 @@ L3Protocol::initializeManagement()
     this->getConfig().get_child("authorizations").get_child("authorize").get_child("privileges").erase("strategy-choice");
   }
 
+  initializeTables();
+
+  // add FIB entry for NFD Management Protocol
+  Name topPrefix("/localhost/nfd");
+  auto entry = m_impl->m_forwarder->getFib().insert(topPrefix).first;
+  m_impl->m_forwarder->getFib().addOrUpdateNextHop(*entry, *m_impl->m_internalFace, 0);
+  m_impl->m_dispatcher->addTopPrefix(topPrefix, false);
+}
+
+void
+L3Protocol::initializeTables()
+{
+  using namespace nfd;
+
   ConfigFile config(&ConfigFile::ignoreUnknownSection);
 
-  forwarder->getCs().setPolicy(m_impl->m_policy());
+  m_impl->m_forwarder->getCs().setPolicy(m_impl->m_policy());
 
-  TablesConfigSection tablesConfig(*forwarder);
+  TablesConfigSection tablesConfig(*m_impl->m_forwarder);
   tablesConfig.setConfigFile(config);
 
-  m_impl->m_authenticator->setConfigFile(config);
+  if (!m_impl->m_isLightweight) {
+    m_impl->m_authenticator->setConfigFile(config);
 
-  // if (!this->getConfig().get<bool>("ndnSIM.disable_face_manager", false)) {
-  m_impl->m_faceSystem->setConfigFile(config);
-  // }
+    // if (!this->getConfig().get<bool>("ndnSIM.disable_face_manager", false)) {
+    m_impl->m_faceSystem->setConfigFile(config);
+    // }
+  }
 
   // apply config
   config.parse(m_impl->m_config, false, "ndnSIM.conf");
 
   tablesConfig.ensureConfigured();
+}
 
-  // add FIB entry for NFD Management Protocol
-  Name topPrefix("/localhost/nfd");
-  auto entry = m_impl->m_forwarder->getFib().insert(topPrefix).first;
-  m_impl->m_forwarder->getFib().addOrUpdateNextHop(*entry, *m_impl->m_internalFace, 0);
-  m_impl->m_dispatcher->addTopPrefix(topPrefix, false);
+void
+L3Protocol::initializeInjectFace()
+{
+  using namespace nfd;
+
+  std::tie(m_impl->m_internalFaceForInjects, m_impl->m_internalClientFaceForInjects) =
+    face::makeInternalFace(StackHelper::getKeyChain());
+  m_impl->m_faceTable->addReserved(m_impl->m_internalFaceForInjects, face::FACEID_INTERNAL_FACE + 1);
+
+  if (m_impl->m_isLightweight) {
+    // without a management face, the NFD Management Protocol prefix leads to the inject face
+    Name topPrefix("/localhost/nfd");
+    auto entry = m_impl->m_forwarder->getFib().insert(topPrefix).first;
+    m_impl->m_forwarder->getFib().addOrUpdateNextHop(*entry, *m_impl->m_internalFaceForInjects, 0);
+  }
 }
 
 void
@@ -345,15 +397,24 @@ L3Protocol::getFibManager()
 nfd::StrategyChoiceManager&
 L3Protocol::getStrategyChoiceManager()
 {
+  NS_ASSERT_MSG(m_impl->m_strategyChoiceManager != nullptr,
+                "StrategyChoiceManager is disabled or the node is lightweight");
   return *m_impl->m_strategyChoiceManager;
 }
 
 ::nfd::rib::Service&
 L3Protocol::getRibService()
 {
+  NS_ASSERT_MSG(m_impl->m_ribService != nullptr, "Lightweight nodes have no RIB service");
   return *m_impl->m_ribService;
 }
 
+bool
+L3Protocol::isLightweight() const
+{
+  return m_impl->m_isLightweight;
+}
+
 nfd::ConfigSection&
 L3Protocol::getConfig()
 {
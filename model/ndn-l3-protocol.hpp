@@ -110,6 +110,7 @@ public:
 
   /**
    * \brief Get smart pointer to nfd::FibManager, used by node's NFD
+   * \return nullptr if the node is lightweight
    */
   shared_ptr<nfd::FibManager>
   getFibManager();
@@ -123,6 +124,17 @@ public:
   ::nfd::rib::Service&
   getRibService();
 
+  /**
+   * \brief Check whether the node runs NFD without management and RIB service
+   *
+   * A lightweight node has only the forwarder and its tables. FibHelper and StrategyChoiceHelper
+   * modify its tables directly instead of sending management commands.
+   *
+   * \sa StackHelper::setLightweight
+   */
+  bool
+  isLightweight() const;
+
   /**
    * \brief Add face to NDN stack
    *
@@ -205,6 +217,12 @@ private:
   void
   initializeManagement();
 
+  void
+  initializeTables();
+
+  void
+  initializeInjectFace();
+
   void
   initializeRibManager();
 
@@ -20,15 +20,15 @@
 #include "ndn-net-device-transport.hpp"
 
 #include "../helper/ndn-stack-helper.hpp"
+#include "ndn-l3-protocol.hpp"
 #include "ndn-block-header.hpp"
+#include "ndn-shared-block-tag.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 
-#include "ns3/queue.h"
-
 NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceTransport");
 
 namespace ns3 {
@@ -51,21 +51,10 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
   this->setLinkType(linkType);
   this->setMtu(m_netDevice->GetMtu()); // Use the MTU of the netDevice
 
-  // Get send queue capacity for congestion marking
-  PointerValue txQueueAttribute;
-  if (m_netDevice->GetAttributeFailSafe("TxQueue", txQueueAttribute)) {
-    Ptr<ns3::QueueBase> txQueue = txQueueAttribute.Get<ns3::QueueBase>();
-    // must be put into bytes mode queue
-
-    auto size = txQueue->GetMaxSize();
-    if (size.GetUnit() == BYTES) {
-      this->setSendQueueCapacity(size.GetValue());
-    }
-    else {
-      // don't know the exact size in bytes, guessing based on "standard" packet size
-      this->setSendQueueCapacity(size.GetValue() * 1500);
-    }
-  }
+  // Get send queue and its capacity for congestion marking.  Scenarios commonly configure the
+  // queue after the stack is installed, so look it up again once the simulation starts.
+  this->rebindTxQueue();
+  m_rebindTxQueueEvent = Simulator::ScheduleNow(&NetDeviceTransport::rebindTxQueue, this);
 
   NS_LOG_FUNCTION(this << "Creating an ndnSIM transport instance for netDevice with URI"
                   << this->getLocalUri());
@@ -80,19 +69,116 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
 NetDeviceTransport::~NetDeviceTransport()
 {
   NS_LOG_FUNCTION_NOARGS();
+
+  m_rebindTxQueueEvent.Cancel();
 }
 
 ssize_t
 NetDeviceTransport::getSendQueueLength()
 {
+  if (m_txQueue == nullptr) {
+    return nfd::face::QUEUE_UNSUPPORTED;
+  }
+  return m_txQueue->GetNBytes();
+}
+
+void
+NetDeviceTransport::rebindTxQueue()
+{
+  Ptr<ns3::QueueBase> txQueue;
   PointerValue txQueueAttribute;
   if (m_netDevice->GetAttributeFailSafe("TxQueue", txQueueAttribute)) {
-    Ptr<ns3::QueueBase> txQueue = txQueueAttribute.Get<ns3::QueueBase>();
-    return txQueue->GetNBytes();
+    txQueue = txQueueAttribute.Get<ns3::QueueBase>();
+  }
+
+  if (txQueue == m_txQueue) {
+    return;
+  }
+
+  if (m_isSharedWire) {
+    auto release = MakeCallback(&SharedBlockTag::Release);
+    if (m_txQueue != nullptr) {
+      m_txQueue->TraceDisconnectWithoutContext("Drop", release);
+    }
+    if (txQueue != nullptr) {
+      txQueue->TraceConnectWithoutContext("Drop", release);
+    }
+  }
+  m_txQueue = txQueue;
+
+  if (m_txQueue == nullptr) {
+    this->setSendQueueCapacity(nfd::face::QUEUE_UNSUPPORTED);
+    return;
+  }
+
+  // must be put into bytes mode queue
+  auto size = m_txQueue->GetMaxSize();
+  if (size.GetUnit() == BYTES) {
+    this->setSendQueueCapacity(size.GetValue());
   }
   else {
-    return nfd::face::QUEUE_UNSUPPORTED;
+    // don't know the exact size in bytes, guessing based on "standard" packet size
+    this->setSendQueueCapacity(size.GetValue() * 1500);
+  }
+}
+
+bool
+NetDeviceTransport::enableSharedWire()
+{
+  if (m_isSharedWire) {
+    return true;
+  }
+
+  Ptr<PointToPointNetDevice> device = DynamicCast<PointToPointNetDevice>(m_netDevice);
+  if (device == nullptr || device->GetChannel() == nullptr) {
+    NS_LOG_DEBUG("Shared-wire mode is not supported for " << m_netDevice->GetInstanceTypeId());
+    return false;
+  }
+
+  // the registry entry of every packet that does not reach the remote transport must be released
+  auto release = MakeCallback(&SharedBlockTag::Release);
+  device->TraceConnectWithoutContext("MacTxDrop", release);
+  device->TraceConnectWithoutContext("PhyTxDrop", release);
+
+  if (m_txQueue != nullptr) {
+    m_txQueue->TraceConnectWithoutContext("Drop", release);
+  }
+
+  Ptr<Channel> channel = device->GetChannel();
+  for (std::size_t i = 0; i < channel->GetNDevices(); ++i) {
+    Ptr<NetDevice> remoteDevice = channel->GetDevice(i);
+    if (remoteDevice != m_netDevice) {
+      remoteDevice->TraceConnectWithoutContext("PhyRxDrop", release);
+      m_remoteNetDevice = remoteDevice;
+    }
+  }
+
+  m_isSharedWire = true;
+  return true;
+}
+
+bool
+NetDeviceTransport::hasRemoteHandler()
+{
+  if (!m_hasRemoteHandler && m_remoteNetDevice != nullptr) {
+    // the remote node drops packets without a trace if no face of its NDN stack registered
+    // the protocol handler for the remote device, so their blocks would never be released
+    Ptr<L3Protocol> remoteNdn = m_remoteNetDevice->GetNode()->GetObject<L3Protocol>();
+    m_hasRemoteHandler = remoteNdn != nullptr &&
+                         remoteNdn->getFaceByNetDevice(m_remoteNetDevice) != nullptr;
+  }
+  return m_hasRemoteHandler;
+}
+
+void
+NetDeviceTransport::setEnabled(bool isEnabled)
+{
+  auto state = this->getState();
+  if (state != nfd::face::TransportState::UP && state != nfd::face::TransportState::DOWN) {
+    return;
   }
+
+  this->setState(isEnabled ? nfd::face::TransportState::UP : nfd::face::TransportState::DOWN);
 }
 
 void
@@ -111,11 +197,22 @@ NetDeviceTransport::doSend(const Block& packet, const nfd::EndpointId& endpoint)
   NS_LOG_FUNCTION(this << "Sending packet from netDevice with URI"
                   << this->getLocalUri());
 
+  if (this->getState() != nfd::face::TransportState::UP) {
+    NS_LOG_DEBUG("Dropping outgoing packet, transport is disabled");
+    return;
+  }
+
   // convert NFD packet to NS3 packet
-  BlockHeader header(packet);
+  Ptr<ns3::Packet> ns3Packet;
+  if (m_isSharedWire && hasRemoteHandler()) {
+    ns3Packet = SharedBlockTag::CreatePacket(packet);
+  }
+  else {
+    BlockHeader header(packet);
 
-  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
-  ns3Packet->AddHeader(header);
+    ns3Packet = Create<ns3::Packet>();
+    ns3Packet->AddHeader(header);
+  }
 
   // send the NS3 packet
   m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
@@ -132,13 +229,34 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  // Convert NS3 packet to NFD packet
-  Ptr<ns3::Packet> packet = p->Copy();
+  bool isEnabled = this->getState() == nfd::face::TransportState::UP;
 
-  BlockHeader header;
-  packet->RemoveHeader(header);
+  Block block;
+  if (SharedBlockTag::ExtractBlock(p, block)) {
+    if (isEnabled) {
+      this->receive(std::move(block));
+    }
+    return;
+  }
+
+  if (!isEnabled) {
+    NS_LOG_DEBUG("Dropping incoming packet, transport is disabled");
+    return;
+  }
+
+  // Convert NS3 packet to NFD packet: bulk-copy the payload into a single pre-sized buffer
+  // (trailing bytes, e.g., Ethernet padding, are ignored by the TLV parser)
+  auto buffer = make_shared<::ndn::Buffer>(p->GetSize());
+  p->CopyData(buffer->data(), buffer->size());
+
+  bool isOk = false;
+  std::tie(isOk, block) = Block::fromBuffer(std::move(buffer), 0);
+  if (!isOk) {
+    NS_LOG_DEBUG("Dropping packet that does not contain a valid TLV block");
+    return;
+  }
 
-  this->receive(std::move(header.getBlock()));
+  this->receive(std::move(block));
 }
 
 Ptr<NetDevice>
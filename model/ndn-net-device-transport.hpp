@@ -28,6 +28,8 @@
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/pointer.h"
+#include "ns3/queue.h"
+#include "ns3/simulator.h"
 
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
@@ -57,6 +59,42 @@ public:
   virtual ssize_t
   getSendQueueLength() final;
 
+  /**
+   * \brief Look up the transmit queue of the NetDevice again
+   *
+   * The queue is resolved when the transport is created and again when the simulation starts,
+   * so that getSendQueueLength() does not go through the attribute system for every outgoing
+   * packet.  A queue replaced while the simulation is running (e.g., by setting the "TxQueue"
+   * attribute of the NetDevice from a scheduled event) is not noticed until this method is
+   * called.
+   */
+  void
+  rebindTxQueue();
+
+  /**
+   * \brief Pass NDN packets over the NetDevice by reference instead of serializing them
+   *
+   * Outgoing packets carry SharedBlockTag and a virtual payload, so the wire encoding is not
+   * copied into the ns-3 buffer on every hop.  Only PointToPointNetDevice is supported, as
+   * each packet needs to be consumed by exactly one receiver or reported by a drop trace.
+   * Incoming packets are accepted in either form regardless of this setting.  Packets are
+   * serialized as usual while the remote node has no NDN face on the link.
+   *
+   * \warning Pcap traces of the device will contain zero-filled payload
+   * \return whether shared-wire mode has been enabled
+   */
+  bool
+  enableSharedWire();
+
+  /**
+   * \brief Enable or disable the transport
+   *
+   * A disabled transport is DOWN and neither sends nor receives packets, e.g., while the node
+   * is not part of the simulated area.  Transports are enabled when they are created.
+   */
+  void
+  setEnabled(bool isEnabled);
+
 private:
   virtual void
   doClose() override;
@@ -64,6 +102,15 @@ private:
   virtual void
   doSend(const Block& packet, const nfd::EndpointId& endpoint) override;
 
+  /**
+   * \brief Check whether the remote node has an NDN face on the other end of the link
+   *
+   * A positive result is cached, so the face table of the remote node is searched only until
+   * its face has been created.
+   */
+  bool
+  hasRemoteHandler();
+
   void
   receiveFromNetDevice(Ptr<NetDevice> device,
                        Ptr<const ns3::Packet> p,
@@ -73,6 +120,11 @@ private:
 
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
+  Ptr<ns3::QueueBase> m_txQueue; ///< \brief Cached transmit queue of the NetDevice, if any
+  EventId m_rebindTxQueueEvent;
+  bool m_isSharedWire = false;
+  Ptr<NetDevice> m_remoteNetDevice; ///< \brief NetDevice on the other end of a shared wire
+  bool m_hasRemoteHandler = false;
 };
 
 } // namespace ndn
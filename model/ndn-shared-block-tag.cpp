@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-shared-block-tag.hpp"
+
+#include "ns3/simulator.h"
+
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(SharedBlockTag);
+
+using BlockRegistry = std::unordered_map<uint64_t, Block>;
+
+static BlockRegistry&
+getRegistry()
+{
+  static BlockRegistry registry;
+  return registry;
+}
+
+static uint64_t g_lastId = 0;
+static bool g_isResetScheduled = false;
+
+/**
+ * \brief Drop blocks of packets that were still in flight when the simulation was destroyed
+ */
+static void
+resetRegistry()
+{
+  getRegistry().clear();
+  g_isResetScheduled = false;
+}
+
+TypeId
+SharedBlockTag::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::SharedBlockTag")
+    .SetGroupName("Ndn")
+    .SetParent<Tag>()
+    .AddConstructor<SharedBlockTag>()
+    ;
+  return tid;
+}
+
+TypeId
+SharedBlockTag::GetInstanceTypeId() const
+{
+  return GetTypeId();
+}
+
+uint32_t
+SharedBlockTag::GetSerializedSize() const
+{
+  return sizeof(uint64_t);
+}
+
+void
+SharedBlockTag::Serialize(TagBuffer i) const
+{
+  i.WriteU64(m_id);
+}
+
+void
+SharedBlockTag::Deserialize(TagBuffer i)
+{
+  m_id = i.ReadU64();
+}
+
+void
+SharedBlockTag::Print(std::ostream& os) const
+{
+  os << "SharedBlock=" << m_id;
+}
+
+Ptr<Packet>
+SharedBlockTag::CreatePacket(const Block& block)
+{
+  if (!g_isResetScheduled) {
+    Simulator::ScheduleDestroy(&resetRegistry);
+    g_isResetScheduled = true;
+  }
+
+  SharedBlockTag tag;
+  tag.m_id = ++g_lastId;
+  getRegistry().emplace(tag.m_id, block);
+
+  Ptr<Packet> packet = Create<Packet>(block.size());
+  packet->AddPacketTag(tag);
+  return packet;
+}
+
+bool
+SharedBlockTag::ExtractBlock(Ptr<const Packet> packet, Block& block)
+{
+  SharedBlockTag tag;
+  if (!packet->PeekPacketTag(tag)) {
+    return false;
+  }
+
+  auto& registry = getRegistry();
+  auto it = registry.find(tag.m_id);
+  if (it == registry.end()) {
+    return false;
+  }
+
+  block = std::move(it->second);
+  registry.erase(it);
+  return true;
+}
+
+void
+SharedBlockTag::Release(Ptr<const Packet> packet)
+{
+  SharedBlockTag tag;
+  if (packet->PeekPacketTag(tag)) {
+    getRegistry().erase(tag.m_id);
+  }
+}
+
+size_t
+SharedBlockTag::GetNInFlight()
+{
+  return getRegistry().size();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_NDN_SHARED_BLOCK_TAG_HPP
+#define NDNSIM_NDN_SHARED_BLOCK_TAG_HPP
+
+#include "ns3/tag.h"
+#include "ns3/packet.h"
+
+#include "ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-face
+ * \brief ns-3 packet tag to pass an NDN packet over a NetDevice by reference
+ *
+ * A packet created by CreatePacket() has a virtual (zero-filled) payload of the same size as
+ * the NDN block, so that devices, queues, and channels account for the correct number of
+ * bytes, while no byte of the block is copied into the ns-3 buffer.  The block itself, i.e.,
+ * a reference to its ndn::Buffer, is kept in a registry until the receiving side takes it out
+ * with ExtractBlock(), or the packet is reported as dropped with Release().
+ *
+ * \warning Byte-level consumers of the ns-3 packet (e.g., pcap traces) see zero-filled payload
+ */
+class SharedBlockTag : public Tag {
+public:
+  static TypeId
+  GetTypeId();
+
+  virtual TypeId
+  GetInstanceTypeId() const;
+
+  virtual uint32_t
+  GetSerializedSize() const;
+
+  virtual void
+  Serialize(TagBuffer i) const;
+
+  virtual void
+  Deserialize(TagBuffer i);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+public:
+  /**
+   * \brief Create ns-3 packet that carries \p block by reference
+   */
+  static Ptr<Packet>
+  CreatePacket(const Block& block);
+
+  /**
+   * \brief Take the NDN block out of the ns-3 packet created by CreatePacket()
+   * \retval false the packet does not carry the tag, or the block has already been taken out
+   */
+  static bool
+  ExtractBlock(Ptr<const Packet> packet, Block& block);
+
+  /**
+   * \brief Release the NDN block referenced by a dropped ns-3 packet
+   *
+   * Packets without the tag are ignored
+   */
+  static void
+  Release(Ptr<const Packet> packet);
+
+  /**
+   * \brief Get number of NDN blocks that are currently referenced by packets in flight
+   */
+  static size_t
+  GetNInFlight();
+
+private:
+  uint64_t m_id = 0;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_NDN_SHARED_BLOCK_TAG_HPP
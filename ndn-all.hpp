@@ -24,6 +24,7 @@
 #include "ns3/ndnSIM/helper/ndn-app-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-global-routing-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-network-region-table-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-sumo-mobility-helper.hpp"
 // #include "ns3/ndnSIM/helper/ndn-ip-faces-helper.hpp"
 // #include "ns3/ndnSIM/helper/ndn-link-control-helper.hpp"
 
@@ -34,6 +35,8 @@
 #include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-cs-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-resource-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-sink.hpp"
 
 // #include "ns3/ndnSIM/model/ndn-app-face.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_LP_FIXED_WIDTH_ENCODING_HPP
+#define NDN_CXX_LP_FIXED_WIDTH_ENCODING_HPP
+
+#include "ndn-cxx/encoding/tlv.hpp"
+
+#include <boost/endian/conversion.hpp>
+
+#include <cstring>
+#include <limits>
+
+namespace ndn {
+namespace lp {
+namespace detail {
+
+/** \brief helpers for fields packed at fixed offsets inside the value of a single TLV element
+ *
+ *  Integers and IEEE-754 doubles are stored in network byte order.  They can be read directly
+ *  from the wire, without parsing sub-elements or allocating memory.
+ */
+
+static_assert(std::numeric_limits<double>::is_iec559, "This code requires IEEE-754 doubles");
+
+inline uint8_t*
+writeUint32(uint8_t* pos, uint32_t value)
+{
+  boost::endian::native_to_big_inplace(value);
+  std::memcpy(pos, &value, sizeof(value));
+  return pos + sizeof(value);
+}
+
+inline uint32_t
+readUint32(const uint8_t* pos)
+{
+  uint32_t value = 0;
+  std::memcpy(&value, pos, sizeof(value));
+  return boost::endian::big_to_native(value);
+}
+
+inline uint8_t*
+writeDouble(uint8_t* pos, double value)
+{
+  uint64_t temp = 0;
+  std::memcpy(&temp, &value, sizeof(temp));
+  boost::endian::native_to_big_inplace(temp);
+  std::memcpy(pos, &temp, sizeof(temp));
+  return pos + sizeof(temp);
+}
+
+inline double
+readDouble(const uint8_t* pos)
+{
+  uint64_t temp = 0;
+  std::memcpy(&temp, pos, sizeof(temp));
+  boost::endian::big_to_native_inplace(temp);
+  double value = 0;
+  std::memcpy(&value, &temp, sizeof(value));
+  return value;
+}
+
+/** \return size of a TLV element with the given TLV-TYPE and TLV-LENGTH
+ */
+constexpr size_t
+sizeOfBlock(uint64_t type, size_t length)
+{
+  return ndn::tlv::sizeOfVarNumber(type) + ndn::tlv::sizeOfVarNumber(length) + length;
+}
+
+} // namespace detail
+} // namespace lp
+} // namespace ndn
+
+#endif // NDN_CXX_LP_FIXED_WIDTH_ENCODING_HPP
@@ -20,11 +20,14 @@
  */
 
 #include "ndn-cxx/lp/geo-tag.hpp"
+#include "ndn-cxx/lp/fixed-width-encoding.hpp"
 #include "ndn-cxx/lp/tlv.hpp"
 
 namespace ndn {
 namespace lp {
 
+constexpr size_t GeoTag::VALUE_SIZE;
+
 GeoTag::GeoTag(const Block& block)
 {
   wireDecode(block);
@@ -34,13 +37,12 @@ template<encoding::Tag TAG>
 size_t
 GeoTag::wireEncode(EncodingImpl<TAG>& encoder) const
 {
-  size_t length = 0;
-  length += prependDoubleBlock(encoder, tlv::GeoTagPos, std::get<2>(m_pos));
-  length += prependDoubleBlock(encoder, tlv::GeoTagPos, std::get<1>(m_pos));
-  length += prependDoubleBlock(encoder, tlv::GeoTagPos, std::get<0>(m_pos));
-  length += encoder.prependVarNumber(length);
-  length += encoder.prependVarNumber(tlv::GeoTag);
-  return length;
+  uint8_t value[VALUE_SIZE];
+  uint8_t* pos = value;
+  pos = detail::writeDouble(pos, std::get<0>(m_pos));
+  pos = detail::writeDouble(pos, std::get<1>(m_pos));
+  detail::writeDouble(pos, std::get<2>(m_pos));
+  return encoder.prependByteArrayBlock(tlv::GeoTag, value, VALUE_SIZE);
 }
 
 template size_t
@@ -56,10 +58,7 @@ GeoTag::wireEncode() const
     return m_wire;
   }
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
+  EncodingBuffer buffer(detail::sizeOfBlock(tlv::GeoTag, VALUE_SIZE), 0);
   wireEncode(buffer);
 
   m_wire = buffer.block();
@@ -73,19 +72,15 @@ GeoTag::wireDecode(const Block& wire)
   if (wire.type() != tlv::GeoTag) {
     NDN_THROW(ndn::tlv::Error("expecting GeoTag block"));
   }
-
-  m_wire = wire;
-  m_wire.parse();
-
-  if (m_wire.elements().size() < 3 ||
-      m_wire.elements()[0].type() != tlv::GeoTagPos ||
-      m_wire.elements()[1].type() != tlv::GeoTagPos ||
-      m_wire.elements()[2].type() != tlv::GeoTagPos) {
+  if (wire.value_size() != VALUE_SIZE) {
     NDN_THROW(ndn::tlv::Error("Unexpected input while decoding GeoTag"));
   }
-  m_pos = {encoding::readDouble(m_wire.elements()[0]),
-           encoding::readDouble(m_wire.elements()[1]),
-           encoding::readDouble(m_wire.elements()[2])};
+
+  const uint8_t* pos = wire.value();
+  m_pos = {detail::readDouble(pos),
+           detail::readDouble(pos + 8),
+           detail::readDouble(pos + 16)};
+  m_wire = wire;
 }
 
 } // namespace lp
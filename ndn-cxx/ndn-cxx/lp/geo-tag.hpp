@@ -31,6 +31,9 @@ namespace lp {
 
 /**
  * \brief represents a GeoTag header field
+ *
+ * The TLV-VALUE has a fixed size: the x, y, and z coordinates as IEEE-754 doubles in network
+ * byte order.
  */
 class GeoTag : public Tag
 {
@@ -88,9 +91,13 @@ public: // get & set GeoTag
   setPosX(std::tuple<double, double, double> pos)
   {
     m_pos = pos;
+    m_wire.reset();
     return this;
   }
 
+public:
+  static constexpr size_t VALUE_SIZE = 3 * sizeof(double);
+
 private:
   std::tuple<double, double, double> m_pos = {0.0, 0.0, 0.0};
   mutable Block m_wire;
@@ -1,10 +1,12 @@
 #include "ndn-cxx/lp/neighbor-tag.hpp"
+#include "ndn-cxx/lp/fixed-width-encoding.hpp"
 #include "ndn-cxx/lp/tlv.hpp"
-#include <iostream>
 
 namespace ndn {
 namespace lp {
 
+constexpr size_t NeighborTag::VALUE_SIZE;
+
 NeighborTag::NeighborTag(const Block& block)
 {
   wireDecode(block);
@@ -14,15 +16,13 @@ template<encoding::Tag TAG>
 size_t
 NeighborTag::wireEncode(EncodingImpl<TAG>& encoder) const
 {
-    
-  size_t length = 0;
-  length += prependNonNegativeIntegerBlock(encoder, tlv::NeighborTagId, m_neighbor.first);
-  length += prependDoubleBlock(encoder, tlv::NeighborTagPos, std::get<2>(m_neighbor.second));
-  length += prependDoubleBlock(encoder, tlv::NeighborTagPos, std::get<1>(m_neighbor.second));
-  length += prependDoubleBlock(encoder, tlv::NeighborTagPos, std::get<0>(m_neighbor.second));
-  length += encoder.prependVarNumber(length);
-  length += encoder.prependVarNumber(tlv::NeighborTag);
-  return length;
+  uint8_t value[VALUE_SIZE];
+  uint8_t* pos = value;
+  pos = detail::writeUint32(pos, m_neighbor.first);
+  pos = detail::writeDouble(pos, std::get<0>(m_neighbor.second));
+  pos = detail::writeDouble(pos, std::get<1>(m_neighbor.second));
+  detail::writeDouble(pos, std::get<2>(m_neighbor.second));
+  return encoder.prependByteArrayBlock(tlv::NeighborTag, value, VALUE_SIZE);
 }
 
 template size_t
@@ -38,10 +38,7 @@ NeighborTag::wireEncode() const
     return m_wire;
   }
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
+  EncodingBuffer buffer(detail::sizeOfBlock(tlv::NeighborTag, VALUE_SIZE), 0);
   wireEncode(buffer);
 
   m_wire = buffer.block();
@@ -55,28 +52,16 @@ NeighborTag::wireDecode(const Block& wire)
   if (wire.type() != tlv::NeighborTag) {
     NDN_THROW(ndn::tlv::Error("expecting NeighborTag block"));
   }
-
-  m_wire = wire;
-  m_wire.parse();
-
-
-  if (m_wire.elements().size() < 4 ||
-      m_wire.elements()[0].type() != tlv::NeighborTagPos ||
-      m_wire.elements()[1].type() != tlv::NeighborTagPos ||
-      m_wire.elements()[2].type() != tlv::NeighborTagPos ||
-      m_wire.elements()[3].type() != tlv::NeighborTagId) {
+  if (wire.value_size() != VALUE_SIZE) {
     NDN_THROW(ndn::tlv::Error("Unexpected input while decoding NeighborTag"));
   }
-  
-  m_neighbor = {
-      encoding::readNonNegativeInteger(m_wire.elements()[3]),
-      {
-          encoding::readDouble(m_wire.elements()[0]),
-          encoding::readDouble(m_wire.elements()[1]),
-          encoding::readDouble(m_wire.elements()[2])
-      }
-  };
-    
+
+  const uint8_t* pos = wire.value();
+  m_neighbor = {detail::readUint32(pos),
+                {detail::readDouble(pos + 4),
+                 detail::readDouble(pos + 12),
+                 detail::readDouble(pos + 20)}};
+  m_wire = wire;
 }
 
 } // namespace lp
@@ -9,7 +9,10 @@ namespace ndn {
 namespace lp {
 
 /**
- * \brief represents a GeoTag header field
+ * \brief represents a NeighborTag header field
+ *
+ * The TLV-VALUE has a fixed size: the 32-bit node id followed by the x, y, and z coordinates as
+ * IEEE-754 doubles, all in network byte order.
  */
 class NeighborTag : public Tag
 {
@@ -67,9 +70,13 @@ public: // get & set NeighborTag
   setNeighbor(std::pair<uint32_t, std::tuple<double, double, double>> neighbor)
   {
     m_neighbor = neighbor;
+    m_wire.reset();
     return this;
   }
 
+public:
+  static constexpr size_t VALUE_SIZE = sizeof(uint32_t) + 3 * sizeof(double);
+
 private:
   std::pair<uint32_t, std::tuple<double, double, double>> m_neighbor;
   mutable Block m_wire;
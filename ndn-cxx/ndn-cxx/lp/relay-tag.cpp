@@ -1,10 +1,12 @@
 #include "ndn-cxx/lp/relay-tag.hpp"
+#include "ndn-cxx/lp/fixed-width-encoding.hpp"
 #include "ndn-cxx/lp/tlv.hpp"
-#include <iostream>
 
 namespace ndn {
 namespace lp {
 
+constexpr size_t RelayTag::ID_SIZE;
+
 RelayTag::RelayTag(const Block& block)
 {
   wireDecode(block);
@@ -14,12 +16,15 @@ template<encoding::Tag TAG>
 size_t
 RelayTag::wireEncode(EncodingImpl<TAG>& encoder) const
 {
-  if (m_relays.size() == 0) BOOST_THROW_EXCEPTION(ndn::tlv::Error("Relays Set must not be empty"));
+  if (m_relays.empty()) {
+    NDN_THROW(ndn::tlv::Error("Relays Set must not be empty"));
+  }
 
   size_t length = 0;
-  for (size_t i = 0; i < m_relays.size(); i++)
-  {
-    length += prependNonNegativeIntegerBlock(encoder, tlv::RelayTagId, m_relays.at(i));
+  for (auto it = m_relays.rbegin(); it != m_relays.rend(); ++it) {
+    uint8_t id[ID_SIZE];
+    detail::writeUint32(id, *it);
+    length += encoder.prependByteArray(id, ID_SIZE);
   }
   length += encoder.prependVarNumber(length);
   length += encoder.prependVarNumber(tlv::RelayTag);
@@ -39,10 +44,7 @@ RelayTag::wireEncode() const
     return m_wire;
   }
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
+  EncodingBuffer buffer(detail::sizeOfBlock(tlv::RelayTag, m_relays.size() * ID_SIZE), 0);
   wireEncode(buffer);
 
   m_wire = buffer.block();
@@ -56,23 +58,17 @@ RelayTag::wireDecode(const Block& wire)
   if (wire.type() != tlv::RelayTag) {
     NDN_THROW(ndn::tlv::Error("expecting RelayTag block"));
   }
-
-  m_wire = wire;
-  m_wire.parse();
-
-  if (m_wire.elements().size() == 0) {
+  if (wire.value_size() == 0 || wire.value_size() % ID_SIZE != 0) {
     NDN_THROW(ndn::tlv::Error("Unexpected input while decoding RelayTag"));
   }
 
-  std::vector<uint32_t> r;
-  Block::element_const_iterator it;
-  for (it = m_wire.elements_begin(); it != m_wire.elements_end(); it++)
-  {
-
-    r.push_back(static_cast<uint32_t>(readNonNegativeInteger(*it)));
+  m_relays.resize(wire.value_size() / ID_SIZE);
+  const uint8_t* pos = wire.value();
+  for (uint32_t& relay : m_relays) {
+    relay = detail::readUint32(pos);
+    pos += ID_SIZE;
   }
-  m_relays = r;
-
+  m_wire = wire;
 }
 
 } // namespace lp
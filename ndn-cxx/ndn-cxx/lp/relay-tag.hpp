@@ -9,7 +9,9 @@ namespace ndn {
 namespace lp {
 
 /**
- * \brief represents a GeoTag header field
+ * \brief represents a RelayTag header field
+ *
+ * The TLV-VALUE is the list of 32-bit relay ids in network byte order, without sub-elements.
  */
 class RelayTag : public Tag
 {
@@ -67,9 +69,13 @@ public: // get & set NeighborTag
   setRelays(std::vector<uint32_t> r)
   {
     m_relays = r;
+    m_wire.reset();
     return this;
   }
 
+public:
+  static constexpr size_t ID_SIZE = sizeof(uint32_t);
+
 private:
   std::vector<uint32_t> m_relays;
   mutable Block m_wire;
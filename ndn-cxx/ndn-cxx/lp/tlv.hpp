@@ -36,13 +36,9 @@ enum {
   FragIndex = 82,
   FragCount = 83,
   HopCountTag = 84,
-  GeoTag = 85,
-  GeoTagPos = 85, // inner fields inside GeoTag
-  NeighborTag = 90,
-  NeighborTagId = 90, // inner field (Neighbor ID) inside NeighborTag
-  NeighborTagPos = 90, // inner field (Neighbor Location) inside NeighborTag
-  RelayTag = 93,
-  RelayTagId = 93, // inner fields inside RelayTag
+  GeoTag = 85, // fixed-width value, see GeoTag
+  NeighborTag = 90, // fixed-width value, see NeighborTag
+  RelayTag = 93, // array of 32-bit ids, see RelayTag
   SelectedNeighborTag = 96,
   PitToken = 98,
   Nack = 800,
@@ -21,6 +21,7 @@
 
 #include "ndn-cxx/util/scheduler.hpp"
 
+#include <boost/pool/pool_alloc.hpp>
 #include <boost/scope_exit.hpp>
 
 namespace ndn {
@@ -31,10 +32,11 @@ namespace scheduler {
 class EventInfo : noncopyable
 {
 public:
-  EventInfo(time::nanoseconds after, EventCallback&& cb, uint32_t context)
+  EventInfo(time::nanoseconds after, EventCallback&& cb, Scheduler::EventQueue& queue, uint64_t seq)
     : callback(std::move(cb))
     , expireTime(time::steady_clock::now() + after)
-    , context(context)
+    , queue(&queue)
+    , seq(seq)
   {
   }
 
@@ -46,10 +48,147 @@ public:
 
 public:
   EventCallback callback;
-  Scheduler::EventQueue::const_iterator queueIt;
   time::steady_clock::TimePoint expireTime;
+  Scheduler::EventQueue* queue;
+  uint64_t seq; ///< tie breaker, so that events with the same expireTime execute in FIFO order
+  size_t heapIndex = 0;
   bool isExpired = false;
-  uint32_t context = 0;
+};
+
+/** \brief Allocates EventInfo, together with its shared_ptr control block, from a pool
+ *
+ *  Scheduler is not thread safe, therefore the pool needs no locking.
+ */
+using EventInfoAllocator = boost::fast_pool_allocator<EventInfo,
+                                                      boost::default_user_allocator_new_delete,
+                                                      boost::details::pool::null_mutex>;
+
+/** \brief Events of one ns-3 context, in a d-ary min-heap ordered by (expireTime, seq)
+ *
+ *  Each EventInfo knows its position in the heap, so that it can be canceled in O(log n).
+ */
+class Scheduler::EventQueue : noncopyable
+{
+public:
+  explicit
+  EventQueue(uint32_t context)
+    : context(context)
+  {
+  }
+
+  bool
+  empty() const
+  {
+    return m_heap.empty();
+  }
+
+  const shared_ptr<EventInfo>&
+  top() const
+  {
+    return m_heap.front();
+  }
+
+  void
+  push(shared_ptr<EventInfo> info)
+  {
+    info->heapIndex = m_heap.size();
+    m_heap.push_back(std::move(info));
+    siftUp(m_heap.size() - 1);
+  }
+
+  void
+  erase(EventInfo& info)
+  {
+    size_t i = info.heapIndex;
+    BOOST_ASSERT(i < m_heap.size() && m_heap[i].get() == &info);
+
+    if (i != m_heap.size() - 1) {
+      place(i, std::move(m_heap.back()));
+      m_heap.pop_back();
+      if (i > 0 && isEarlier(*m_heap[i], *m_heap[parent(i)])) {
+        siftUp(i);
+      }
+      else {
+        siftDown(i);
+      }
+    }
+    else {
+      m_heap.pop_back();
+    }
+  }
+
+  void
+  clear()
+  {
+    m_heap.clear();
+  }
+
+private:
+  static constexpr size_t ARITY = 4;
+
+  static size_t
+  parent(size_t i)
+  {
+    return (i - 1) / ARITY;
+  }
+
+  static bool
+  isEarlier(const EventInfo& a, const EventInfo& b)
+  {
+    return a.expireTime < b.expireTime || (a.expireTime == b.expireTime && a.seq < b.seq);
+  }
+
+  void
+  place(size_t i, shared_ptr<EventInfo> info)
+  {
+    info->heapIndex = i;
+    m_heap[i] = std::move(info);
+  }
+
+  void
+  siftUp(size_t i)
+  {
+    shared_ptr<EventInfo> info = std::move(m_heap[i]);
+    while (i > 0 && isEarlier(*info, *m_heap[parent(i)])) {
+      place(i, std::move(m_heap[parent(i)]));
+      i = parent(i);
+    }
+    place(i, std::move(info));
+  }
+
+  void
+  siftDown(size_t i)
+  {
+    shared_ptr<EventInfo> info = std::move(m_heap[i]);
+    while (true) {
+      size_t first = i * ARITY + 1;
+      if (first >= m_heap.size()) {
+        break;
+      }
+      size_t last = std::min(first + ARITY, m_heap.size());
+      size_t earliest = first;
+      for (size_t child = first + 1; child < last; ++child) {
+        if (isEarlier(*m_heap[child], *m_heap[earliest])) {
+          earliest = child;
+        }
+      }
+      if (!isEarlier(*m_heap[earliest], *info)) {
+        break;
+      }
+      place(i, std::move(m_heap[earliest]));
+      i = earliest;
+    }
+    place(i, std::move(info));
+  }
+
+public:
+  const uint32_t context;
+  bool isExecuting = false;
+  ns3::EventId timerEvent;
+  time::steady_clock::TimePoint timerExpireTime = time::steady_clock::TimePoint::max();
+
+private:
+  std::vector<shared_ptr<EventInfo>> m_heap;
 };
 
 EventId::EventId(Scheduler& sched, weak_ptr<EventInfo> info)
@@ -76,13 +215,6 @@ operator<<(std::ostream& os, const EventId& eventId)
   return os << eventId.m_info.lock();
 }
 
-bool
-Scheduler::EventQueueCompare::operator()(const shared_ptr<EventInfo>& a,
-                                         const shared_ptr<EventInfo>& b) const noexcept
-{
-  return a->expireTime < b->expireTime;
-}
-
 Scheduler::Scheduler(DummyIoService& ioService)
 {
 }
@@ -92,20 +224,37 @@ Scheduler::~Scheduler()
   cancelAllEvents();
 }
 
+Scheduler::EventQueue&
+Scheduler::getQueue(uint32_t context)
+{
+  if (m_lastQueue != nullptr && m_lastQueue->context == context) {
+    return *m_lastQueue;
+  }
+
+  auto& queue = m_queues[context];
+  if (queue == nullptr) {
+    queue = make_unique<EventQueue>(context);
+  }
+  m_lastQueue = queue.get();
+  return *queue;
+}
+
 EventId
 Scheduler::schedule(time::nanoseconds after, EventCallback callback)
 {
   BOOST_ASSERT(callback != nullptr);
 
-  auto i = m_queue.insert(make_shared<EventInfo>(after, std::move(callback), ns3::Simulator::GetContext()));
-  (*i)->queueIt = i;
+  EventQueue& queue = getQueue(ns3::Simulator::GetContext());
+  auto info = std::allocate_shared<EventInfo>(EventInfoAllocator(), after, std::move(callback),
+                                              queue, ++m_nScheduledEvents);
+  EventId eventId(*this, info);
+  queue.push(std::move(info));
 
-  if (!m_isEventExecuting && i == m_queue.begin()) {
-    // the new event is the first one to expire
-    this->scheduleNext();
+  if (!queue.isExecuting) {
+    this->scheduleNext(queue);
   }
 
-  return EventId(*this, *i);
+  return eventId;
 }
 
 void
@@ -115,68 +264,72 @@ Scheduler::cancelImpl(const shared_ptr<EventInfo>& info)
     return;
   }
 
-  if (m_timerEvent) {
-    if (!m_timerEvent->IsExpired()) {
-      ns3::Simulator::Remove(*m_timerEvent);
-    }
-    m_timerEvent.reset();
-  }
-  m_queue.erase(info->queueIt);
-
-  if (!m_isEventExecuting) {
-    this->scheduleNext();
-  }
+  // The timer is left in place even if the canceled event was the earliest one:
+  // when it fires, executeEvent() finds nothing expired and schedules the next event.
+  info->queue->erase(*info);
+  info->isExpired = true;
 }
 
 void
 Scheduler::cancelAllEvents()
 {
-  m_queue.clear();
-  if (m_timerEvent) {
-    if (!m_timerEvent->IsExpired()) {
-      ns3::Simulator::Remove(*m_timerEvent);
+  for (auto& item : m_queues) {
+    EventQueue& queue = *item.second;
+    queue.clear();
+    if (!queue.timerEvent.IsExpired()) {
+      ns3::Simulator::Remove(queue.timerEvent);
     }
-    m_timerEvent.reset();
+    queue.timerExpireTime = time::steady_clock::TimePoint::max();
   }
 }
 
 void
-Scheduler::scheduleNext()
+Scheduler::scheduleNext(EventQueue& queue)
 {
-  if (!m_queue.empty()) {
-    m_timerEvent = ns3::Simulator::Schedule(ns3::NanoSeconds((*m_queue.begin())->expiresFromNow().count()),
-                                            &Scheduler::executeEvent, this);
+  // a queue is only modified by schedule() and executeEvent(), which both run in its context,
+  // so that the timer scheduled here executes in that context as well
+  BOOST_ASSERT(ns3::Simulator::GetContext() == queue.context);
+
+  if (queue.empty()) {
+    return;
+  }
+
+  const EventInfo& head = *queue.top();
+  if (!queue.timerEvent.IsExpired()) {
+    if (queue.timerExpireTime <= head.expireTime) {
+      // the pending timer fires no later than the earliest event
+      return;
+    }
+    ns3::Simulator::Remove(queue.timerEvent);
   }
+
+  queue.timerExpireTime = head.expireTime;
+  queue.timerEvent = ns3::Simulator::Schedule(ns3::NanoSeconds(head.expiresFromNow().count()),
+                                              &Scheduler::executeEvent, this, &queue);
 }
 
 void
-Scheduler::executeEvent()
+Scheduler::executeEvent(EventQueue* queue)
 {
-  m_isEventExecuting = true;
+  queue->isExecuting = true;
+  queue->timerExpireTime = time::steady_clock::TimePoint::max();
 
-  m_timerEvent.reset();
-  BOOST_SCOPE_EXIT(this_) {
-    this_->m_isEventExecuting = false;
-    this_->scheduleNext();
+  BOOST_SCOPE_EXIT(this_, queue) {
+    queue->isExecuting = false;
+    this_->scheduleNext(*queue);
   } BOOST_SCOPE_EXIT_END
 
   // process all expired events
   auto now = time::steady_clock::now();
-  while (!m_queue.empty()) {
-    auto head = m_queue.begin();
-    shared_ptr<EventInfo> info = *head;
+  while (!queue->empty()) {
+    shared_ptr<EventInfo> info = queue->top();
     if (info->expireTime > now) {
       break;
     }
 
-    m_queue.erase(head);
+    queue->erase(*info);
     info->isExpired = true;
-    if (ns3::Simulator::GetContext() == info->context) {
-      info->callback();
-    }
-    else {
-      ns3::Simulator::ScheduleWithContext(info->context, ns3::Seconds(0), ns3::MakeEvent(info->callback));
-    }
+    info->callback();
   }
 }
 
@@ -28,7 +28,7 @@
 
 #include "ns3/simulator.h"
 
-#include <set>
+#include <unordered_map>
 
 namespace ndn {
 
@@ -128,6 +128,13 @@ operator<<(std::ostream& os, const EventId& eventId);
 using ScopedEventId = detail::ScopedCancelHandle<EventId>;
 
 /** \brief Generic time-based scheduler
+ *
+ *  Events are kept in one queue per ns-3 context (i.e., per node), and each queue drives its
+ *  own ns-3 timer, so that an event always executes in the context that scheduled it, and
+ *  scheduling an event on one node does not reschedule the timers of others. Canceling an
+ *  event never reschedules a timer; a timer that finds no expired event is simply rearmed.
+ *  Each queue is a d-ary heap of pooled events; events with the same expiration time
+ *  execute in the order they were scheduled.
  */
 class Scheduler : noncopyable
 {
@@ -149,32 +156,30 @@ public:
   cancelAllEvents();
 
 private:
+  class EventQueue;
+
   void
   cancelImpl(const shared_ptr<EventInfo>& info);
 
-  /** \brief Schedule the next event on the internal timer
+  /** \brief Get the event queue of an ns-3 context, creating it if necessary
+   */
+  EventQueue&
+  getQueue(uint32_t context);
+
+  /** \brief Schedule the earliest event of \p queue on its timer
    */
   void
-  scheduleNext();
+  scheduleNext(EventQueue& queue);
 
-  /** \brief Execute expired events
+  /** \brief Execute expired events of \p queue
    */
   void
-  executeEvent();
+  executeEvent(EventQueue* queue);
 
 private:
-  class EventQueueCompare
-  {
-  public:
-    bool
-    operator()(const shared_ptr<EventInfo>& a, const shared_ptr<EventInfo>& b) const noexcept;
-  };
-
-  using EventQueue = std::multiset<shared_ptr<EventInfo>, EventQueueCompare>;
-  EventQueue m_queue;
-
-  bool m_isEventExecuting = false;
-  ndn::optional<ns3::EventId> m_timerEvent;
+  std::unordered_map<uint32_t, unique_ptr<EventQueue>> m_queues;
+  EventQueue* m_lastQueue = nullptr; ///< queue of the most recent schedule() call
+  uint64_t m_nScheduledEvents = 0; ///< sequence number of the last scheduled event
 
   friend EventId;
   friend EventInfo;
@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MODULE ndn-cxx NDNLP GeoTag Benchmark
+#include "tests/boost-test.hpp"
+
+#include "ndn-cxx/lp/fields.hpp"
+#include "ndn-cxx/lp/packet.hpp"
+#include "tests/integrated/timed-execute.hpp"
+
+#include <boost/mpl/vector.hpp>
+
+#include <iostream>
+
+namespace ndn {
+namespace lp {
+namespace tests {
+
+using namespace ndn::tests;
+
+// GeoTag and NeighborTag as they were encoded before the fixed-width format:
+// one nested TLV element per coordinate and per id.
+class TlvGeoTag
+{
+public:
+  TlvGeoTag() = default;
+
+  explicit
+  TlvGeoTag(std::tuple<double, double, double> pos)
+    : m_pos(pos)
+  {
+  }
+
+  explicit
+  TlvGeoTag(const Block& wire)
+  {
+    wireDecode(wire);
+  }
+
+  template<encoding::Tag TAG>
+  size_t
+  wireEncode(EncodingImpl<TAG>& encoder) const
+  {
+    size_t length = 0;
+    length += prependDoubleBlock(encoder, tlv::GeoTag, std::get<2>(m_pos));
+    length += prependDoubleBlock(encoder, tlv::GeoTag, std::get<1>(m_pos));
+    length += prependDoubleBlock(encoder, tlv::GeoTag, std::get<0>(m_pos));
+    length += encoder.prependVarNumber(length);
+    length += encoder.prependVarNumber(tlv::GeoTag);
+    return length;
+  }
+
+  void
+  wireDecode(const Block& wire)
+  {
+    m_wire = wire;
+    m_wire.parse();
+    if (m_wire.elements().size() < 3) {
+      NDN_THROW(ndn::tlv::Error("Unexpected input while decoding GeoTag"));
+    }
+    m_pos = {encoding::readDouble(m_wire.elements()[0]),
+             encoding::readDouble(m_wire.elements()[1]),
+             encoding::readDouble(m_wire.elements()[2])};
+  }
+
+  std::tuple<double, double, double>
+  getPos() const
+  {
+    return m_pos;
+  }
+
+private:
+  std::tuple<double, double, double> m_pos;
+  Block m_wire;
+};
+
+class TlvNeighborTag
+{
+public:
+  TlvNeighborTag() = default;
+
+  explicit
+  TlvNeighborTag(std::pair<uint32_t, std::tuple<double, double, double>> neighbor)
+    : m_neighbor(neighbor)
+  {
+  }
+
+  explicit
+  TlvNeighborTag(const Block& wire)
+  {
+    wireDecode(wire);
+  }
+
+  template<encoding::Tag TAG>
+  size_t
+  wireEncode(EncodingImpl<TAG>& encoder) const
+  {
+    size_t length = 0;
+    length += prependNonNegativeIntegerBlock(encoder, tlv::NeighborTag, m_neighbor.first);
+    length += prependDoubleBlock(encoder, tlv::NeighborTag, std::get<2>(m_neighbor.second));
+    length += prependDoubleBlock(encoder, tlv::NeighborTag, std::get<1>(m_neighbor.second));
+    length += prependDoubleBlock(encoder, tlv::NeighborTag, std::get<0>(m_neighbor.second));
+    length += encoder.prependVarNumber(length);
+    length += encoder.prependVarNumber(tlv::NeighborTag);
+    return length;
+  }
+
+  void
+  wireDecode(const Block& wire)
+  {
+    m_wire = wire;
+    m_wire.parse();
+    if (m_wire.elements().size() < 4) {
+      NDN_THROW(ndn::tlv::Error("Unexpected input while decoding NeighborTag"));
+    }
+    m_neighbor = {static_cast<uint32_t>(readNonNegativeInteger(m_wire.elements()[3])),
+                  {encoding::readDouble(m_wire.elements()[0]),
+                   encoding::readDouble(m_wire.elements()[1]),
+                   encoding::readDouble(m_wire.elements()[2])}};
+  }
+
+  std::pair<uint32_t, std::tuple<double, double, double>>
+  getNeighbor() const
+  {
+    return m_neighbor;
+  }
+
+private:
+  std::pair<uint32_t, std::tuple<double, double, double>> m_neighbor;
+  Block m_wire;
+};
+
+struct TlvFormat
+{
+  using GeoTagType = TlvGeoTag;
+  using NeighborTagType = TlvNeighborTag;
+  using GeoTagField = FieldDecl<field_location_tags::Header, TlvGeoTag, tlv::GeoTag>;
+  using NeighborTagField = FieldDecl<field_location_tags::Header, TlvNeighborTag, tlv::NeighborTag>;
+  static constexpr const char* NAME = "tlv";
+};
+
+struct FixedWidthFormat
+{
+  using GeoTagType = GeoTag;
+  using NeighborTagType = NeighborTag;
+  using GeoTagField = lp::GeoTagField;
+  using NeighborTagField = lp::NeighborTagField;
+  static constexpr const char* NAME = "fixed-width";
+};
+
+using Formats = boost::mpl::vector<TlvFormat, FixedWidthFormat>;
+
+// Benchmark of the NDNLP headers added to neighbor discovery Data packets: every packet
+// carries the id and location of its sender in a NeighborTag, and its previous location in
+// a GeoTag.  Packets are encoded once by the sender and decoded by every receiver.
+// Run this benchmark with:
+//    ./lp-geo-tag-benchmark
+// For accurate results, it is required to compile ndn-cxx in release mode.
+BOOST_AUTO_TEST_CASE_TEMPLATE(NeighborDiscovery, Format, Formats)
+{
+  const int N_PACKETS = 200000;
+  const int N_RECEIVERS = 8;
+
+  const Block fragment = "5008 0000000000000000"_block;
+  std::vector<Block> wires(N_PACKETS);
+  auto encodeTime = timedExecute([&] {
+    for (int i = 0; i < N_PACKETS; ++i) {
+      Packet pkt(Block(tlv::LpPacket));
+      pkt.add<FragmentField>(std::make_pair(fragment.value_begin(), fragment.value_end()));
+      auto location = std::make_tuple(1000.0 + i, 2000.0 - i, 0.0);
+      pkt.add<typename Format::GeoTagField>(typename Format::GeoTagType(location));
+      pkt.add<typename Format::NeighborTagField>(
+        typename Format::NeighborTagType(std::make_pair(i, location)));
+      wires[i] = pkt.wireEncode();
+    }
+  });
+
+  double sum = 0;
+  int nDecoded = 0;
+  auto decodeTime = timedExecute([&] {
+    for (int r = 0; r < N_RECEIVERS; ++r) {
+      for (const Block& wire : wires) {
+        Packet pkt(wire);
+        auto geoTag = make_shared<typename Format::GeoTagType>(
+          pkt.get<typename Format::GeoTagField>());
+        auto neighborTag = make_shared<typename Format::NeighborTagType>(
+          pkt.get<typename Format::NeighborTagField>());
+        // use the values, so compiler won't optimize out their computation
+        sum += std::get<0>(geoTag->getPos()) + neighborTag->getNeighbor().first;
+        ++nDecoded;
+      }
+    }
+  });
+  BOOST_CHECK_EQUAL(nDecoded, N_PACKETS * N_RECEIVERS);
+  BOOST_CHECK_GT(sum, 0);
+
+  std::cout << Format::NAME
+            << " wire-size=" << wires.front().size()
+            << " encode=" << encodeTime / N_PACKETS
+            << "/packet decode=" << decodeTime / nDecoded << "/packet" << std::endl;
+}
+
+} // namespace tests
+} // namespace lp
+} // namespace ndn
@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/lp/geo-tag.hpp"
+#include "ndn-cxx/lp/packet.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndn {
+namespace lp {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Lp)
+BOOST_AUTO_TEST_SUITE(TestGeoTag)
+
+BOOST_AUTO_TEST_CASE(Encode)
+{
+  GeoTag tag(std::make_tuple(1.0, -2.5, 0.0));
+  BOOST_CHECK_EQUAL(tag.wireEncode(),
+                    "5518 3FF0000000000000 C004000000000000 0000000000000000"_block);
+
+  // setting a new position invalidates the cached wire
+  tag.setPosX(std::make_tuple(0.0, 0.0, 1.0));
+  BOOST_CHECK_EQUAL(tag.wireEncode(),
+                    "5518 0000000000000000 0000000000000000 3FF0000000000000"_block);
+}
+
+BOOST_AUTO_TEST_CASE(Decode)
+{
+  GeoTag tag("5518 3FF0000000000000 C004000000000000 0000000000000000"_block);
+  BOOST_CHECK(tag.getPos() == std::make_tuple(1.0, -2.5, 0.0));
+
+  BOOST_CHECK_THROW(GeoTag("5517 3FF0000000000000 C004000000000000 00000000000000"_block),
+                    ndn::tlv::Error);
+  BOOST_CHECK_THROW(GeoTag("5618 3FF0000000000000 C004000000000000 0000000000000000"_block),
+                    ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(PacketField)
+{
+  Packet pkt;
+  pkt.add<GeoTagField>(GeoTag(std::make_tuple(1234.5, 678.25, 0.0)));
+  Packet decoded(pkt.wireEncode());
+  BOOST_REQUIRE(decoded.has<GeoTagField>());
+  BOOST_CHECK(decoded.get<GeoTagField>().getPos() == std::make_tuple(1234.5, 678.25, 0.0));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestGeoTag
+BOOST_AUTO_TEST_SUITE_END() // Lp
+
+} // namespace tests
+} // namespace lp
+} // namespace ndn
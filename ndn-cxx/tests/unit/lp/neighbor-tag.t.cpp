@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/lp/neighbor-tag.hpp"
+#include "ndn-cxx/lp/packet.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndn {
+namespace lp {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Lp)
+BOOST_AUTO_TEST_SUITE(TestNeighborTag)
+
+BOOST_AUTO_TEST_CASE(Encode)
+{
+  NeighborTag tag(std::make_pair(7, std::make_tuple(1.0, -2.5, 0.0)));
+  BOOST_CHECK_EQUAL(tag.wireEncode(),
+                    "5A1C 00000007 3FF0000000000000 C004000000000000 0000000000000000"_block);
+
+  tag.setNeighbor(std::make_pair(0x01020304, std::make_tuple(0.0, 0.0, 1.0)));
+  BOOST_CHECK_EQUAL(tag.wireEncode(),
+                    "5A1C 01020304 0000000000000000 0000000000000000 3FF0000000000000"_block);
+}
+
+BOOST_AUTO_TEST_CASE(Decode)
+{
+  NeighborTag tag("5A1C 00000007 3FF0000000000000 C004000000000000 0000000000000000"_block);
+  BOOST_CHECK_EQUAL(tag.getNeighbor().first, 7);
+  BOOST_CHECK(tag.getNeighbor().second == std::make_tuple(1.0, -2.5, 0.0));
+
+  BOOST_CHECK_THROW(NeighborTag("5A18 3FF0000000000000 C004000000000000 0000000000000000"_block),
+                    ndn::tlv::Error);
+  BOOST_CHECK_THROW(NeighborTag("5B1C 00000007 3FF0000000000000 C004000000000000 0000000000000000"_block),
+                    ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(PacketField)
+{
+  Packet pkt;
+  pkt.add<NeighborTagField>(NeighborTag(std::make_pair(42, std::make_tuple(1234.5, 678.25, 0.0))));
+  Packet decoded(pkt.wireEncode());
+  BOOST_REQUIRE(decoded.has<NeighborTagField>());
+  auto neighbor = decoded.get<NeighborTagField>().getNeighbor();
+  BOOST_CHECK_EQUAL(neighbor.first, 42);
+  BOOST_CHECK(neighbor.second == std::make_tuple(1234.5, 678.25, 0.0));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestNeighborTag
+BOOST_AUTO_TEST_SUITE_END() // Lp
+
+} // namespace tests
+} // namespace lp
+} // namespace ndn
@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/lp/relay-tag.hpp"
+#include "ndn-cxx/lp/packet.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndn {
+namespace lp {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Lp)
+BOOST_AUTO_TEST_SUITE(TestRelayTag)
+
+BOOST_AUTO_TEST_CASE(Encode)
+{
+  RelayTag tag(std::vector<uint32_t>{1, 258});
+  BOOST_CHECK_EQUAL(tag.wireEncode(), "5D08 00000001 00000102"_block);
+
+  tag.setRelays({3});
+  BOOST_CHECK_EQUAL(tag.wireEncode(), "5D04 00000003"_block);
+
+  tag.setRelays({});
+  BOOST_CHECK_THROW(tag.wireEncode(), ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Decode)
+{
+  RelayTag tag("5D08 00000001 00000102"_block);
+  std::vector<uint32_t> expected{1, 258};
+  std::vector<uint32_t> actual = tag.getRelays();
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  BOOST_CHECK_THROW(RelayTag("5D00"_block), ndn::tlv::Error);
+  BOOST_CHECK_THROW(RelayTag("5D05 0000000102"_block), ndn::tlv::Error);
+  BOOST_CHECK_THROW(RelayTag("5E04 00000001"_block), ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(PacketField)
+{
+  Packet pkt;
+  pkt.add<RelayTagField>(RelayTag(std::vector<uint32_t>{5, 6, 7}));
+  Packet decoded(pkt.wireEncode());
+  BOOST_REQUIRE(decoded.has<RelayTagField>());
+  std::vector<uint32_t> expected{5, 6, 7};
+  std::vector<uint32_t> actual = decoded.get<RelayTagField>().getRelays();
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRelayTag
+BOOST_AUTO_TEST_SUITE_END() // Lp
+
+} // namespace tests
+} // namespace lp
+} // namespace ndn
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+"""Convert a binary trace written by ndn::BinaryTraceSink into tab-separated values
+
+The output is the same as the tracer would have written in text mode:
+
+    convert-trace.py rate-trace.bin > rate-trace.txt
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b'NDNTRC1\n'
+DOUBLE, INTEGER, STRING = 0, 1, 2
+FORMATS = {DOUBLE: 'd', INTEGER: 'q', STRING: 'I'}
+
+
+def read(f, fmt):
+    size = struct.calcsize(fmt)
+    data = f.read(size)
+    if len(data) != size:
+        raise EOFError('truncated trace')
+    return struct.unpack(fmt, data)
+
+
+def formatDouble(value):
+    # same as std::ostream with default precision
+    return '%g' % value
+
+
+def convert(f, out):
+    if f.read(len(MAGIC)) != MAGIC:
+        raise ValueError('not a binary trace')
+
+    (nColumns,) = read(f, '=I')
+    types = []
+    names = []
+    for _ in range(nColumns):
+        (columnType, length) = read(f, '=BI')
+        types.append(columnType)
+        names.append(f.read(length).decode())
+    out.write('\t'.join(names) + '\n')
+
+    strings = []
+    while True:
+        kind = f.read(1)
+        if not kind:
+            break
+        if kind == b'S':
+            (length,) = read(f, '=I')
+            strings.append(f.read(length).decode())
+        elif kind == b'R':
+            (nRows,) = read(f, '=I')
+            columns = []
+            for columnType in types:
+                values = read(f, '=%d%s' % (nRows, FORMATS[columnType]))
+                if columnType == DOUBLE:
+                    columns.append([formatDouble(v) for v in values])
+                elif columnType == INTEGER:
+                    columns.append([str(v) for v in values])
+                else:
+                    columns.append([strings[v] for v in values])
+            for row in zip(*columns):
+                out.write('\t'.join(row) + '\n')
+        else:
+            raise ValueError('unknown chunk %r' % kind)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('input', help='binary trace file')
+    parser.add_argument('output', nargs='?', help='text trace file (default: standard output)')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        if args.output:
+            with open(args.output, 'w') as out:
+                convert(f, out)
+        else:
+            convert(f, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
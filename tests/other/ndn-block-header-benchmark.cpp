@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-block-header-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/ndn-block-header.hpp"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+#include <boost/iostreams/concepts.hpp>
+#include <boost/iostreams/stream.hpp>
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * Microbenchmark comparing ways to turn a received ns-3 packet into an ndn::Block:
+ *
+ *  - "stream":   the original BlockHeader::Deserialize, which feeds the ns-3 buffer
+ *                byte-by-byte into Block::fromStream through boost::iostreams
+ *  - "header":   BlockHeader::Deserialize, which peeks TLV-TYPE and TLV-LENGTH and reads
+ *                the block into a pre-sized buffer
+ *  - "copydata": Packet::CopyData into a pre-sized buffer, as done by NetDeviceTransport
+ *
+ *     ./waf --run "ndn-block-header-benchmark --payload=1024 --iterations=1000000"
+ */
+
+namespace io = boost::iostreams;
+
+class Ns3BufferIteratorSource : public io::source {
+public:
+  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
+    : m_is(is)
+  {
+  }
+
+  std::streamsize
+  read(char* buf, std::streamsize nMaxRead)
+  {
+    std::streamsize i = 0;
+    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
+      buf[i] = m_is.ReadU8();
+    }
+    if (i == 0) {
+      return -1;
+    }
+    else {
+      return i;
+    }
+  }
+
+private:
+  ns3::Buffer::Iterator& m_is;
+};
+
+class StreamBlockHeader : public ndn::BlockHeader {
+public:
+  virtual uint32_t
+  Deserialize(ns3::Buffer::Iterator start) override
+  {
+    io::stream<Ns3BufferIteratorSource> is(start);
+    getBlock() = ::ndn::Block::fromStream(is);
+    return getBlock().size();
+  }
+};
+
+template<typename F>
+static void
+measure(const std::string& name, size_t nIterations, const F& decode)
+{
+  size_t nBytes = 0;
+  auto before = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < nIterations; ++i) {
+    nBytes += decode();
+  }
+  auto after = std::chrono::steady_clock::now();
+
+  double elapsed = std::chrono::duration<double>(after - before).count();
+  std::cout << name << "\t"
+            << elapsed << "\t"
+            << elapsed * 1e9 / nIterations << "\t"
+            << nBytes / elapsed / 1024.0 / 1024.0 << "\n";
+}
+
+int
+runBenchmark(int argc, char* argv[])
+{
+  uint32_t payloadSize = 1024;
+  uint32_t nIterations = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue("payload", "Size of Data payload in bytes", payloadSize);
+  cmd.AddValue("iterations", "Number of packets to decode with each decoder", nIterations);
+  cmd.Parse(argc, argv);
+
+  ndn::Data data("/benchmark/prefix/%00");
+  data.setContent(std::make_shared<::ndn::Buffer>(payloadSize));
+  ndn::StackHelper::getKeyChain().sign(data);
+  ::ndn::lp::Packet lpPacket(data.wireEncode());
+
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(ndn::BlockHeader(lpPacket.wireEncode()));
+
+  std::cout << "Decoder" << "\t"
+            << "Total (s)" << "\t"
+            << "Per packet (ns)" << "\t"
+            << "Throughput (MiB/s)" << "\n";
+
+  measure("stream", nIterations, [packet] {
+      StreamBlockHeader header;
+      packet->PeekHeader(header);
+      return header.getBlock().size();
+    });
+
+  measure("header", nIterations, [packet] {
+      ndn::BlockHeader header;
+      packet->PeekHeader(header);
+      return header.getBlock().size();
+    });
+
+  measure("copydata", nIterations, [packet] {
+      auto buffer = std::make_shared<::ndn::Buffer>(packet->GetSize());
+      packet->CopyData(buffer->data(), buffer->size());
+      return std::get<1>(::ndn::Block::fromBuffer(std::move(buffer), 0)).size();
+    });
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::runBenchmark(argc, argv);
+}
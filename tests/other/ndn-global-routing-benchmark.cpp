@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-global-routing-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * Benchmark of route setup by GlobalRoutingHelper on a grid, in which every node is the origin
+ * of its own prefix.  Routes are installed either through FIB management commands (default)
+ * or written directly into the FIB, and shortest paths are calculated on a number of threads:
+ *
+ *     ./waf --run "ndn-global-routing-benchmark --size=30 --direct=1 --threads=4"
+ *
+ * With --churn, routes are calculated in dynamic mode, and then updated after random links fail
+ * and recover again.
+ *
+ * The reported times include route calculation and, for commands, their processing by NFD.
+ */
+int
+runBenchmark(int argc, char* argv[])
+{
+  uint32_t size = 30;
+  bool isDirect = false;
+  bool isAllPossible = false;
+  uint32_t nThreads = 0;
+  uint32_t nChurnEvents = 0;
+
+  CommandLine cmd;
+  cmd.AddValue("size", "Number of rows and columns of the grid", size);
+  cmd.AddValue("direct", "Write routes directly into the FIB", isDirect);
+  cmd.AddValue("all", "Use CalculateAllPossibleRoutes instead of CalculateRoutes", isAllPossible);
+  cmd.AddValue("threads", "Number of threads to calculate routes (0: all hardware threads)",
+               nThreads);
+  cmd.AddValue("churn", "Number of link failures and recoveries to apply in dynamic mode",
+               nChurnEvents);
+  cmd.Parse(argc, argv);
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(size, size, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+    ndnGlobalRoutingHelper.AddOrigin("/node" + std::to_string((*node)->GetId()), *node);
+  }
+
+  ndn::FibHelper::SetDirectMode(isDirect);
+  ndn::GlobalRoutingHelper::SetNThreads(nThreads);
+  ndn::GlobalRoutingHelper::SetDynamicMode(nChurnEvents > 0);
+  auto before = std::chrono::steady_clock::now();
+
+  if (isAllPossible) {
+    ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+  }
+  else {
+    ndn::GlobalRoutingHelper::CalculateRoutes();
+  }
+  // FIB management commands are processed in simulated time
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  auto after = std::chrono::steady_clock::now();
+
+  // fail random links of the grid and restore them right away
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+  auto churnBefore = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nChurnEvents; ++i) {
+    uint32_t row = random->GetInteger(0, size - 1);
+    uint32_t col = random->GetInteger(0, size - 2);
+    Ptr<Node> node1 = grid.GetNode(row, col);
+    Ptr<Node> node2 = grid.GetNode(row, col + 1);
+    ndn::GlobalRoutingHelper::UpdateLink(node1, node2, false);
+    ndn::GlobalRoutingHelper::UpdateLink(node1, node2, true);
+  }
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+  auto churnAfter = std::chrono::steady_clock::now();
+
+  size_t nEntries = 0;
+  size_t nNextHops = 0;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+    for (const auto& entry : (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib()) {
+      ++nEntries;
+      nNextHops += entry.getNextHops().size();
+    }
+  }
+
+  double elapsed = std::chrono::duration<double>(after - before).count();
+  double churnElapsed = std::chrono::duration<double>(churnAfter - churnBefore).count();
+  std::cout << "Mode" << "\t"
+            << "Threads" << "\t"
+            << "Nodes" << "\t"
+            << "FIB entries" << "\t"
+            << "Next hops" << "\t"
+            << "Setup (s)" << "\t"
+            << "Churn events" << "\t"
+            << "Per event (ms)" << "\n"
+            << (isDirect ? "direct" : "command") << "\t"
+            << nThreads << "\t"
+            << NodeList::GetNNodes() << "\t"
+            << nEntries << "\t"
+            << nNextHops << "\t"
+            << elapsed << "\t"
+            << 2 * nChurnEvents << "\t"
+            << (nChurnEvents > 0 ? churnElapsed * 1e3 / (2 * nChurnEvents) : 0) << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::runBenchmark(argc, argv);
+}
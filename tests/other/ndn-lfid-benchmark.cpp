@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-lfid-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * Benchmark of loop-free multipath route calculation by GlobalRoutingHelper::CalculateLfidRoutes,
+ * on a grid or on an annotated topology, in which every node is the origin of its own prefix:
+ *
+ *     ./waf --run "ndn-lfid-benchmark --size=20 --threads=4"
+ *     ./waf --run "ndn-lfid-benchmark --topology=src/ndnSIM/examples/topologies/topo-abilene.txt"
+ *
+ * Routes are written directly into the FIB.  The peak memory is that of the whole process, so
+ * each topology size should be measured in a separate run.
+ */
+int
+runBenchmark(int argc, char* argv[])
+{
+  uint32_t size = 20;
+  std::string topology;
+  uint32_t nThreads = 0;
+
+  CommandLine cmd;
+  cmd.AddValue("size", "Number of rows and columns of the grid", size);
+  cmd.AddValue("topology", "Annotated topology file to use instead of the grid", topology);
+  cmd.AddValue("threads", "Number of threads to calculate routes (0: all hardware threads)",
+               nThreads);
+  cmd.Parse(argc, argv);
+
+  AnnotatedTopologyReader topologyReader;
+  if (!topology.empty()) {
+    topologyReader.SetFileName(topology);
+    topologyReader.Read();
+  }
+  else {
+    PointToPointHelper p2p;
+    PointToPointGridHelper grid(size, size, p2p);
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+  if (!topology.empty()) {
+    topologyReader.ApplyOspfMetric();
+  }
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+    // LFID identifies nodes by name
+    if (Names::FindName(*node).empty()) {
+      Names::Add("node" + std::to_string((*node)->GetId()), *node);
+    }
+    ndnGlobalRoutingHelper.AddOrigin("/node" + std::to_string((*node)->GetId()), *node);
+  }
+
+  ndn::FibHelper::SetDirectMode(true);
+  ndn::GlobalRoutingHelper::SetNThreads(nThreads);
+  int64_t memBefore = MemUsage::Get();
+  auto before = std::chrono::steady_clock::now();
+
+  ndn::GlobalRoutingHelper::CalculateLfidRoutes();
+
+  auto after = std::chrono::steady_clock::now();
+  int64_t memPeak = MemUsage::GetPeak();
+
+  size_t nNextHops = 0;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+    for (const auto& entry : (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib()) {
+      nNextHops += entry.getNextHops().size();
+    }
+  }
+
+  double elapsed = std::chrono::duration<double>(after - before).count();
+  std::cout << "Threads" << "\t"
+            << "Nodes" << "\t"
+            << "Next hops" << "\t"
+            << "Calculation (s)" << "\t"
+            << "Memory before (MiB)" << "\t"
+            << "Peak memory (MiB)" << "\n"
+            << nThreads << "\t"
+            << NodeList::GetNNodes() << "\t"
+            << nNextHops << "\t"
+            << elapsed << "\t"
+            << memBefore / 1024.0 / 1024.0 << "\t"
+            << memPeak / 1024.0 / 1024.0 << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::runBenchmark(argc, argv);
+}
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-stack-install-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * Benchmark of NDN stack installation on leaf nodes, with full or lightweight NFD instances.
+ *
+ * Leaves are attached round-robin to a number of routers, which always get a full NFD.  The
+ * benchmark reports the time and the resident memory spent installing the stack and a default
+ * route on the leaves:
+ *
+ *     ./waf --run "ndn-stack-install-benchmark --leaves=10000 --lightweight=1"
+ */
+int
+runBenchmark(int argc, char* argv[])
+{
+  uint32_t nLeaves = 10000;
+  uint32_t nRouters = 10;
+  bool isLightweight = false;
+
+  CommandLine cmd;
+  cmd.AddValue("leaves", "Number of leaf nodes", nLeaves);
+  cmd.AddValue("routers", "Number of routers the leaves are attached to", nRouters);
+  cmd.AddValue("lightweight", "Install lightweight NFD instances on leaf nodes", isLightweight);
+  cmd.Parse(argc, argv);
+
+  NodeContainer routers;
+  routers.Create(nRouters);
+  NodeContainer leaves;
+  leaves.Create(nLeaves);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i < nLeaves; ++i) {
+    p2p.Install(leaves.Get(i), routers.Get(i % nRouters));
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.Install(routers);
+
+  ndnHelper.setLightweight(isLightweight);
+  int64_t memBefore = MemUsage::Get();
+  auto before = std::chrono::steady_clock::now();
+
+  ndnHelper.Install(leaves);
+  for (uint32_t i = 0; i < nLeaves; ++i) {
+    ndn::FibHelper::AddRoute(leaves.Get(i), "/", routers.Get(i % nRouters), 1);
+  }
+  // full NFD instances process the route commands in simulated time
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  auto after = std::chrono::steady_clock::now();
+  int64_t memAfter = MemUsage::Get();
+
+  double elapsed = std::chrono::duration<double>(after - before).count();
+  std::cout << "Mode" << "\t"
+            << "Leaves" << "\t"
+            << "Install (s)" << "\t"
+            << "Per node (us)" << "\t"
+            << "Memory (MiB)" << "\t"
+            << "Per node (KiB)" << "\n"
+            << (isLightweight ? "lightweight" : "full") << "\t"
+            << nLeaves << "\t"
+            << elapsed << "\t"
+            << elapsed * 1e6 / nLeaves << "\t"
+            << (memAfter - memBefore) / 1024.0 / 1024.0 << "\t"
+            << (memAfter - memBefore) / 1024.0 / nLeaves << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::runBenchmark(argc, argv);
+}
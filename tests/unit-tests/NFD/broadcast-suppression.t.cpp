@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/fw/broadcast-suppression.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/null-face.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/pit.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::fw::BroadcastSuppression;
+
+class BroadcastSuppressionFixture : public CleanupFixture
+{
+public:
+  BroadcastSuppressionFixture()
+    : pit(nameTree)
+    , suppression(faceTable,
+                  [this] (const shared_ptr<nfd::pit::Entry>&, nfd::Face& outFace,
+                          const Interest& interest) {
+                    sent.emplace_back(outFace.getId(), interest.getNonce());
+                  },
+                  time::milliseconds(10), time::milliseconds(50))
+  {
+    face1 = nfd::face::makeNullFace();
+    face2 = nfd::face::makeNullFace();
+    faceTable.add(face1);
+    faceTable.add(face2);
+  }
+
+  shared_ptr<Interest>
+  makeInterest(const std::string& name, uint32_t nonce)
+  {
+    auto interest = make_shared<Interest>(name);
+    interest->setCanBePrefix(false);
+    interest->setNonce(nonce);
+    return interest;
+  }
+
+public:
+  nfd::FaceTable faceTable;
+  nfd::NameTree nameTree;
+  nfd::Pit pit;
+  shared_ptr<nfd::Face> face1;
+  shared_ptr<nfd::Face> face2;
+  std::vector<std::pair<nfd::FaceId, uint32_t>> sent;
+  BroadcastSuppression suppression;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestBroadcastSuppression, BroadcastSuppressionFixture)
+
+BOOST_AUTO_TEST_CASE(ComputeDelay)
+{
+  // without neighbors, the delay is random
+  nfd::NeighborTable nit;
+  for (int i = 0; i < 10; ++i) {
+    auto delay = suppression.computeDelay(nit, 0, 0, 100, 0);
+    BOOST_CHECK_GE(delay, time::milliseconds(10));
+    BOOST_CHECK_LE(delay, time::milliseconds(50));
+  }
+
+  // two of three neighbors are closer to (100, 0)
+  nit.insert({1, std::make_tuple(50.0, 0.0, 0.0)}, std::make_tuple(0.0, 0.0, 0.0));
+  nit.insert({2, std::make_tuple(80.0, 0.0, 0.0)}, std::make_tuple(0.0, 0.0, 0.0));
+  nit.insert({3, std::make_tuple(-50.0, 0.0, 0.0)}, std::make_tuple(0.0, 0.0, 0.0));
+  for (int i = 0; i < 10; ++i) {
+    auto delay = suppression.computeDelay(nit, 0, 0, 100, 0);
+    BOOST_CHECK_GE(delay, time::milliseconds(30));
+    BOOST_CHECK_LE(delay, time::milliseconds(40));
+  }
+
+  // no neighbor is closer to (-100, 0) than (-60, 0)
+  for (int i = 0; i < 10; ++i) {
+    auto delay = suppression.computeDelay(nit, -60, 0, -100, 0);
+    BOOST_CHECK_GE(delay, time::milliseconds(10));
+    BOOST_CHECK_LE(delay, time::milliseconds(20));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SuppressDuplicate)
+{
+  auto interest = makeInterest("/A", 100);
+  auto pitEntry = pit.insert(*interest).first;
+
+  suppression.scheduleRebroadcast(pitEntry, *face1, *interest, time::milliseconds(10));
+  suppression.scheduleRebroadcast(pitEntry, *face2, *interest, time::milliseconds(10));
+  BOOST_CHECK_EQUAL(suppression.getCounters().nScheduled, 2);
+
+  // duplicate overheard on face1 suppresses the rebroadcast on face1 only
+  suppression.afterReceiveLoopedInterest(nfd::FaceEndpoint(*face1, 0), *interest, *pitEntry);
+  BOOST_CHECK_EQUAL(suppression.getCounters().nSuppressed, 1);
+
+  // Interest with a different Nonce is not a duplicate
+  auto other = makeInterest("/A", 200);
+  suppression.afterReceiveLoopedInterest(nfd::FaceEndpoint(*face2, 0), *other, *pitEntry);
+  BOOST_CHECK_EQUAL(suppression.getCounters().nSuppressed, 1);
+
+  Simulator::Run();
+  BOOST_REQUIRE_EQUAL(sent.size(), 1);
+  BOOST_CHECK_EQUAL(sent[0].first, face2->getId());
+  BOOST_CHECK_EQUAL(sent[0].second, 100);
+  BOOST_CHECK_EQUAL(suppression.getCounters().nRebroadcast, 1);
+  BOOST_CHECK_EQUAL(suppression.getCounters().nCanceled, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Reschedule)
+{
+  auto interest = makeInterest("/A", 100);
+  auto pitEntry = pit.insert(*interest).first;
+
+  suppression.scheduleRebroadcast(pitEntry, *face1, *interest, time::milliseconds(10));
+  auto retx = makeInterest("/A", 200);
+  suppression.scheduleRebroadcast(pitEntry, *face1, *retx, time::milliseconds(20));
+
+  Simulator::Run();
+  BOOST_REQUIRE_EQUAL(sent.size(), 1);
+  BOOST_CHECK_EQUAL(sent[0].second, 200);
+}
+
+BOOST_AUTO_TEST_CASE(Cancel)
+{
+  auto interestA = makeInterest("/A", 100);
+  auto pitEntryA = pit.insert(*interestA).first;
+  suppression.scheduleRebroadcast(pitEntryA, *face1, *interestA, time::milliseconds(10));
+  pitEntryA->isSatisfied = true;
+
+  auto interestB = makeInterest("/B", 100);
+  auto pitEntryB = pit.insert(*interestB).first;
+  suppression.scheduleRebroadcast(pitEntryB, *face2, *interestB, time::milliseconds(10));
+  face2->close();
+
+  // pending rebroadcasts are dropped together with the PIT entry
+  auto interestC = makeInterest("/C", 100);
+  auto pitEntryC = pit.insert(*interestC).first;
+  suppression.scheduleRebroadcast(pitEntryC, *face1, *interestC, time::milliseconds(10));
+  pit.erase(pitEntryC.get());
+  pitEntryC.reset();
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(sent.size(), 0);
+  BOOST_CHECK_EQUAL(suppression.getCounters().nScheduled, 3);
+  BOOST_CHECK_EQUAL(suppression.getCounters().nCanceled, 2);
+  BOOST_CHECK_EQUAL(suppression.getCounters().nRebroadcast, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "../tests-common.hpp"
+
+#include <cstring>
+
+namespace ns3 {
+namespace ndn {
+
+#define CHECK_CS_FIND(expected) find([&] (uint32_t found) { BOOST_CHECK_EQUAL(expected, found); });
+
+class CsHashIndexFixture : public CleanupFixture
+{
+public:
+  CsHashIndexFixture()
+  {
+    cs.enableHashIndex(true);
+  }
+
+  Name
+  insert(uint32_t id, const Name& name, const std::function<void(Data&)>& modifyData = nullptr)
+  {
+    auto data = make_shared<Data>(name);
+    data->setContent(reinterpret_cast<const uint8_t*>(&id), sizeof(id));
+
+    if (modifyData != nullptr) {
+      modifyData(*data);
+    }
+
+    StackHelper::getKeyChain().sign(*data);
+    cs.insert(*data);
+
+    return data->getFullName();
+  }
+
+  Interest&
+  startInterest(const Name& name)
+  {
+    interest = make_shared<Interest>(name);
+    interest->setCanBePrefix(false);
+    return *interest;
+  }
+
+  void
+  find(const std::function<void(uint32_t)>& check)
+  {
+    bool hasResult = false;
+    cs.find(*interest,
+            [&] (const Interest& interest, const Data& data) {
+              hasResult = true;
+              const Block& content = data.getContent();
+              uint32_t found = 0;
+              std::memcpy(&found, content.value(), sizeof(found));
+              check(found);
+            },
+            [&] (const Interest& interest) {
+              hasResult = true;
+              check(0);
+            });
+
+    // Cs::find is synchronous
+    BOOST_CHECK(hasResult);
+  }
+
+  size_t
+  erase(const Name& prefix, size_t limit)
+  {
+    size_t nErased = 0;
+    cs.erase(prefix, limit, [&] (size_t nErased1) { nErased = nErased1; });
+    return nErased;
+  }
+
+  void
+  advanceClock(Time delay)
+  {
+    Simulator::Stop(delay);
+    Simulator::Run();
+  }
+
+public:
+  nfd::Cs cs;
+  shared_ptr<Interest> interest;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCsHashIndex, CsHashIndexFixture)
+
+BOOST_AUTO_TEST_CASE(ExactName)
+{
+  insert(1, "/");
+  insert(2, "/A");
+  insert(3, "/A/B");
+  insert(4, "/A/C");
+  insert(5, "/D");
+
+  startInterest("/A");
+  CHECK_CS_FIND(2);
+
+  startInterest("/A/C");
+  CHECK_CS_FIND(4);
+
+  startInterest("/B");
+  CHECK_CS_FIND(0);
+}
+
+BOOST_AUTO_TEST_CASE(FullName)
+{
+  Name n1 = insert(1, "/A");
+  Name n2 = insert(2, "/A");
+  Name n3 = insert(3, "/");
+
+  startInterest(n1);
+  CHECK_CS_FIND(1);
+
+  startInterest(n2);
+  CHECK_CS_FIND(2);
+
+  startInterest(n3);
+  CHECK_CS_FIND(3);
+
+  // the same Data name matches the first entry in Table order, as without hash index
+  bool isFirst1 = n1 < n2;
+  startInterest("/A");
+  CHECK_CS_FIND(isFirst1 ? 1 : 2);
+}
+
+BOOST_AUTO_TEST_CASE(CanBePrefix)
+{
+  insert(1, "/A");
+  insert(2, "/B/p/1");
+  insert(3, "/B/p/2");
+
+  startInterest("/B")
+    .setCanBePrefix(true);
+  CHECK_CS_FIND(2);
+
+  startInterest("/B");
+  CHECK_CS_FIND(0);
+}
+
+BOOST_AUTO_TEST_CASE(MustBeFresh)
+{
+  insert(1, "/A", [] (Data& data) { data.setFreshnessPeriod(time::seconds(1)); });
+
+  advanceClock(MilliSeconds(500));
+  startInterest("/A")
+    .setMustBeFresh(true);
+  CHECK_CS_FIND(1);
+
+  advanceClock(Seconds(1));
+  startInterest("/A")
+    .setMustBeFresh(true);
+  CHECK_CS_FIND(0);
+}
+
+BOOST_AUTO_TEST_CASE(EraseAndEvict)
+{
+  cs.setLimit(600);
+  for (uint32_t i = 1; i <= 1000; ++i) {
+    insert(i, Name("/A").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 600);
+
+  startInterest(Name("/A").appendNumber(400));
+  CHECK_CS_FIND(0);
+  startInterest(Name("/A").appendNumber(401));
+  CHECK_CS_FIND(401);
+
+  BOOST_CHECK_EQUAL(erase("/A", 590), 590);
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+
+  size_t nFound = 0;
+  for (uint32_t i = 401; i <= 1000; ++i) {
+    startInterest(Name("/A").appendNumber(i));
+    find([&] (uint32_t found) {
+      BOOST_CHECK(found == 0 || found == i);
+      nFound += static_cast<size_t>(found > 0);
+    });
+  }
+  BOOST_CHECK_EQUAL(nFound, 10);
+}
+
+BOOST_AUTO_TEST_CASE(Enable)
+{
+  cs.enableHashIndex(false);
+  BOOST_CHECK_EQUAL(cs.hasHashIndex(), false);
+
+  insert(1, "/A");
+  insert(2, "/B");
+
+  cs.enableHashIndex(true);
+  BOOST_CHECK_EQUAL(cs.hasHashIndex(), true);
+
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+  startInterest("/B");
+  CHECK_CS_FIND(2);
+
+  cs.enableHashIndex(false);
+  startInterest("/B");
+  CHECK_CS_FIND(2);
+}
+
+BOOST_AUTO_TEST_CASE(StackHelperCsIndex)
+{
+  Ptr<Node> node1 = CreateObject<Node>();
+  Ptr<Node> node2 = CreateObject<Node>();
+
+  StackHelper helper;
+  helper.Install(node1);
+  helper.setCsIndex("hash");
+  helper.Install(node2);
+
+  BOOST_CHECK_EQUAL(L3Protocol::getL3Protocol(node1)->getForwarder()->getCs().hasHashIndex(), false);
+  BOOST_CHECK_EQUAL(L3Protocol::getL3Protocol(node2)->getForwarder()->getCs().hasHashIndex(), true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/table/dead-nonce-list.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/null-face.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::DeadNonceList;
+
+BOOST_FIXTURE_TEST_SUITE(TestDeadNonceList, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(NameHash)
+{
+  Name nameA("/A");
+  Name nameB("/B");
+  const uint32_t nonce1 = 0x53b4eaa8;
+
+  DeadNonceList dnl;
+  dnl.add(nfd::name_tree::computeHash(nameA), nonce1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has(nfd::name_tree::computeHash(nameA), nonce1), true);
+
+  dnl.add(nameB, nonce1);
+  BOOST_CHECK_EQUAL(dnl.has(nfd::name_tree::computeHash(nameB), nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Evict)
+{
+  Name nameA("/A");
+  Name nameB("/B");
+  const uint32_t nonce1 = 0x53b4eaa8;
+
+  DeadNonceList dnl;
+  dnl.add(nameA, nonce1);
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK_EQUAL(dnl.size(), 2);
+
+  // initial MARKs and both nameA entries are the oldest, and are evicted first
+  uint32_t nonce = 1;
+  for (; dnl.has(nameA, nonce1) && nonce < 0x100000; ++nonce) {
+    dnl.add(nameB, nonce);
+  }
+  BOOST_REQUIRE_EQUAL(dnl.has(nameA, nonce1), false);
+
+  // only nameB entries are left, and the list does not grow beyond its capacity
+  size_t capacity = dnl.size();
+  dnl.add(nameB, nonce++);
+  BOOST_CHECK_EQUAL(dnl.size(), capacity);
+  for (uint32_t n = nonce - capacity; n < nonce; ++n) {
+    BOOST_CHECK_EQUAL(dnl.has(nameB, n), true);
+  }
+}
+
+class InterestLoopFixture : public CleanupFixture
+{
+public:
+  InterestLoopFixture()
+    : forwarder(faceTable)
+  {
+    face1 = nfd::face::makeNullFace();
+    face2 = nfd::face::makeNullFace();
+    faceTable.add(face1);
+    faceTable.add(face2);
+
+    nfd::Fib& fib = forwarder.getFib();
+    fib.addOrUpdateNextHop(*fib.insert("/A").first, *face2, 0);
+  }
+
+  /** @brief Receive @p interest on face1, and again after its PIT entry is gone
+   *  @return number of Interests sent out of face2
+   */
+  uint64_t
+  loopInterest(const Interest& interest)
+  {
+    forwarder.startProcessInterest(nfd::FaceEndpoint(*face1, 0), interest);
+    BOOST_REQUIRE_EQUAL(face2->getCounters().nOutInterests, 1);
+
+    Simulator::Stop(MilliSeconds(200));
+    Simulator::Run();
+    BOOST_REQUIRE_EQUAL(forwarder.getPit().size(), 0);
+
+    forwarder.startProcessInterest(nfd::FaceEndpoint(*face1, 0), interest);
+    Simulator::Stop(MilliSeconds(200));
+    Simulator::Run();
+
+    return face2->getCounters().nOutInterests;
+  }
+
+public:
+  nfd::FaceTable faceTable;
+  nfd::Forwarder forwarder;
+  shared_ptr<nfd::Face> face1;
+  shared_ptr<nfd::Face> face2;
+};
+
+BOOST_FIXTURE_TEST_CASE(InterestLoopImplicitDigest, InterestLoopFixture)
+{
+  auto data = make_shared<Data>("/A/1");
+  StackHelper::getKeyChain().sign(*data);
+  Name name = data->getFullName();
+
+  auto interest = make_shared<Interest>(name);
+  interest->setCanBePrefix(false);
+  interest->setInterestLifetime(time::milliseconds(50));
+  interest->setNonce(3051298);
+
+  BOOST_CHECK_EQUAL(loopInterest(*interest), 1);
+  BOOST_CHECK(forwarder.getDeadNonceList().has(name, 3051298));
+}
+
+BOOST_FIXTURE_TEST_CASE(InterestLoopBeyondMaxDepth, InterestLoopFixture)
+{
+  Name name("/A");
+  while (name.size() <= nfd::NameTree::getMaxDepth()) {
+    name.appendNumber(name.size());
+  }
+
+  auto interest = make_shared<Interest>(name);
+  interest->setCanBePrefix(false);
+  interest->setInterestLifetime(time::milliseconds(50));
+  interest->setNonce(7723014);
+
+  BOOST_CHECK_EQUAL(loopInterest(*interest), 1);
+  BOOST_CHECK(forwarder.getDeadNonceList().has(name, 7723014));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
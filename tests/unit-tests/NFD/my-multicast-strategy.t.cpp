@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ns3/ndnSIM/NFD/daemon/fw/my-multicast-strategy.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::fw::ForwardingZone;
+
+BOOST_AUTO_TEST_SUITE(TestMyMulticastStrategy)
+
+BOOST_AUTO_TEST_CASE(AxisAlignedZone)
+{
+  ForwardingZone zone = ForwardingZone::fromEndpoints(0, 0, 100, 0, 2);
+  BOOST_CHECK_CLOSE(zone.centerX, 50, 0.001);
+  BOOST_CHECK_CLOSE(zone.halfLength, 50, 0.001);
+  BOOST_CHECK_CLOSE(zone.halfWidth, 1, 0.001);
+
+  BOOST_CHECK(zone.contains(0, 0));
+  BOOST_CHECK(zone.contains(100, 0));
+  BOOST_CHECK(zone.contains(50, 1));
+  BOOST_CHECK(zone.contains(50, -1));
+  BOOST_CHECK(zone.contains(100, 1));
+  BOOST_CHECK(!zone.contains(50, 1.01));
+  BOOST_CHECK(!zone.contains(-0.01, 0));
+  BOOST_CHECK(!zone.contains(100.01, 0));
+}
+
+BOOST_AUTO_TEST_CASE(RotatedZone)
+{
+  // from (10, 10) to (40, 50), length 50 along (0.6, 0.8)
+  ForwardingZone zone = ForwardingZone::fromEndpoints(10, 10, 40, 50, 4);
+  BOOST_CHECK_CLOSE(zone.halfLength, 25, 0.001);
+  BOOST_CHECK_CLOSE(zone.halfWidth, 2, 0.001);
+
+  BOOST_CHECK(zone.contains(25, 30));
+  BOOST_CHECK(zone.contains(10, 10));
+  BOOST_CHECK(zone.contains(40, 50));
+  // 2 away from the center line, perpendicular to it
+  BOOST_CHECK(zone.contains(25 + 1.6, 30 - 1.2));
+  BOOST_CHECK(!zone.contains(25 + 1.7, 30 - 1.3));
+  // inside the axis-aligned bounding box, but outside the zone
+  BOOST_CHECK(!zone.contains(38, 12));
+  BOOST_CHECK(!zone.contains(12, 48));
+
+  // same zone in the opposite direction
+  ForwardingZone reverse = ForwardingZone::fromEndpoints(40, 50, 10, 10, 4);
+  BOOST_CHECK(reverse.contains(25 + 1.6, 30 - 1.2));
+  BOOST_CHECK(!reverse.contains(38, 12));
+}
+
+BOOST_AUTO_TEST_CASE(EmptyZone)
+{
+  ForwardingZone zone = ForwardingZone::fromEndpoints(10, 10, 10, 10, 2);
+  BOOST_CHECK(!zone.contains(10, 10));
+  BOOST_CHECK(!zone.contains(11, 10));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/table/name-tree.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::name_tree::Entry;
+using nfd::name_tree::HashSequence;
+using nfd::name_tree::Hashtable;
+using nfd::name_tree::HashtableOptions;
+using nfd::name_tree::Node;
+using nfd::name_tree::computeHashes;
+
+BOOST_FIXTURE_TEST_SUITE(TestNameTree, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(NameFromParentChain)
+{
+  Name name("/named-data/research/abc/def/ghi");
+  Name otherName("/named-data/research/abc/xyz/ghi");
+
+  auto parentNode = make_unique<Node>(1, name.getPrefix(-1));
+  Entry& parent = parentNode->entry;
+  auto node = make_unique<Node>(0, name);
+  Entry& npe = node->entry;
+  BOOST_CHECK_EQUAL(npe.getDepth(), 5);
+  BOOST_CHECK_EQUAL(npe.getName(), name);
+
+  npe.setParent(parent);
+  BOOST_CHECK_EQUAL(npe.getDepth(), 5);
+  BOOST_CHECK_EQUAL(npe.getName(), name);
+  BOOST_CHECK_EQUAL(npe.hasName(name, 5), true);
+  BOOST_CHECK_EQUAL(npe.hasName(Name(name).append("jkl"), 5), true);
+  BOOST_CHECK_EQUAL(npe.hasName(name, 4), false);
+  BOOST_CHECK_EQUAL(npe.hasName(otherName, 5), false);
+  BOOST_CHECK_EQUAL(parent.hasName(name, 4), true);
+  BOOST_CHECK_EQUAL(parent.hasName(otherName, 4), false);
+
+  npe.unsetParent();
+  BOOST_CHECK_EQUAL(npe.getName(), name);
+  BOOST_CHECK_EQUAL(npe.hasName(name, 5), true);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalResize)
+{
+  HashtableOptions options(8);
+  options.incrementalResize = true;
+  Hashtable ht(options);
+  Hashtable htFull(HashtableOptions(8));
+
+  const int nNodes = 1000;
+  auto makeName = [] (int i) {
+    Name name;
+    name.appendNumber(i);
+    return name;
+  };
+
+  auto checkAllFound = [&ht, &makeName] (int min, int max) {
+    for (int i = min; i <= max; ++i) {
+      Name name = makeName(i);
+      const Node* node = ht.find(name, name.size());
+      BOOST_REQUIRE(node != nullptr);
+      BOOST_CHECK_EQUAL(node->entry.getName(), name);
+    }
+  };
+
+  for (int i = 1; i <= nNodes; ++i) {
+    Name name = makeName(i);
+    HashSequence hashes = computeHashes(name);
+    ht.insert(name, name.size(), hashes);
+    htFull.insert(name, name.size(), hashes);
+    BOOST_CHECK_LE(ht.size(), ht.getNBuckets() * options.expandLoadFactor);
+  }
+  checkAllFound(1, nNodes);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 2000); // grows one bucket at a time
+  BOOST_CHECK_EQUAL(htFull.getNBuckets(), 2048);
+
+  // a single insertion moves a few nodes, instead of all nodes at once
+  BOOST_CHECK_LE(ht.getMaxRehashedNodes(), 10);
+  BOOST_CHECK_GT(htFull.getMaxRehashedNodes(), 500);
+  BOOST_CHECK_GT(ht.getNRehashedNodes(), 0);
+
+  for (int i = nNodes; i > 10; --i) {
+    Name name = makeName(i);
+    ht.erase(const_cast<Node*>(ht.find(name, name.size())));
+    BOOST_CHECK_GE(ht.size() + 1, ht.getNBuckets() * options.shrinkLoadFactor);
+  }
+  checkAllFound(1, 10);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 109);
+  BOOST_CHECK_LE(ht.getMaxRehashedNodes(), 10);
+
+  ht.setIncrementalResize(false);
+  checkAllFound(1, 10);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 109);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
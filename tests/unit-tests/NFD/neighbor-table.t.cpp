@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/table/neighbor-table.hpp"
+
+#include "../tests-common.hpp"
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::NeighborTable;
+using nfd::neighbor_table::Entry;
+
+BOOST_FIXTURE_TEST_SUITE(TestNeighborTable, CleanupFixture)
+
+static std::vector<uint32_t>
+getIds(const std::vector<const Entry*>& entries)
+{
+  std::vector<uint32_t> ids;
+  for (const Entry* entry : entries) {
+    ids.push_back(entry->getId());
+  }
+  return ids;
+}
+
+static std::vector<uint32_t>
+findNearestBruteForce(const NeighborTable& nit, double x, double y, size_t k, double maxDistance,
+                      const std::function<bool(const Entry&)>& filter = nullptr)
+{
+  std::vector<std::pair<double, uint32_t>> candidates;
+  for (const Entry& entry : nit) {
+    double dx = std::get<0>(entry.getCurrentLocation()) - x;
+    double dy = std::get<1>(entry.getCurrentLocation()) - y;
+    if (dx * dx + dy * dy <= maxDistance * maxDistance && (!filter || filter(entry))) {
+      candidates.emplace_back(dx * dx + dy * dy, entry.getId());
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  if (k > 0 && candidates.size() > k) {
+    candidates.resize(k);
+  }
+
+  std::vector<uint32_t> ids;
+  for (const auto& candidate : candidates) {
+    ids.push_back(candidate.second);
+  }
+  return ids;
+}
+
+BOOST_AUTO_TEST_CASE(InsertUpdateErase)
+{
+  NeighborTable nit(10.0);
+  BOOST_CHECK(nit.findNearest(0, 0, 1).empty());
+
+  Entry* entry1 = nit.insert({1, std::make_tuple(5.0, 5.0, 0.0)}, std::make_tuple(0.0, 0.0, 0.0));
+  nit.insert({2, std::make_tuple(50.0, 5.0, 0.0)}, std::make_tuple(0.0, 0.0, 0.0));
+  nit.insert({3, std::make_tuple(-50.0, -5.0, 0.0)}, std::make_tuple(0.0, 0.0, 0.0));
+  BOOST_CHECK_EQUAL(nit.size(), 3);
+  BOOST_CHECK_EQUAL(nit.getCellSize(), 10.0);
+
+  std::vector<uint32_t> expected{1, 2, 3};
+  std::vector<uint32_t> actual = getIds(nit.findNearest(0, 0, 0));
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  // moving an entry to another cell keeps the same entry
+  Entry* entry1b = nit.insert({1, std::make_tuple(100.0, 0.0, 0.0)}, std::make_tuple(5.0, 5.0, 0.0));
+  BOOST_CHECK_EQUAL(entry1b, entry1);
+  BOOST_CHECK_EQUAL(nit.size(), 3);
+  BOOST_CHECK_EQUAL(std::get<0>(entry1->getPreviousLocation()), 5.0);
+  expected = {1, 2};
+  actual = getIds(nit.findNearest(90, 0, 2));
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  nit.eraseEntry(*entry1);
+  BOOST_CHECK_EQUAL(nit.size(), 2);
+  expected = {2};
+  actual = getIds(nit.findNearest(90, 0, 1));
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  nit.clear();
+  BOOST_CHECK_EQUAL(nit.size(), 0);
+  BOOST_CHECK(nit.findNearest(0, 0, 0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(FindNearest)
+{
+  NeighborTable nit(25.0);
+  nit.insert({1, std::make_tuple(10.0, 0.0, 0.0)}, std::make_tuple(20.0, 0.0, 0.0));
+  nit.insert({2, std::make_tuple(0.0, 10.0, 0.0)}, std::make_tuple(0.0, 5.0, 0.0));
+  nit.insert({3, std::make_tuple(30.0, 40.0, 0.0)}, std::make_tuple(60.0, 80.0, 0.0));
+  nit.insert({4, std::make_tuple(-3.0, -4.0, 0.0)}, std::make_tuple(-6.0, -8.0, 0.0));
+
+  // ties are ordered by id
+  std::vector<uint32_t> expected{4, 1, 2, 3};
+  std::vector<uint32_t> actual = getIds(nit.findNearest(0, 0, 0));
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  expected = {4, 1};
+  actual = getIds(nit.findNearest(0, 0, 2));
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  // maxDistance is inclusive
+  expected = {4, 1, 2};
+  actual = getIds(nit.findNearest(0, 0, 0, 10.0));
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  // only neighbors getting closer to the origin
+  auto isGettingCloser = [] (const Entry& entry) {
+    return std::abs(std::get<0>(entry.getCurrentLocation())) +
+           std::abs(std::get<1>(entry.getCurrentLocation())) <=
+           std::abs(std::get<0>(entry.getPreviousLocation())) +
+           std::abs(std::get<1>(entry.getPreviousLocation()));
+  };
+  expected = {4, 1, 3};
+  actual = getIds(nit.findNearest(0, 0, 0, std::numeric_limits<double>::infinity(), isGettingCloser));
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(FindNearestRandom)
+{
+  boost::random::mt19937 gen(42);
+  boost::random::uniform_real_distribution<> coordinate(-500.0, 500.0);
+
+  NeighborTable nit(50.0);
+  std::vector<Entry*> entries;
+  for (uint32_t id = 0; id < 300; ++id) {
+    double x = coordinate(gen);
+    double y = coordinate(gen) / 10; // a sparse strip, as along a road
+    entries.push_back(nit.insert({id, std::make_tuple(x, y, 0.0)}, std::make_tuple(x, y, 0.0)));
+  }
+  // move some and erase some, leaving the index with empty cells in its range
+  for (uint32_t id = 0; id < 300; id += 3) {
+    nit.insert({id, std::make_tuple(coordinate(gen), coordinate(gen), 0.0)},
+               entries[id]->getCurrentLocation());
+  }
+  for (uint32_t id = 1; id < 300; id += 7) {
+    nit.eraseEntry(*entries[id]);
+  }
+
+  auto isEven = [] (const Entry& entry) { return entry.getId() % 2 == 0; };
+  for (int i = 0; i < 50; ++i) {
+    // query points inside and far outside the occupied area
+    double x = coordinate(gen) * (i % 5 == 0 ? 10 : 1);
+    double y = coordinate(gen);
+    for (size_t k : {0, 1, 3, 20}) {
+      for (double maxDistance : {50.0, 300.0, std::numeric_limits<double>::infinity()}) {
+        std::vector<uint32_t> expected = findNearestBruteForce(nit, x, y, k, maxDistance);
+        std::vector<uint32_t> actual = getIds(nit.findNearest(x, y, k, maxDistance));
+        BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+        expected = findNearestBruteForce(nit, x, y, k, maxDistance, isEven);
+        actual = getIds(nit.findNearest(x, y, k, maxDistance, isEven));
+        BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -44,7 +44,8 @@ namespace ndn {
 
 BOOST_FIXTURE_TEST_SUITE(HelperLfidRoutingHelper, CleanupFixture)
 
-BOOST_AUTO_TEST_CASE(CalculateRouteAbilene)
+static NodeContainer
+installAbilene(const std::string& prefix)
 {
   AnnotatedTopologyReader topologyReader;
   topologyReader.SetFileName("src/ndnSIM/examples/topologies/topo-abilene.txt");
@@ -57,20 +58,22 @@ BOOST_AUTO_TEST_CASE(CalculateRouteAbilene)
   // IMPORTANT: Has to be run after StackHelper!
   topologyReader.ApplyOspfMetric();
 
-  const std::string prefix{"/prefix"};
-
   ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
   BOOST_CHECK_NO_THROW(ndnGlobalRoutingHelper.InstallAll());
 
-//  auto producer = Names::Find<Node>("producer");
   const NodeContainer allNodes {topologyReader.GetNodes()};
 
   // Make every node a producer for their prefix:
   for (int i = 0; i < allNodes.size(); i++) {
     ndnGlobalRoutingHelper.AddOrigins(prefix + std::to_string(i), allNodes.Get(i));
   }
-  BOOST_CHECK_NO_THROW(ndn::GlobalRoutingHelper::CalculateLfidRoutes());
 
+  return allNodes;
+}
+
+static int
+countNexthops(const NodeContainer& allNodes, const std::string& prefix)
+{
   // IMPORTANT: Some strategy needs to be installed for test to work.
   ndn::StrategyChoiceHelper str;
   str.InstallAll<nfd::fw::BestRouteStrategy2>("/");
@@ -118,7 +121,30 @@ BOOST_AUTO_TEST_CASE(CalculateRouteAbilene)
     }
   }
 
-  BOOST_CHECK_EQUAL(numNexthops, 226);
+  return numNexthops;
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRouteAbilene)
+{
+  const std::string prefix{"/prefix"};
+  const NodeContainer allNodes{installAbilene(prefix)};
+
+  BOOST_CHECK_NO_THROW(ndn::GlobalRoutingHelper::CalculateLfidRoutes());
+
+  BOOST_CHECK_EQUAL(countNexthops(allNodes, prefix), 226);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRouteAbileneInParallel)
+{
+  const std::string prefix{"/prefix"};
+  const NodeContainer allNodes{installAbilene(prefix)};
+
+  // Same nexthops, independently of the number of threads
+  ndn::GlobalRoutingHelper::SetNThreads(3);
+  BOOST_CHECK_NO_THROW(ndn::GlobalRoutingHelper::CalculateLfidRoutes());
+  ndn::GlobalRoutingHelper::SetNThreads(0);
+
+  BOOST_CHECK_EQUAL(countNexthops(allNodes, prefix), 226);
 }
 
 
@@ -18,6 +18,9 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 #include "../tests-common.hpp"
 
@@ -97,6 +100,32 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+// static void
+// AddRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  FibHelper::AddRoutes(getNode("1"), {{"/prefix", getFace("1", "2"), 1},
+                                      {"/other", getFace("1", "2"), 1}});
+}
+
+BOOST_AUTO_TEST_CASE(DirectMode)
+{
+  FibHelper::SetDirectMode(true);
+  FibHelper::AddRoutes(getNode("1"), {{"/prefix", getFace("1", "2"), 1},
+                                      {"/other", getFace("1", "2"), 1}});
+  FibHelper::RemoveRoute(getNode("1"), "/other", getFace("1", "2"));
+  FibHelper::SetDirectMode(false);
+
+  // direct updates take effect immediately
+  nfd::Fib& fib = L3Protocol::getL3Protocol(getNode("1"))->getForwarder()->getFib();
+  nfd::fib::Entry* entry = fib.findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(&entry->getNextHops().front().getFace(), getFace("1", "2").get());
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), 1);
+  BOOST_CHECK(fib.findExactMatch("/other") == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
@@ -19,6 +19,8 @@
 
 #include "helper/ndn-global-routing-helper.hpp"
 #include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-link-control-helper.hpp"
+#include "daemon/common/global.hpp"
 
 #include "model/ndn-global-router.hpp"
 #include "model/ndn-l3-protocol.hpp"
@@ -190,6 +192,165 @@ BOOST_AUTO_TEST_CASE(CalculateRoutesBasedOnLinkDelay)
   }
 }
 
+BOOST_AUTO_TEST_CASE(CalculateRoutesInParallel)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(4, 4, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  for (uint32_t row = 0; row < 4; ++row) {
+    for (uint32_t col = 0; col < 4; ++col) {
+      ndnGlobalRoutingHelper.AddOrigin("/" + std::to_string(row) + "/" + std::to_string(col),
+                                       grid.GetNode(row, col));
+    }
+  }
+
+  ndn::GlobalRoutingHelper::SetNThreads(3);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  ndn::GlobalRoutingHelper::SetNThreads(0);
+
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  for (uint32_t row = 0; row < 4; ++row) {
+    for (uint32_t col = 0; col < 4; ++col) {
+      auto& fib = grid.GetNode(row, col)->GetObject<L3Protocol>()->getForwarder()->getFib();
+      for (uint32_t dstRow = 0; dstRow < 4; ++dstRow) {
+        for (uint32_t dstCol = 0; dstCol < 4; ++dstCol) {
+          if (dstRow == row && dstCol == col) {
+            continue;
+          }
+          Name prefix("/" + std::to_string(dstRow) + "/" + std::to_string(dstCol));
+          auto entry = fib.findExactMatch(prefix);
+          BOOST_REQUIRE(entry != nullptr);
+          BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+          uint64_t distance = std::abs(static_cast<int>(dstRow) - static_cast<int>(row))
+                              + std::abs(static_cast<int>(dstCol) - static_cast<int>(col));
+          BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), distance);
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CalculateAllPossibleRoutes)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(3, 3, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigin("/center", grid.GetNode(1, 1));
+  ndnGlobalRoutingHelper.AddOrigin("/side", grid.GetNode(0, 1));
+
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  // both faces of a corner node lead to every other node, without going back through the corner
+  auto& fib = grid.GetNode(0, 0)->GetObject<L3Protocol>()->getForwarder()->getFib();
+
+  auto center = fib.findExactMatch("/center");
+  BOOST_REQUIRE(center != nullptr);
+  BOOST_REQUIRE_EQUAL(center->getNextHops().size(), 2);
+  BOOST_CHECK_EQUAL(center->getNextHops()[0].getCost(), static_cast<uint64_t>(2));
+  BOOST_CHECK_EQUAL(center->getNextHops()[1].getCost(), static_cast<uint64_t>(2));
+
+  auto side = fib.findExactMatch("/side");
+  BOOST_REQUIRE(side != nullptr);
+  BOOST_REQUIRE_EQUAL(side->getNextHops().size(), 2);
+  BOOST_CHECK_EQUAL(side->getNextHops()[0].getCost(), static_cast<uint64_t>(1));
+  BOOST_CHECK_EQUAL(side->getNextHops()[1].getCost(), static_cast<uint64_t>(3));
+}
+
+BOOST_AUTO_TEST_CASE(DynamicRoutes)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A4  NA  1 1 1\n"
+        << "B4  NA  80  -40 1\n"
+        << "C4  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A4      B4  10Mbps    1   1ms 100\n"
+        << "A4      C4  10Mbps    10  1ms 100\n"
+        << "B4      C4  10Mbps    1   1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C4"));
+
+  ndn::GlobalRoutingHelper::SetDynamicMode(true);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  // next hops of /prefix, by the name of the node on the other side of the face
+  auto getNextHops = [] (const std::string& nodeName) {
+    Ptr<Node> node = Names::Find<Node>(nodeName);
+    auto& fib = node->GetObject<L3Protocol>()->getForwarder()->getFib();
+    std::map<std::string, uint64_t> nextHops;
+    auto entry = fib.findExactMatch("/prefix");
+    if (entry == nullptr) {
+      return nextHops;
+    }
+    for (const auto& nextHop : entry->getNextHops()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+      if (transport == nullptr)
+        continue;
+      Ptr<Channel> channel = transport->GetNetDevice()->GetChannel();
+      Ptr<Node> otherNode = channel->GetDevice(0)->GetNode();
+      if (otherNode == node)
+        otherNode = channel->GetDevice(1)->GetNode();
+      nextHops[Names::FindName(otherNode)] = nextHop.getCost();
+    }
+    return nextHops;
+  };
+
+  std::map<std::string, uint64_t> viaB{{"B4", 2}};
+  std::map<std::string, uint64_t> viaC{{"C4", 10}};
+  std::map<std::string, uint64_t> direct{{"C4", 1}};
+
+  nfd::getScheduler().schedule(time::seconds(1), [&] {
+      BOOST_CHECK(getNextHops("A4") == viaB);
+      BOOST_CHECK(getNextHops("B4") == direct);
+      LinkControlHelper::FailLink(Names::Find<Node>("A4"), Names::Find<Node>("B4"));
+    });
+
+  nfd::getScheduler().schedule(time::seconds(2), [&] {
+      BOOST_CHECK(getNextHops("A4") == viaC);
+      BOOST_CHECK(getNextHops("B4") == direct);
+      LinkControlHelper::UpLink(Names::Find<Node>("A4"), Names::Find<Node>("B4"));
+    });
+
+  nfd::getScheduler().schedule(time::seconds(3), [&] {
+      BOOST_CHECK(getNextHops("A4") == viaB);
+      BOOST_CHECK(getNextHops("B4") == direct);
+    });
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  ndn::GlobalRoutingHelper::SetDynamicMode(false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -18,6 +18,7 @@
  **/
 
 #include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
 #include "../tests-common.hpp"
 
 #include "ns3/point-to-point-module.h"
@@ -62,6 +63,59 @@ BOOST_AUTO_TEST_CASE(TestNfdContentStorePolicy)
   BOOST_CHECK_EQUAL(protoNode1->getForwarder()->getCs().getPolicy()->getName(), "priority_fifo");
 }
 
+BOOST_FIXTURE_TEST_CASE(Lightweight, ScenarioHelperWithCleanupFixture)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  getStackHelper().setLightweight(true);
+  getStackHelper().setCsSize(10);
+
+  createTopology({
+      {"1", "2"},
+      {"2", "3"}
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+      {"2", "3", "/prefix", 1},
+    });
+
+  StrategyChoiceHelper::Install(getNode("2"), "/prefix", "/localhost/nfd/strategy/multicast");
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "1s"},
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Ptr<L3Protocol> ndn = L3Protocol::getL3Protocol(getNode("2"));
+  BOOST_CHECK(ndn->isLightweight());
+  BOOST_CHECK(ndn->getFibManager() == nullptr);
+  BOOST_CHECK_EQUAL(ndn->getForwarder()->getCs().getLimit(), 10);
+  BOOST_CHECK_EQUAL(ndn->getForwarder()->getFib().size(), 1);
+  const auto& strategy = ndn->getForwarder()->getStrategyChoice().findEffectiveStrategy("/prefix");
+  BOOST_CHECK_EQUAL(strategy.getInstanceName().getPrefix(-1), Name("/localhost/nfd/strategy/multicast"));
+
+  // the inject face is created on first use, with the route of NFD Management Protocol
+  BOOST_CHECK(ndn->getForwarder()->getFib().findExactMatch("/localhost/nfd") == nullptr);
+  Interest command("/localhost/nfd/status/general");
+  command.setCanBePrefix(false);
+  ndn->injectInterest(command);
+  BOOST_CHECK(ndn->getForwarder()->getFib().findExactMatch("/localhost/nfd") != nullptr);
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  BOOST_CHECK_GT(getFace("3", "2")->getCounters().nInInterests, 0);
+  BOOST_CHECK_EQUAL(getFace("3", "2")->getCounters().nInInterests,
+                    getFace("1", "2")->getCounters().nInData);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
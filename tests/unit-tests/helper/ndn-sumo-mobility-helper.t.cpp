@@ -0,0 +1,235 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-sumo-mobility-helper.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-net-device-transport.hpp"
+#include "daemon/common/global.hpp"
+
+#include "../tests-common.hpp"
+
+#include "ns3/mobility-model.h"
+#include "ns3/point-to-point-module.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+namespace ns3 {
+namespace ndn {
+
+class SumoMobilityHelperFixture : public CleanupFixture
+{
+public:
+  SumoMobilityHelperFixture()
+    : xmlFile(boost::filesystem::temp_directory_path() /
+              boost::filesystem::unique_path("ndnsim-fcd-%%%%-%%%%.xml"))
+    , binaryFile(xmlFile.string() + ".bin")
+  {
+    // vehicle a leaves at 2s, and vehicle d reuses its node
+    std::ofstream(xmlFile.string()) << R"XML(<?xml version="1.0" encoding="UTF-8"?>
+<!-- generated by SUMO
+<configuration>
+    <fcd-output value="fcd.xml"/>
+</configuration>
+-->
+<fcd-export>
+    <timestep time="0.00">
+        <vehicle id="a" x="0.00" y="0.00" angle="90.00" speed="10.00"/>
+    </timestep>
+    <timestep time="1.00">
+        <vehicle id="a" x="10.00" y="0.00" angle="90.00" speed="10.00"/>
+        <vehicle id="b" x="100.00" y="0.00" angle="90.00" speed="0.00"/>
+    </timestep>
+    <timestep time="2.00">
+        <vehicle id="b" x="110.00" y="0.00" angle="90.00" speed="10.00"/>
+    </timestep>
+    <timestep time="3.00">
+        <vehicle id="b" x="120.00" y="0.00" angle="90.00" speed="10.00"/>
+        <vehicle id="c" x="5.00" y="5.00" angle="90.00" speed="0.00"/>
+    </timestep>
+    <timestep time="4.00">
+        <vehicle id="c" x="6.00" y="5.00" angle="90.00" speed="1.00"/>
+        <vehicle id="d" x="7.00" y="7.00" angle="90.00" speed="0.00"/>
+    </timestep>
+</fcd-export>
+)XML";
+
+    nodes.Create(3);
+    PointToPointHelper p2p;
+    p2p.Install(nodes.Get(0), nodes.Get(1));
+    p2p.Install(nodes.Get(1), nodes.Get(2));
+
+    StackHelper ndnHelper;
+    ndnHelper.Install(nodes);
+  }
+
+  ~SumoMobilityHelperFixture()
+  {
+    boost::filesystem::remove(xmlFile);
+    boost::filesystem::remove(binaryFile);
+  }
+
+  bool
+  isEnabled(uint32_t i)
+  {
+    bool isEnabled = false;
+    for (const auto& face : L3Protocol::getL3Protocol(nodes.Get(i))->getFaceTable()) {
+      if (dynamic_cast<NetDeviceTransport*>(face.getTransport()) != nullptr) {
+        isEnabled = face.getTransport()->getState() == nfd::face::TransportState::UP;
+      }
+    }
+    return isEnabled;
+  }
+
+  Vector
+  getPosition(uint32_t i)
+  {
+    return nodes.Get(i)->GetObject<MobilityModel>()->GetPosition();
+  }
+
+  void
+  checkTrace(const std::string& fileName)
+  {
+    SumoMobilityHelper sumoHelper(fileName);
+    sumoHelper.SetLookAhead(Seconds(1));
+    sumoHelper.Install(nodes);
+
+    nfd::getScheduler().schedule(time::milliseconds(500), [this] {
+        BOOST_CHECK(isEnabled(0));
+        BOOST_CHECK(!isEnabled(1));
+        BOOST_CHECK(!isEnabled(2));
+        BOOST_CHECK_CLOSE(getPosition(0).x, 5, 0.001);
+      });
+    nfd::getScheduler().schedule(time::milliseconds(1500), [this] {
+        // vehicle a is deactivated after its last timestep
+        BOOST_CHECK(!isEnabled(0));
+        BOOST_CHECK(isEnabled(1));
+        BOOST_CHECK_CLOSE(getPosition(1).x, 105, 0.001);
+      });
+    nfd::getScheduler().schedule(time::milliseconds(2500), [this] {
+        BOOST_CHECK(!isEnabled(0));
+        BOOST_CHECK(isEnabled(1));
+        BOOST_CHECK(!isEnabled(2));
+      });
+    nfd::getScheduler().schedule(time::milliseconds(3500), [this] {
+        BOOST_CHECK(isEnabled(2));
+        BOOST_CHECK_CLOSE(getPosition(2).x, 5.5, 0.001);
+        BOOST_CHECK_CLOSE(getPosition(2).y, 5, 0.001);
+
+        // the node of vehicle a has been moved to vehicle d, without passing between them
+        BOOST_CHECK(!isEnabled(0));
+        BOOST_CHECK_CLOSE(getPosition(0).x, 7, 0.001);
+        BOOST_CHECK_CLOSE(getPosition(0).y, 7, 0.001);
+      });
+    nfd::getScheduler().schedule(time::milliseconds(4500), [this] {
+        // all vehicles have left at the end of the trace
+        BOOST_CHECK(!isEnabled(0));
+        BOOST_CHECK(!isEnabled(1));
+        BOOST_CHECK(!isEnabled(2));
+        BOOST_CHECK_CLOSE(getPosition(0).x, 7, 0.001);
+        BOOST_CHECK_CLOSE(getPosition(0).y, 7, 0.001);
+      });
+
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+  }
+
+public:
+  boost::filesystem::path xmlFile;
+  boost::filesystem::path binaryFile;
+  NodeContainer nodes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperSumoMobilityHelper, SumoMobilityHelperFixture)
+
+BOOST_AUTO_TEST_CASE(Xml)
+{
+  checkTrace(xmlFile.string());
+}
+
+BOOST_AUTO_TEST_CASE(Binary)
+{
+  SumoMobilityHelper::ConvertToBinary(xmlFile.string(), binaryFile.string());
+  checkTrace(binaryFile.string());
+}
+
+BOOST_AUTO_TEST_CASE(WaitForNode)
+{
+  // vehicle d enters while all nodes are in use, and gets the node of vehicle a when it leaves
+  std::ofstream(xmlFile.string()) << R"XML(<fcd-export>
+    <timestep time="0.00">
+        <vehicle id="a" x="0.00" y="0.00"/>
+        <vehicle id="b" x="10.00" y="0.00"/>
+        <vehicle id="c" x="20.00" y="0.00"/>
+        <vehicle id="d" x="30.00" y="0.00"/>
+    </timestep>
+    <timestep time="1.00">
+        <vehicle id="a" x="1.00" y="0.00"/>
+        <vehicle id="b" x="10.00" y="1.00"/>
+        <vehicle id="c" x="20.00" y="1.00"/>
+        <vehicle id="d" x="30.00" y="1.00"/>
+    </timestep>
+    <timestep time="2.00">
+        <vehicle id="b" x="10.00" y="2.00"/>
+        <vehicle id="c" x="20.00" y="2.00"/>
+        <vehicle id="d" x="30.00" y="2.00"/>
+    </timestep>
+    <timestep time="3.00">
+        <vehicle id="b" x="10.00" y="3.00"/>
+        <vehicle id="c" x="20.00" y="3.00"/>
+        <vehicle id="d" x="30.00" y="3.00"/>
+    </timestep>
+</fcd-export>
+)XML";
+
+  SumoMobilityHelper sumoHelper(xmlFile.string());
+  sumoHelper.SetLookAhead(Seconds(1));
+  sumoHelper.Install(nodes);
+
+  nfd::getScheduler().schedule(time::milliseconds(500), [this] {
+      BOOST_CHECK(isEnabled(0));
+      BOOST_CHECK(isEnabled(1));
+      BOOST_CHECK(isEnabled(2));
+      BOOST_CHECK_CLOSE(getPosition(0).x, 0.5, 0.001);
+    });
+  nfd::getScheduler().schedule(time::milliseconds(1500), [this] {
+      BOOST_CHECK(!isEnabled(0));
+      BOOST_CHECK_CLOSE(getPosition(0).x, 30, 0.001);
+      BOOST_CHECK_CLOSE(getPosition(0).y, 2, 0.001);
+    });
+  nfd::getScheduler().schedule(time::milliseconds(2500), [this] {
+      BOOST_CHECK(isEnabled(0));
+      BOOST_CHECK_CLOSE(getPosition(0).x, 30, 0.001);
+      BOOST_CHECK_CLOSE(getPosition(0).y, 2.5, 0.001);
+    });
+  nfd::getScheduler().schedule(time::milliseconds(3500), [this] {
+      BOOST_CHECK(!isEnabled(0));
+      BOOST_CHECK(!isEnabled(1));
+      BOOST_CHECK(!isEnabled(2));
+    });
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -91,6 +91,29 @@ BOOST_AUTO_TEST_CASE(EncodePrintData)
   }
 }
 
+BOOST_AUTO_TEST_CASE(Decode)
+{
+  Data data("/other/prefix");
+  data.setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(data);
+  lp::Packet lpPacket(data.wireEncode());
+  auto wire(lpPacket.wireEncode());
+
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddHeader(BlockHeader(wire));
+
+  BlockHeader header;
+  BOOST_CHECK_EQUAL(packet->RemoveHeader(header), wire.size());
+  BOOST_CHECK_EQUAL(packet->GetSize(), 0);
+  BOOST_CHECK(header.getBlock() == wire);
+
+  // TLV-LENGTH exceeds the number of bytes in the packet
+  const uint8_t truncated[] = {0x08, 0x06, 0x00, 0x00};
+  BlockHeader truncatedHeader;
+  Ptr<Packet> truncatedPacket = Create<Packet>(truncated, sizeof(truncated));
+  BOOST_CHECK_THROW(truncatedPacket->PeekHeader(truncatedHeader), ::ndn::tlv::Error);
+}
+
 BOOST_AUTO_TEST_CASE(PrintLpPacket)
 {
   Interest interest("/prefix");
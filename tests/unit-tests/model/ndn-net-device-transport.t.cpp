@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-net-device-transport.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include "ns3/drop-tail-queue.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnNetDeviceTransport, ScenarioHelperWithCleanupFixture)
+
+BOOST_AUTO_TEST_CASE(ReplaceTxQueue)
+{
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  createTopology({
+      {"1", "2"}
+    });
+
+  auto transport = dynamic_cast<NetDeviceTransport*>(getFace("1", "2")->getTransport());
+  BOOST_REQUIRE(transport != nullptr);
+  Ptr<NetDevice> device = transport->GetNetDevice();
+  BOOST_CHECK_EQUAL(transport->getSendQueueCapacity(), 20 * 1500);
+  BOOST_CHECK_EQUAL(transport->getSendQueueLength(), 0);
+
+  // queue replaced after the stack is installed is picked up when the simulation starts
+  auto queue1 = CreateObject<DropTailQueue<Packet>>();
+  queue1->SetMaxSize(QueueSize("3000B"));
+  device->SetAttribute("TxQueue", PointerValue(queue1));
+
+  Simulator::Stop(Seconds(0.5));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(transport->getSendQueueCapacity(), 3000);
+  BOOST_CHECK_EQUAL(transport->getSendQueueLength(), 0);
+  queue1->Enqueue(Create<Packet>(100));
+  BOOST_CHECK_EQUAL(transport->getSendQueueLength(), 100);
+
+  // queue replaced while the simulation is running requires an explicit rebind
+  auto queue2 = CreateObject<DropTailQueue<Packet>>();
+  queue2->SetMaxSize(QueueSize("5p"));
+  device->SetAttribute("TxQueue", PointerValue(queue2));
+  transport->rebindTxQueue();
+
+  BOOST_CHECK_EQUAL(transport->getSendQueueCapacity(), 5 * 1500);
+  BOOST_CHECK_EQUAL(transport->getSendQueueLength(), 0);
+  queue2->Enqueue(Create<Packet>(200));
+  queue2->Enqueue(Create<Packet>(300));
+  BOOST_CHECK_EQUAL(transport->getSendQueueLength(), 500);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-shared-block-tag.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+
+#include "ns3/packet.h"
+#include "ns3/point-to-point-module.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnSharedBlockTag, ScenarioHelperWithCleanupFixture)
+
+BOOST_AUTO_TEST_CASE(ExtractAndRelease)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  const Block& wire = interest.wireEncode();
+
+  Ptr<Packet> packet = SharedBlockTag::CreatePacket(wire);
+  BOOST_CHECK_EQUAL(packet->GetSize(), wire.size());
+  BOOST_CHECK_EQUAL(SharedBlockTag::GetNInFlight(), 1);
+
+  Block block;
+  BOOST_CHECK(SharedBlockTag::ExtractBlock(packet->Copy(), block));
+  BOOST_CHECK(block == wire);
+  BOOST_CHECK_EQUAL(block.wire(), wire.wire()); // same buffer, no copy
+  BOOST_CHECK_EQUAL(SharedBlockTag::GetNInFlight(), 0);
+  BOOST_CHECK(!SharedBlockTag::ExtractBlock(packet, block));
+
+  Ptr<Packet> dropped = SharedBlockTag::CreatePacket(wire);
+  BOOST_CHECK_EQUAL(SharedBlockTag::GetNInFlight(), 1);
+  SharedBlockTag::Release(dropped);
+  BOOST_CHECK_EQUAL(SharedBlockTag::GetNInFlight(), 0);
+
+  BOOST_CHECK(!SharedBlockTag::ExtractBlock(Create<Packet>(), block));
+}
+
+BOOST_AUTO_TEST_CASE(ClearedOnDestroy)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+
+  Ptr<Packet> packet = SharedBlockTag::CreatePacket(interest.wireEncode());
+  BOOST_CHECK_EQUAL(SharedBlockTag::GetNInFlight(), 1);
+
+  // packet is still in flight when the simulation ends
+  Simulator::Destroy();
+  BOOST_CHECK_EQUAL(SharedBlockTag::GetNInFlight(), 0);
+
+  Block block;
+  BOOST_CHECK(!SharedBlockTag::ExtractBlock(packet, block));
+
+  // registry is cleared again at the end of the next run
+  SharedBlockTag::CreatePacket(interest.wireEncode());
+  BOOST_CHECK_EQUAL(SharedBlockTag::GetNInFlight(), 1);
+  Simulator::Destroy();
+  BOOST_CHECK_EQUAL(SharedBlockTag::GetNInFlight(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(PointToPointChain)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  getStackHelper().setSharedWire(true);
+
+  createTopology({
+      {"1", "2"},
+      {"2", "3"}
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+      {"2", "3", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "1s"},
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  BOOST_CHECK_GT(getFace("3", "2")->getCounters().nInInterests, 0);
+  BOOST_CHECK_EQUAL(getFace("3", "2")->getCounters().nInInterests,
+                    getFace("1", "2")->getCounters().nInData);
+  BOOST_CHECK_EQUAL(SharedBlockTag::GetNInFlight(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RemoteWithoutNdn)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  NetDeviceContainer devices = p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  // only the first node has the NDN stack
+  StackHelper stackHelper;
+  stackHelper.setSharedWire(true);
+  stackHelper.Install(nodes.Get(0));
+
+  auto face = L3Protocol::getL3Protocol(nodes.Get(0))->getFaceByNetDevice(devices.Get(0));
+  BOOST_REQUIRE(face != nullptr);
+  FibHelper::AddRoute(nodes.Get(0), "/prefix", face, 1);
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("10"));
+  consumerHelper.Install(nodes.Get(0)).Stop(Seconds(1));
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  // packets dropped by the remote node do not leave blocks in the registry
+  BOOST_CHECK_GT(face->getCounters().nOutInterests, 0);
+  BOOST_CHECK_EQUAL(SharedBlockTag::GetNInFlight(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
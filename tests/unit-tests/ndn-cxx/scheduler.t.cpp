@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+static void
+scheduleInContext(uint32_t context, std::function<void()> f)
+{
+  Simulator::ScheduleWithContext(context, Seconds(0), MakeEvent(f));
+}
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxScheduler, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(OrderAndContext)
+{
+  ::ndn::DummyIoService io;
+  ::ndn::Scheduler scheduler(io);
+  std::vector<std::string> log;
+
+  scheduleInContext(1, [&] {
+      scheduler.schedule(time::milliseconds(10), [&] {
+          BOOST_CHECK_EQUAL(Simulator::GetContext(), 1);
+          log.push_back("a");
+        });
+      scheduler.schedule(time::milliseconds(10), [&] { log.push_back("b"); }); // same time, FIFO
+      auto c = scheduler.schedule(time::milliseconds(5), [&] { log.push_back("c"); });
+      scheduler.schedule(time::milliseconds(7), [&] { log.push_back("d"); });
+      BOOST_CHECK(c);
+      c.cancel(); // cancel the earliest event
+      BOOST_CHECK(!c);
+    });
+
+  scheduleInContext(2, [&] {
+      scheduler.schedule(time::milliseconds(1), [&] {
+          BOOST_CHECK_EQUAL(Simulator::GetContext(), 2);
+          log.push_back("e");
+          scheduler.schedule(time::milliseconds(1), [&] {
+              BOOST_CHECK_EQUAL(Simulator::GetContext(), 2);
+              log.push_back("f");
+            });
+        });
+    });
+
+  Simulator::Run();
+
+  std::vector<std::string> expected{"e", "f", "d", "a", "b"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(log.begin(), log.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(CancelFromCallback)
+{
+  ::ndn::DummyIoService io;
+  ::ndn::Scheduler scheduler(io);
+  int nFired = 0;
+  ::ndn::scheduler::EventId second;
+  ::ndn::scheduler::EventId third;
+
+  scheduleInContext(1, [&] {
+      scheduler.schedule(time::milliseconds(10), [&] {
+          ++nFired;
+          second.cancel(); // expires at the same time, but has not executed yet
+        });
+      second = scheduler.schedule(time::milliseconds(10), [&] { ++nFired; });
+      third = scheduler.schedule(time::milliseconds(20), [&] { ++nFired; });
+      scheduler.schedule(time::milliseconds(15), [&] {
+          ++nFired;
+          BOOST_CHECK(third);
+        });
+    });
+
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nFired, 3);
+  BOOST_CHECK_EQUAL(Simulator::Now().GetMilliSeconds(), 20);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
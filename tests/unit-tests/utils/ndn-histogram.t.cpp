@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-histogram.hpp"
+
+#include <limits>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnHistogram, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  Histogram histogram;
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMin(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMax(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMean(), 0.0);
+  BOOST_CHECK_EQUAL(histogram.getPercentile(50), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SmallValues)
+{
+  Histogram histogram;
+  for (uint64_t value = 1; value <= 100; ++value) {
+    histogram.record(value);
+  }
+
+  // values below 128 are exact
+  BOOST_CHECK_EQUAL(histogram.getCount(), 100);
+  BOOST_CHECK_EQUAL(histogram.getMin(), 1);
+  BOOST_CHECK_EQUAL(histogram.getMax(), 100);
+  BOOST_CHECK_EQUAL(histogram.getMean(), 50.5);
+  BOOST_CHECK_EQUAL(histogram.getPercentile(0), 1);
+  BOOST_CHECK_EQUAL(histogram.getPercentile(50), 50);
+  BOOST_CHECK_EQUAL(histogram.getPercentile(99), 99);
+  BOOST_CHECK_EQUAL(histogram.getPercentile(100), 100);
+}
+
+BOOST_AUTO_TEST_CASE(LargeValues)
+{
+  Histogram histogram;
+  for (uint64_t value = 1000; value <= 1000000; value += 1000) {
+    histogram.record(value);
+  }
+  histogram.record(std::numeric_limits<uint64_t>::max());
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), 1001);
+  BOOST_CHECK_EQUAL(histogram.getMin(), 1000);
+  BOOST_CHECK_EQUAL(histogram.getMax(), std::numeric_limits<uint64_t>::max());
+
+  // within the relative error of the buckets, and never below the exact value
+  BOOST_CHECK_GE(histogram.getPercentile(50), 501000);
+  BOOST_CHECK_LE(histogram.getPercentile(50), 501000 * 1.016);
+  BOOST_CHECK_GE(histogram.getPercentile(99), 991000);
+  BOOST_CHECK_LE(histogram.getPercentile(99), 991000 * 1.016);
+  BOOST_CHECK_EQUAL(histogram.getPercentile(100), std::numeric_limits<uint64_t>::max());
+}
+
+BOOST_AUTO_TEST_CASE(MergeAndReset)
+{
+  Histogram first;
+  Histogram second;
+  first.record(10, 3);
+  second.record(20);
+  second.record(5000);
+
+  first.merge(second);
+  BOOST_CHECK_EQUAL(first.getCount(), 5);
+  BOOST_CHECK_EQUAL(first.getMin(), 10);
+  BOOST_CHECK_EQUAL(first.getMax(), 5000);
+  BOOST_CHECK_EQUAL(first.getMean(), 1010.0);
+  BOOST_CHECK_EQUAL(first.getPercentile(60), 10);
+  BOOST_CHECK_EQUAL(first.getPercentile(80), 20);
+
+  first.reset();
+  BOOST_CHECK_EQUAL(first.getCount(), 0);
+  BOOST_CHECK_EQUAL(first.getPercentile(50), 0);
+
+  first.record(7);
+  BOOST_CHECK_EQUAL(first.getMin(), 7);
+  BOOST_CHECK_EQUAL(first.getMax(), 7);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-seq-window.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnSeqWindow, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(SendAndErase)
+{
+  SeqWindow window;
+  BOOST_CHECK(window.empty());
+  BOOST_CHECK(window.find(0) == nullptr);
+
+  window.sent(10, Seconds(1));
+  window.sent(11, Seconds(2));
+  SeqWindow::Entry& entry = window.sent(10, Seconds(3));
+  BOOST_CHECK_EQUAL(window.size(), 2);
+  BOOST_CHECK_EQUAL(entry.firstSent, Seconds(1));
+  BOOST_CHECK_EQUAL(entry.lastSent, Seconds(3));
+  BOOST_CHECK_EQUAL(entry.nSent, 2);
+  BOOST_CHECK(window.find(9) == nullptr);
+  BOOST_CHECK(window.find(12) == nullptr);
+
+  window.erase(10);
+  BOOST_CHECK(window.find(10) == nullptr);
+  BOOST_REQUIRE(window.find(11) != nullptr);
+  BOOST_CHECK_EQUAL(window.find(11)->nSent, 1);
+
+  window.erase(11);
+  BOOST_CHECK(window.empty());
+
+  // entry of a sequence number sent again after erasure starts anew
+  SeqWindow::Entry& again = window.sent(10, Seconds(4));
+  BOOST_CHECK_EQUAL(again.firstSent, Seconds(4));
+  BOOST_CHECK_EQUAL(again.nSent, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Grow)
+{
+  SeqWindow window;
+  for (uint32_t seq = 1000; seq < 3000; ++seq) {
+    window.sent(seq, Seconds(0));
+  }
+  for (uint32_t seq = 1000; seq < 3000; seq += 2) {
+    window.erase(seq);
+  }
+
+  // lower sequence numbers, as requested by ConsumerZipfMandelbrot
+  window.sent(1, Seconds(1));
+  window.sent(5000, Seconds(1));
+  window.erase(5000);
+
+  BOOST_CHECK_EQUAL(window.size(), 1001);
+  BOOST_REQUIRE(window.find(1) != nullptr);
+  BOOST_CHECK_EQUAL(window.find(1)->firstSent, Seconds(1));
+  for (uint32_t seq = 1000; seq < 3000; ++seq) {
+    BOOST_CHECK_EQUAL(window.find(seq) != nullptr, seq % 2 == 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Timeouts)
+{
+  SeqWindow window;
+  window.sent(3, Seconds(1));
+  window.sent(1, Seconds(2));
+  window.sent(2, Seconds(2));
+  window.sent(3, Seconds(2.5)); // timeout of 3 is still pending
+  window.sent(4, Seconds(3));
+  window.erase(1);
+
+  uint32_t seq = 0;
+  BOOST_CHECK_EQUAL(window.popExpired(Seconds(0.5), seq), false);
+  BOOST_CHECK_EQUAL(window.popExpired(Seconds(2), seq), true);
+  BOOST_CHECK_EQUAL(seq, 3);
+  BOOST_CHECK_EQUAL(window.popExpired(Seconds(2), seq), true);
+  BOOST_CHECK_EQUAL(seq, 2);
+  BOOST_CHECK_EQUAL(window.popExpired(Seconds(2), seq), false);
+
+  // retransmission starts a new timeout
+  window.sent(3, Seconds(4));
+  window.erase(4);
+  window.sent(4, Seconds(5)); // sent again after Data
+  BOOST_CHECK_EQUAL(window.popExpired(Seconds(4.5), seq), true);
+  BOOST_CHECK_EQUAL(seq, 3);
+  BOOST_CHECK_EQUAL(window.popExpired(Seconds(4.5), seq), false);
+  BOOST_CHECK_EQUAL(window.popExpired(Seconds(5), seq), true);
+  BOOST_CHECK_EQUAL(seq, 4);
+  BOOST_CHECK_EQUAL(window.find(4)->nSent, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Retransmissions)
+{
+  SeqWindow window;
+  for (uint32_t seq = 0; seq < 5; ++seq) {
+    window.sent(seq, Seconds(0));
+  }
+  window.scheduleRetx(3);
+  window.scheduleRetx(1);
+  window.scheduleRetx(4);
+  window.scheduleRetx(1);
+  window.erase(4);
+
+  uint32_t seq = 0;
+  BOOST_CHECK_EQUAL(window.popRetx(seq), true);
+  BOOST_CHECK_EQUAL(seq, 1);
+  BOOST_CHECK_EQUAL(window.popRetx(seq), true);
+  BOOST_CHECK_EQUAL(seq, 3);
+  BOOST_CHECK_EQUAL(window.popRetx(seq), false);
+  BOOST_CHECK(window.find(1) != nullptr);
+  BOOST_CHECK(window.find(3) != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -161,6 +161,117 @@ BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
 )STR"));
 }
 
+BOOST_AUTO_TEST_CASE(Histograms)
+{
+  AppDelayTracer::InstallAll(TEST_TRACE.string(), AppDelayTracer::PER_APP, Seconds(10));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  Histogram delay1 = AppDelayTracer::GetAppHistogram(getNode("1"), 0, "FullDelayUS");
+  BOOST_CHECK_EQUAL(delay1.getCount(), 1);
+  BOOST_CHECK_EQUAL(delay1.getPercentile(50), 41766);
+
+  Histogram delay2 = AppDelayTracer::GetAppHistogram(getNode("2"), 0, "LastDelayUS");
+  BOOST_CHECK_EQUAL(delay2.getCount(), 2);
+  BOOST_CHECK_EQUAL(delay2.getMin(), 0);
+  BOOST_CHECK_EQUAL(delay2.getMax(), 20883);
+
+  Histogram hops2 = AppDelayTracer::GetPrefixHistogram(getNode("2"), "/prefix", "HopCount");
+  BOOST_CHECK_EQUAL(hops2.getCount(), 2);
+  BOOST_CHECK_EQUAL(hops2.getPercentile(100), 1);
+
+  BOOST_CHECK_EQUAL(AppDelayTracer::GetAppHistogram(getNode("3"), 0, "RetxCount").getCount(), 0);
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  // summaries of the first, partial period are written by Destroy()
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    R"STR(Time	Node	AppId	Prefix	Type	Count	Min	Mean	P50	P90	P99	P99.9	Max
+4	1	0	/prefix	FullDelayUS	1	41766	41766	41766	41766	41766	41766	41766
+4	1	0	/prefix	LastDelayUS	1	41766	41766	41766	41766	41766	41766	41766
+4	1	0	/prefix	HopCount	1	2	2	2	2	2	2	2
+4	1	0	/prefix	RetxCount	1	1	1	1	1	1	1	1
+4	2	0	/prefix	FullDelayUS	2	0	10441.5	0	20883	20883	20883	20883
+4	2	0	/prefix	LastDelayUS	2	0	10441.5	0	20883	20883	20883	20883
+4	2	0	/prefix	HopCount	2	1	1	1	1	1	1	1
+4	2	0	/prefix	RetxCount	2	1	1	1	1	1	1	1
+)STR");
+}
+
+BOOST_AUTO_TEST_CASE(HistogramPeriods)
+{
+  AppDelayTracer::InstallAll(TEST_TRACE.string(), AppDelayTracer::PER_APP, Seconds(2));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  // node 2 receives its Data in the second period, which ends with the simulation
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    R"STR(Time	Node	AppId	Prefix	Type	Count	Min	Mean	P50	P90	P99	P99.9	Max
+2	1	0	/prefix	FullDelayUS	1	41766	41766	41766	41766	41766	41766	41766
+2	1	0	/prefix	LastDelayUS	1	41766	41766	41766	41766	41766	41766	41766
+2	1	0	/prefix	HopCount	1	2	2	2	2	2	2	2
+2	1	0	/prefix	RetxCount	1	1	1	1	1	1	1	1
+4	2	0	/prefix	FullDelayUS	2	0	10441.5	0	20883	20883	20883	20883
+4	2	0	/prefix	LastDelayUS	2	0	10441.5	0	20883	20883	20883	20883
+4	2	0	/prefix	HopCount	2	1	1	1	1	1	1	1
+4	2	0	/prefix	RetxCount	2	1	1	1	1	1	1	1
+)STR");
+}
+
+BOOST_AUTO_TEST_CASE(HistogramsPerPrefix)
+{
+  // second consumer of the same prefix on node 1, whose Interest is aggregated in the PIT
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+          "1s", "1.9s"}
+    });
+
+  AppDelayTracer::InstallAll(TEST_TRACE.string(), AppDelayTracer::PER_PREFIX, Seconds(10));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  Histogram delay1 = AppDelayTracer::GetPrefixHistogram(getNode("1"), "/prefix", "FullDelayUS");
+  BOOST_CHECK_EQUAL(delay1.getCount(), 2);
+  BOOST_CHECK_EQUAL(delay1.getMin(), 41766);
+  BOOST_CHECK_EQUAL(delay1.getMax(), 41766);
+
+  // each application of the prefix gets the histogram of both
+  BOOST_CHECK_EQUAL(AppDelayTracer::GetAppHistogram(getNode("1"), 0, "HopCount").getCount(), 2);
+  BOOST_CHECK_EQUAL(AppDelayTracer::GetAppHistogram(getNode("1"), 1, "HopCount").getCount(), 2);
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    R"STR(Time	Node	AppId	Prefix	Type	Count	Min	Mean	P50	P90	P99	P99.9	Max
+4	1	-1	/prefix	FullDelayUS	2	41766	41766	41766	41766	41766	41766	41766
+4	1	-1	/prefix	LastDelayUS	2	41766	41766	41766	41766	41766	41766	41766
+4	1	-1	/prefix	HopCount	2	2	2	2	2	2	2	2
+4	1	-1	/prefix	RetxCount	2	1	1	1	1	1	1	1
+4	2	-1	/prefix	FullDelayUS	2	0	10441.5	0	20883	20883	20883	20883
+4	2	-1	/prefix	LastDelayUS	2	0	10441.5	0	20883	20883	20883	20883
+4	2	-1	/prefix	HopCount	2	1	1	1	1	1	1	1
+4	2	-1	/prefix	RetxCount	2	1	1	1	1	1	1	1
+)STR");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -22,12 +22,19 @@
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
 
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+
 #include "../../tests-common.hpp"
 
 namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_TRACE_SAMPLED =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "trace-sampled.txt";
 
 class L3RateTracerFixture : public ScenarioHelperWithCleanupFixture
 {
@@ -55,8 +62,32 @@ public:
   ~L3RateTracerFixture()
   {
     boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_TRACE_SAMPLED);
     L3RateTracer::Destroy(); // additional cleanup
   }
+
+  /**
+   * @brief Read the rows of a trace file, without the header, split into columns
+   */
+  static std::vector<std::vector<std::string>>
+  readRows(const boost::filesystem::path& file)
+  {
+    std::vector<std::vector<std::string>> rows;
+    std::ifstream is(file.string());
+    std::string line;
+    std::getline(is, line); // header
+    while (std::getline(is, line)) {
+      std::vector<std::string> columns;
+      std::istringstream lineIs(line);
+      std::string column;
+      while (std::getline(lineIs, column, '\t')) {
+        columns.push_back(column);
+      }
+      BOOST_REQUIRE_EQUAL(columns.size(), 9);
+      rows.push_back(columns);
+    }
+    return rows;
+  }
 };
 
 BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnL3RateTracer, L3RateTracerFixture)
@@ -119,6 +150,156 @@ BOOST_AUTO_TEST_CASE(NackTracing)
   BOOST_CHECK(os.match_pattern());
 }
 
+BOOST_AUTO_TEST_CASE(FilterFaces)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  L3TracerFilter filter;
+  filter.faces = {257};
+  L3RateTracer::Install(nodes, TEST_TRACE.string(), Seconds(1), filter);
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  boost::test_tools::output_test_stream os(TEST_TRACE.string().c_str(), true);
+
+  os << "Time	Node	FaceId	FaceDescr	Type	Packets	Kilobytes	PacketRaw	KilobytesRaw\n";
+  BOOST_CHECK(os.match_pattern());
+
+  // faces 1 and 256 are not traced
+  os << "1	1	257	appFace://	InInterests	0.8	0	1	0\n"
+     << "1	1	257	appFace://	OutInterests	0	0	0	0\n"
+     << "1	1	257	appFace://	InData	0	0	0	0\n"
+     << "1	1	257	appFace://	OutData	0	0	0	0\n"
+     << "1	1	257	appFace://	InNacks	0	0	0	0\n"
+     << "1	1	257	appFace://	OutNacks	0.8	0	1	0\n"
+     << "1	1	257	appFace://	InSatisfiedInterests	0	0	0	0\n"
+     << "1	1	257	appFace://	InTimedOutInterests	0	0	0	0\n"
+     << "1	1	257	appFace://	OutSatisfiedInterests	0	0	0	0\n"
+     << "1	1	257	appFace://	OutTimedOutInterests	0	0	0	0\n";
+  BOOST_CHECK(os.match_pattern());
+
+  os << "1	1	-1	all	SatisfiedInterests	4	0	5	0\n"
+     << "1	1	-1	all	TimedOutInterests	0.8	0	1	0\n";
+  BOOST_CHECK(os.match_pattern());
+}
+
+BOOST_AUTO_TEST_CASE(FilterPrefixes)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  L3TracerFilter filter;
+  filter.prefixes = {"/other"};
+  L3RateTracer::Install(nodes, TEST_TRACE.string(), Seconds(1), filter);
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time\tNode\tFaceId\tFaceDescr\tType\tPackets\tKilobytes\tPacketRaw\tKilobytesRaw\n");
+}
+
+BOOST_AUTO_TEST_CASE(Sampling)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/sampled"}, {"Frequency", "100"}},
+          "0s", "1s"},
+      {"1", "ns3::ndn::Producer",
+          {{"Prefix", "/sampled"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  const uint32_t sampling = 5;
+  L3TracerFilter filter;
+  filter.sampling = sampling;
+  L3RateTracer::Install(nodes, TEST_TRACE.string(), Seconds(1));
+  L3RateTracer::Install(nodes, TEST_TRACE_SAMPLED.string(), Seconds(1), filter);
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  // (FaceId, Type) => PacketRaw
+  auto readCounts = [] (const boost::filesystem::path& file) {
+    std::map<std::pair<std::string, std::string>, double> counts;
+    for (const auto& row : readRows(file)) {
+      counts[{row[2], row[4]}] = std::stod(row[7]);
+    }
+    return counts;
+  };
+  auto counts = readCounts(TEST_TRACE);
+  auto sampledCounts = readCounts(TEST_TRACE_SAMPLED);
+
+  BOOST_REQUIRE_EQUAL(counts.size(), sampledCounts.size());
+  size_t nNonZero = 0;
+  for (const auto& count : counts) {
+    BOOST_TEST_CONTEXT("FaceId " << count.first.first << ", " << count.first.second) {
+      BOOST_REQUIRE_EQUAL(sampledCounts.count(count.first), 1);
+      // each of the sampled packets stands for the packets of the same type on the same face
+      BOOST_CHECK_LT(std::abs(sampledCounts[count.first] - count.second), sampling);
+      if (count.second >= 50) {
+        ++nNonZero;
+      }
+    }
+  }
+  // Interests and Data in both directions, and satisfied Interests
+  BOOST_CHECK_GE(nNonZero, 5);
+}
+
+BOOST_AUTO_TEST_CASE(TimeWindow)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/window"}, {"Frequency", "10"}},
+          "0s", "3s"}
+    });
+
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  L3TracerFilter filter;
+  filter.start = Seconds(1);
+  filter.stop = Seconds(2);
+  L3RateTracer::Install(nodes, TEST_TRACE.string(), Seconds(1), filter);
+
+  Simulator::Stop(Seconds(3.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  double nInWindow = 0;
+  for (const auto& row : readRows(TEST_TRACE)) {
+    double time = std::stod(row[0]);
+    double packets = std::stod(row[7]);
+    BOOST_TEST_CONTEXT("Time " << row[0] << ", FaceId " << row[2] << ", " << row[4]) {
+      // nothing was traced before the window, so no face has been seen yet
+      BOOST_CHECK_GE(time, 2);
+      if (time == 2) {
+        nInWindow += packets;
+      }
+      else {
+        BOOST_CHECK_EQUAL(packets, 0);
+      }
+    }
+  }
+  BOOST_CHECK_GT(nInWindow, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-resource-tracer.hpp"
+
+#include <map>
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ResourceTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ResourceTracerFixture()
+  {
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~ResourceTracerFixture()
+  {
+    ResourceTracer::Destroy(); // additional cleanup
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnResourceTracer, ResourceTracerFixture)
+
+BOOST_AUTO_TEST_CASE(Rows)
+{
+  auto os = make_shared<std::ostringstream>();
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+  nodes.Add(getNode("2"));
+
+  Ptr<ResourceTracer> tracer = ResourceTracer::Install(nodes, make_shared<TextTraceSink>(os),
+                                                       Seconds(1));
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  tracer = nullptr; // destroy tracer
+
+  std::map<std::string, int> nRows; // by node and type
+  std::istringstream is(os->str());
+  std::string line;
+  while (std::getline(is, line)) {
+    std::istringstream row(line);
+    std::string time, node, type;
+    double value;
+    BOOST_REQUIRE(row >> time >> node >> type >> value);
+    ++nRows[node + "\t" + type];
+
+    if (node == "process" && type == "Events") {
+      BOOST_CHECK_GT(value, 0);
+    }
+    if (node == "1" && type == "Fib") {
+      BOOST_CHECK_GE(value, 1); // route to /prefix
+    }
+  }
+
+  // two periods
+  BOOST_CHECK_EQUAL(nRows.size(), 8 + 2 * 6);
+  for (const auto& type : {"RssBytes", "PeakRssBytes", "HeapBytes", "CpuS", "WallS", "SimRate",
+                           "Events", "EventRate"}) {
+    BOOST_CHECK_EQUAL(nRows[std::string("process\t") + type], 2);
+  }
+  for (const auto& node : {"1", "2"}) {
+    for (const auto& type : {"Pit", "Cs", "Fib", "Measurements", "DeadNonceList", "NameTree"}) {
+      BOOST_CHECK_EQUAL(nRows[std::string(node) + "\t" + type], 2);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
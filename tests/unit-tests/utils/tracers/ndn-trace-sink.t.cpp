@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-sink.hpp"
+
+#include <cstring>
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceSink, CleanupFixture)
+
+static const std::vector<TraceSink::Column> COLUMNS = {
+  {"Time", TraceSink::DOUBLE},
+  {"Node", TraceSink::STRING},
+  {"FaceId", TraceSink::INTEGER},
+};
+
+BOOST_AUTO_TEST_CASE(Text)
+{
+  auto os = make_shared<std::ostringstream>();
+  TextTraceSink sink(os);
+  sink.writeHeader(COLUMNS);
+
+  std::string node = "node1";
+  sink.write({0.5, node, 256});
+  sink.write({1.0, node, static_cast<int64_t>(-1)});
+
+  BOOST_CHECK_EQUAL(os->str(), "Time\tNode\tFaceId\n"
+                               "0.5\tnode1\t256\n"
+                               "1\tnode1\t-1\n");
+}
+
+class BinaryReader
+{
+public:
+  explicit
+  BinaryReader(const std::string& data)
+    : m_data(data)
+    , m_pos(0)
+  {
+  }
+
+  template<typename T>
+  T
+  read()
+  {
+    BOOST_REQUIRE_LE(m_pos + sizeof(T), m_data.size());
+    T value;
+    std::memcpy(&value, m_data.data() + m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return value;
+  }
+
+  std::string
+  readString(size_t length)
+  {
+    BOOST_REQUIRE_LE(m_pos + length, m_data.size());
+    std::string str = m_data.substr(m_pos, length);
+    m_pos += length;
+    return str;
+  }
+
+  bool
+  isEnd() const
+  {
+    return m_pos == m_data.size();
+  }
+
+private:
+  std::string m_data;
+  size_t m_pos;
+};
+
+BOOST_AUTO_TEST_CASE(Binary)
+{
+  auto os = make_shared<std::ostringstream>();
+  {
+    BinaryTraceSink sink(os, 2);
+    sink.writeHeader(COLUMNS);
+
+    std::string node1 = "node1";
+    std::string node2 = "node2";
+    sink.write({0.5, node1, 256});
+    sink.write({1.0, node2, 257});
+    sink.write({1.5, node1, static_cast<int64_t>(-1)});
+  } // remaining row is written on destruction
+
+  BinaryReader reader(os->str());
+  BOOST_CHECK_EQUAL(reader.readString(8), "NDNTRC1\n");
+  BOOST_REQUIRE_EQUAL(reader.read<uint32_t>(), 3);
+  for (const auto& column : COLUMNS) {
+    BOOST_CHECK_EQUAL(reader.read<uint8_t>(), column.type);
+    BOOST_CHECK_EQUAL(reader.readString(reader.read<uint32_t>()), column.name);
+  }
+
+  // strings are defined before the first block that uses them
+  BOOST_CHECK_EQUAL(reader.read<char>(), 'S');
+  BOOST_CHECK_EQUAL(reader.readString(reader.read<uint32_t>()), "node1");
+  BOOST_CHECK_EQUAL(reader.read<char>(), 'S');
+  BOOST_CHECK_EQUAL(reader.readString(reader.read<uint32_t>()), "node2");
+
+  BOOST_CHECK_EQUAL(reader.read<char>(), 'R');
+  BOOST_REQUIRE_EQUAL(reader.read<uint32_t>(), 2);
+  BOOST_CHECK_EQUAL(reader.read<double>(), 0.5);
+  BOOST_CHECK_EQUAL(reader.read<double>(), 1.0);
+  BOOST_CHECK_EQUAL(reader.read<uint32_t>(), 0);
+  BOOST_CHECK_EQUAL(reader.read<uint32_t>(), 1);
+  BOOST_CHECK_EQUAL(reader.read<int64_t>(), 256);
+  BOOST_CHECK_EQUAL(reader.read<int64_t>(), 257);
+
+  BOOST_CHECK_EQUAL(reader.read<char>(), 'R');
+  BOOST_REQUIRE_EQUAL(reader.read<uint32_t>(), 1);
+  BOOST_CHECK_EQUAL(reader.read<double>(), 1.5);
+  BOOST_CHECK_EQUAL(reader.read<uint32_t>(), 0);
+  BOOST_CHECK_EQUAL(reader.read<int64_t>(), -1);
+
+  BOOST_CHECK(reader.isEnd());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
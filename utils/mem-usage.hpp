@@ -27,6 +27,10 @@
 #include <sys/sysinfo.h>
 #endif
 
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
 #ifdef __APPLE__
 #include <mach/task.h>
 #include <mach/mach_traps.h>
@@ -34,9 +38,13 @@
 #include <unistd.h>
 #include <err.h>
 #include <sys/param.h>
+#include <sys/resource.h>
 #include <mach-o/ldsyms.h>
 #endif
 
+#include <fstream>
+#include <string>
+
 /**
  * @ingroup ndn-helpers
  * @brief Utility class to evaluate current usage of RAM
@@ -90,6 +98,56 @@ public:
     }
 
     return t_info.resident_size;
+#endif
+    // other systems are not yet supported
+    return -1;
+  }
+
+  /**
+   * @brief Get peak memory utilization (high water mark of resident set size) in bytes
+   */
+  static inline int64_t
+  GetPeak()
+  {
+#if defined(__linux__)
+    // VmHWM line of /proc/[pid]/status, in kB
+    std::ifstream is("/proc/self/status");
+    std::string line;
+    while (std::getline(is, line)) {
+      if (line.compare(0, 6, "VmHWM:") == 0) {
+        return std::stoll(line.substr(6)) * 1024;
+      }
+    }
+    return -1;
+
+#elif defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+      return -1;
+    }
+
+    return usage.ru_maxrss; // in bytes on macOS
+#endif
+    // other systems are not yet supported
+    return -1;
+  }
+
+  /**
+   * @brief Get number of bytes allocated on the heap (including blocks allocated with mmap)
+   *
+   * Only supported with the GNU C library.
+   */
+  static inline int64_t
+  GetHeap()
+  {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<int64_t>(info.uordblks + info.hblkhd);
+#elif defined(__GLIBC__)
+    // fields of mallinfo are int and wrap around above 2GB
+    struct mallinfo info = mallinfo();
+    return static_cast<int64_t>(static_cast<unsigned int>(info.uordblks)
+                                + static_cast<unsigned int>(info.hblkhd));
 #endif
     // other systems are not yet supported
     return -1;
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-histogram.hpp"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+Histogram::Histogram(int subBucketBits/* = 7*/)
+  : m_subBucketBits(subBucketBits)
+  , m_count(0)
+  , m_min(std::numeric_limits<uint64_t>::max())
+  , m_max(0)
+  , m_sum(0.0)
+{
+  NS_ASSERT_MSG(subBucketBits >= 1 && subBucketBits <= 32, "Invalid number of sub-bucket bits");
+}
+
+static int
+getHighestBit(uint64_t value)
+{
+  int bit = 0;
+  while (value >>= 1) {
+    ++bit;
+  }
+  return bit;
+}
+
+size_t
+Histogram::getBucket(uint64_t value) const
+{
+  uint64_t subBucketCount = uint64_t(1) << m_subBucketBits;
+  if (value < subBucketCount) {
+    return value;
+  }
+
+  // value >> shift is in [subBucketCount / 2, subBucketCount)
+  int shift = getHighestBit(value) - (m_subBucketBits - 1);
+  return (static_cast<size_t>(shift) << (m_subBucketBits - 1)) + (value >> shift);
+}
+
+uint64_t
+Histogram::getBucketHighest(size_t bucket) const
+{
+  uint64_t subBucketCount = uint64_t(1) << m_subBucketBits;
+  if (bucket < subBucketCount) {
+    return bucket;
+  }
+
+  int shift = static_cast<int>(bucket >> (m_subBucketBits - 1)) - 1;
+  uint64_t subBucket = bucket - (static_cast<uint64_t>(shift) << (m_subBucketBits - 1));
+  // for the last bucket, the shift wraps around to the largest uint64_t
+  return ((subBucket + 1) << shift) - 1;
+}
+
+void
+Histogram::record(uint64_t value, uint64_t count/* = 1*/)
+{
+  if (count == 0) {
+    return;
+  }
+
+  size_t bucket = getBucket(value);
+  if (bucket >= m_buckets.size()) {
+    m_buckets.resize(bucket + 1, 0);
+  }
+  m_buckets[bucket] += count;
+
+  m_count += count;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+  m_sum += static_cast<double>(value) * count;
+}
+
+void
+Histogram::merge(const Histogram& other)
+{
+  NS_ASSERT_MSG(m_subBucketBits == other.m_subBucketBits,
+                "Histograms with different sub-bucket bits cannot be merged");
+
+  if (other.m_count == 0) {
+    return;
+  }
+
+  if (other.m_buckets.size() > m_buckets.size()) {
+    m_buckets.resize(other.m_buckets.size(), 0);
+  }
+  for (size_t i = 0; i < other.m_buckets.size(); ++i) {
+    m_buckets[i] += other.m_buckets[i];
+  }
+
+  m_count += other.m_count;
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+  m_sum += other.m_sum;
+}
+
+void
+Histogram::reset()
+{
+  std::fill(m_buckets.begin(), m_buckets.end(), 0);
+  m_count = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+  m_sum = 0.0;
+}
+
+uint64_t
+Histogram::getPercentile(double percentile) const
+{
+  if (m_count == 0) {
+    return 0;
+  }
+
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_count));
+  rank = std::max<uint64_t>(rank, 1);
+
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < m_buckets.size(); ++bucket) {
+    seen += m_buckets[bucket];
+    if (seen >= rank) {
+      return std::min(getBucketHighest(bucket), m_max);
+    }
+  }
+  return m_max;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_HISTOGRAM_H
+#define NDN_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Histogram of non-negative integer values with logarithmic buckets
+ *
+ * Values below 2^subBucketBits are counted exactly.  Larger values are counted in buckets whose
+ * width grows with the magnitude of the values, so that every bucket is narrower than
+ * 1/2^(subBucketBits-1) of the values it contains (as in HdrHistogram).  With the default of 7
+ * bits, percentiles are reported within about 1.6% of the recorded values, and a histogram of
+ * delays up to 10 seconds in microseconds needs about 1200 buckets.
+ *
+ * Recording a value is an increment of its bucket.  Buckets are allocated up to the largest
+ * recorded value.
+ */
+class Histogram {
+public:
+  explicit
+  Histogram(int subBucketBits = 7);
+
+  /**
+   * @brief Count \p count occurrences of \p value
+   */
+  void
+  record(uint64_t value, uint64_t count = 1);
+
+  /**
+   * @brief Add all values counted in \p other, which must have the same subBucketBits
+   */
+  void
+  merge(const Histogram& other);
+
+  /**
+   * @brief Remove all values
+   */
+  void
+  reset();
+
+  uint64_t
+  getCount() const
+  {
+    return m_count;
+  }
+
+  /**
+   * @brief Get the smallest value, or 0 if the histogram is empty
+   */
+  uint64_t
+  getMin() const
+  {
+    return m_count > 0 ? m_min : 0;
+  }
+
+  /**
+   * @brief Get the largest value, or 0 if the histogram is empty
+   */
+  uint64_t
+  getMax() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @brief Get the mean of the values, or 0 if the histogram is empty
+   */
+  double
+  getMean() const
+  {
+    return m_count > 0 ? m_sum / m_count : 0.0;
+  }
+
+  /**
+   * @brief Get the value below or at which \p percentile percent of the values are
+   *
+   * The highest value of the bucket is returned, limited by the smallest and the largest
+   * recorded value.
+   *
+   * @param percentile percentile, from 0 to 100
+   * @return the value, or 0 if the histogram is empty
+   */
+  uint64_t
+  getPercentile(double percentile) const;
+
+private:
+  size_t
+  getBucket(uint64_t value) const;
+
+  uint64_t
+  getBucketHighest(size_t bucket) const;
+
+private:
+  int m_subBucketBits;
+  std::vector<uint64_t> m_buckets;
+  uint64_t m_count;
+  uint64_t m_min;
+  uint64_t m_max;
+  double m_sum;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_HISTOGRAM_H
@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-seq-window.hpp"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace ns3 {
+namespace ndn {
+
+static const size_t INITIAL_CAPACITY = 64;
+
+SeqWindow::SeqWindow()
+  : m_entries(INITIAL_CAPACITY)
+  , m_mask(INITIAL_CAPACITY - 1)
+  , m_base(0)
+  , m_top(0)
+  , m_size(0)
+  , m_timeouts(INITIAL_CAPACITY)
+{
+}
+
+SeqWindow::Entry&
+SeqWindow::insert(uint32_t seq)
+{
+  if (m_size == 0) {
+    m_base = seq;
+    m_top = static_cast<uint64_t>(seq) + 1;
+  }
+  else if (seq < m_base) {
+    reserve(m_top - seq);
+    m_base = seq;
+  }
+  else if (seq >= m_top) {
+    reserve(static_cast<uint64_t>(seq) + 1 - m_base);
+    m_top = static_cast<uint64_t>(seq) + 1;
+  }
+
+  Entry& entry = m_entries[seq & m_mask];
+  if (!entry.isUsed) {
+    entry = Entry();
+    entry.isUsed = true;
+    ++m_size;
+  }
+  return entry;
+}
+
+SeqWindow::Entry&
+SeqWindow::sent(uint32_t seq, Time now)
+{
+  Entry& entry = insert(seq);
+  if (entry.nSent == 0) {
+    entry.firstSent = now;
+  }
+  entry.lastSent = now;
+  ++entry.nSent;
+
+  if (!entry.isTimeoutPending) {
+    NS_ASSERT_MSG(m_timeouts.empty() || m_timeouts.back().start <= now,
+                  "Interests must be sent in the order of time");
+    if (m_timeouts.full()) {
+      m_timeouts.set_capacity(m_timeouts.capacity() * 2);
+    }
+    m_timeouts.push_back({seq, now});
+    entry.timeoutStart = now;
+    entry.isTimeoutPending = true;
+  }
+  return entry;
+}
+
+void
+SeqWindow::erase(uint32_t seq)
+{
+  Entry* entry = find(seq);
+  if (entry == nullptr) {
+    return;
+  }
+  entry->isUsed = false;
+  --m_size;
+
+  if (m_size == 0) {
+    m_base = 0;
+    m_top = 0;
+    return;
+  }
+  while (!m_entries[m_base & m_mask].isUsed) {
+    ++m_base;
+  }
+  while (!m_entries[(m_top - 1) & m_mask].isUsed) {
+    --m_top;
+  }
+}
+
+bool
+SeqWindow::popExpired(Time time, uint32_t& seq)
+{
+  while (!m_timeouts.empty()) {
+    const Timeout& timeout = m_timeouts.front();
+    Entry* entry = find(timeout.seq);
+    if (entry == nullptr || !entry->isTimeoutPending || entry->timeoutStart != timeout.start) {
+      m_timeouts.pop_front(); // sequence number was removed or sent again since
+      continue;
+    }
+    if (timeout.start > time) {
+      return false;
+    }
+    seq = timeout.seq;
+    entry->isTimeoutPending = false;
+    m_timeouts.pop_front();
+    return true;
+  }
+  return false;
+}
+
+void
+SeqWindow::scheduleRetx(uint32_t seq)
+{
+  Entry& entry = insert(seq);
+  if (entry.isRetxPending) {
+    return;
+  }
+  entry.isRetxPending = true;
+  m_retxHeap.push_back(seq);
+  std::push_heap(m_retxHeap.begin(), m_retxHeap.end(), std::greater<uint32_t>());
+}
+
+bool
+SeqWindow::popRetx(uint32_t& seq)
+{
+  while (!m_retxHeap.empty()) {
+    std::pop_heap(m_retxHeap.begin(), m_retxHeap.end(), std::greater<uint32_t>());
+    uint32_t top = m_retxHeap.back();
+    m_retxHeap.pop_back();
+
+    Entry* entry = find(top);
+    if (entry != nullptr && entry->isRetxPending) {
+      entry->isRetxPending = false;
+      seq = top;
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+SeqWindow::reserve(uint64_t span)
+{
+  if (span <= m_entries.size()) {
+    return;
+  }
+
+  uint64_t capacity = m_entries.size();
+  while (capacity < span) {
+    capacity *= 2;
+  }
+
+  std::vector<Entry> entries(capacity);
+  const uint64_t mask = capacity - 1;
+  for (uint64_t seq = m_base; seq < m_top; ++seq) {
+    entries[seq & mask] = m_entries[seq & m_mask];
+  }
+  m_entries.swap(entries);
+  m_mask = static_cast<uint32_t>(mask);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SEQ_WINDOW_H
+#define NDN_SEQ_WINDOW_H
+
+#include "ns3/nstime.h"
+
+#include <boost/circular_buffer.hpp>
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Per-sequence state of outstanding Interests of a consumer
+ *
+ * Entries are stored in a ring buffer indexed by sequence number, which grows (in powers of two)
+ * to cover all sequence numbers between the lowest and the highest outstanding one.  Entries of
+ * Interests waiting for their retransmission timeout are also kept in a FIFO queue in the order
+ * they were sent, and entries waiting for retransmission in a heap with the lowest sequence
+ * number on top.  Removed entries are skipped when they reach the head of the queue or the top
+ * of the heap.
+ *
+ * After the buffers have grown to their working size, no operation allocates memory.
+ */
+class SeqWindow {
+public:
+  struct Entry {
+    Time firstSent;         ///< @brief time when the first Interest was sent
+    Time lastSent;          ///< @brief time when the last Interest was sent
+    Time timeoutStart;      ///< @brief start of the retransmission timeout, if pending
+    uint32_t nSent = 0;     ///< @brief number of Interests sent
+    bool isUsed = false;
+    bool isTimeoutPending = false;
+    bool isRetxPending = false;
+  };
+
+  SeqWindow();
+
+  /**
+   * @brief Get number of tracked sequence numbers
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * @brief Get entry of a sequence number, or nullptr if it is not tracked
+   */
+  Entry*
+  find(uint32_t seq)
+  {
+    if (seq < m_base || seq >= m_top) {
+      return nullptr;
+    }
+    Entry& entry = m_entries[seq & m_mask];
+    return entry.isUsed ? &entry : nullptr;
+  }
+
+  /**
+   * @brief Record that an Interest for a sequence number is sent
+   *
+   * Like the first send, a send after the previous retransmission timeout has expired starts a
+   * new timeout.  Otherwise the pending timeout is kept.
+   *
+   * @param seq sequence number
+   * @param now current time, which must not be before the time of any previous send
+   * @return entry of the sequence number
+   */
+  Entry&
+  sent(uint32_t seq, Time now);
+
+  /**
+   * @brief Stop tracking a sequence number
+   */
+  void
+  erase(uint32_t seq);
+
+  /**
+   * @brief Remove the earliest pending retransmission timeout if it started at or before \p time
+   * @param[out] seq sequence number of the expired timeout
+   * @return whether a timeout has been removed
+   */
+  bool
+  popExpired(Time time, uint32_t& seq);
+
+  /**
+   * @brief Mark a tracked sequence number to be retransmitted
+   */
+  void
+  scheduleRetx(uint32_t seq);
+
+  /**
+   * @brief Remove the lowest sequence number marked to be retransmitted
+   * @param[out] seq removed sequence number
+   * @return whether a sequence number has been removed
+   */
+  bool
+  popRetx(uint32_t& seq);
+
+private:
+  Entry&
+  insert(uint32_t seq);
+
+  void
+  reserve(uint64_t span);
+
+private:
+  struct Timeout {
+    uint32_t seq;
+    Time start;
+  };
+
+  std::vector<Entry> m_entries;
+  uint32_t m_mask;
+  uint32_t m_base; ///< @brief lowest tracked sequence number
+  uint64_t m_top;  ///< @brief one past the highest tracked sequence number
+  size_t m_size;
+
+  boost::circular_buffer<Timeout> m_timeouts;
+  std::vector<uint32_t> m_retxHeap;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SEQ_WINDOW_H
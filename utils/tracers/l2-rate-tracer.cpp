@@ -29,13 +29,12 @@
 #include "ns3/log.h"
 
 #include <boost/lexical_cast.hpp>
-#include <fstream>
 
 NS_LOG_COMPONENT_DEFINE("L2RateTracer");
 
 namespace ns3 {
 
-static std::list<std::tuple<std::shared_ptr<std::ostream>, std::list<Ptr<L2RateTracer>>>>
+static std::list<std::tuple<std::shared_ptr<ndn::TraceSink>, std::list<Ptr<L2RateTracer>>>>
   g_tracers;
 
 void
@@ -48,42 +47,34 @@ void
 L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
   std::list<Ptr<L2RateTracer>> tracers;
-  std::shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    std::shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = std::shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  std::shared_ptr<ndn::TraceSink> sink = ndn::TraceSink::Open(file);
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     NS_LOG_DEBUG("Node: " << boost::lexical_cast<std::string>((*node)->GetId()));
 
-    Ptr<L2RateTracer> trace = Create<L2RateTracer>(outputStream, *node);
+    Ptr<L2RateTracer> trace = Create<L2RateTracer>(sink, *node);
     trace->SetAveragingPeriod(averagingPeriod);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->writeHeader(GetColumns());
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 L2RateTracer::L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
+  : L2RateTracer(std::make_shared<ndn::TextTraceSink>(os), node)
+{
+}
+
+L2RateTracer::L2RateTracer(std::shared_ptr<ndn::TraceSink> sink, Ptr<Node> node)
   : L2Tracer(node)
-  , m_os(os)
+  , m_sink(sink)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -104,32 +95,32 @@ L2RateTracer::SetAveragingPeriod(const Time& period)
 void
 L2RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  Print(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
 }
 
+const std::vector<ndn::TraceSink::Column>&
+L2RateTracer::GetColumns()
+{
+  static const std::vector<ndn::TraceSink::Column> columns = {
+    {"Time", ndn::TraceSink::DOUBLE},
+    {"Node", ndn::TraceSink::STRING},
+    {"Interface", ndn::TraceSink::STRING},
+    {"Type", ndn::TraceSink::STRING},
+    {"Packets", ndn::TraceSink::INTEGER},
+    {"Kilobytes", ndn::TraceSink::INTEGER},
+    {"PacketsRaw", ndn::TraceSink::INTEGER},
+    {"KilobytesRaw", ndn::TraceSink::DOUBLE},
+  };
+  return columns;
+}
+
 void
 L2RateTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-     << "Interface"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t"
-     << "Kilobytes"
-     << "\t"
-     << "PacketsRaw"
-     << "\t"
-     << "KilobytesRaw";
+  ndn::TextTraceSink::printColumnNames(os, GetColumns());
 }
 
 void
@@ -145,19 +136,29 @@ const double alpha = 0.8;
 #define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
 
 #define PRINTER(printName, fieldName, interface)                                                   \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
+  {                                                                                                \
+    static const std::string type(printName);                                                      \
+    static const std::string interfaceName(interface);                                             \
+    STATS(2).fieldName =                                                                           \
+      /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;   \
+    STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                         \
+                         + /*old value*/ (1 - alpha) * STATS(3).fieldName;                         \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << interface << "\t" << printName << "\t" \
-     << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t" << STATS(0).fieldName << "\t"     \
-     << STATS(1).fieldName / 1024.0 << "\n";
+    sink.write({time, m_node, interfaceName, type, STATS(2).fieldName, STATS(3).fieldName,         \
+                STATS(0).fieldName, STATS(1).fieldName / 1024.0});                                 \
+  }
 
 void
 L2RateTracer::Print(std::ostream& os) const
 {
-  Time time = Simulator::Now();
+  ndn::TextTraceSink sink(std::shared_ptr<std::ostream>(&os, std::bind([]{})));
+  Print(sink);
+}
+
+void
+L2RateTracer::Print(ndn::TraceSink& sink) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
 
   PRINTER("Drop", m_drop, "combined");
 }
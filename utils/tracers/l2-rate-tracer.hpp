@@ -21,6 +21,7 @@
 #define L2_RATE_TRACER_H
 
 #include "l2-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
@@ -42,12 +43,21 @@ public:
    * @brief Network layer tracer constructor
    */
   L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node);
+
+  /**
+   * @brief Network layer tracer constructor
+   * @param sink  sink to which rows are written
+   * @param node  pointer to the node
+   */
+  L2RateTracer(std::shared_ptr<ndn::TraceSink> sink, Ptr<Node> node);
+
   virtual ~L2RateTracer();
 
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written
+   * @param file File to which traces will be written.  If filename ends with ".bin", traces are
+   *             written in binary format (see ndn::BinaryTraceSink)
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
@@ -78,6 +88,18 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data into a sink
+   */
+  void
+  Print(ndn::TraceSink& sink) const;
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const std::vector<ndn::TraceSink::Column>&
+  GetColumns();
+
   virtual void
   Drop(Ptr<const Packet>);
 
@@ -89,7 +111,7 @@ private:
   Reset();
 
 private:
-  std::shared_ptr<std::ostream> m_os;
+  std::shared_ptr<ndn::TraceSink> m_sink;
   Time m_period;
   EventId m_printEvent;
 
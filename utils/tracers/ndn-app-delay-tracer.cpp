@@ -29,140 +29,129 @@
 #include "ns3/node-list.h"
 #include "ns3/log.h"
 
+#include "ns3/string.h"
+
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
-#include <fstream>
+#include <algorithm>
+#include <iterator>
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppDelayTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AppDelayTracer>>>>
-  g_tracers;
+static std::list<std::tuple<shared_ptr<TraceSink>, std::list<Ptr<AppDelayTracer>>>> g_tracers;
 
 void
 AppDelayTracer::Destroy()
 {
+  // write the histograms of the last, partial period
+  for (const auto& installed : g_tracers) {
+    for (const Ptr<AppDelayTracer>& tracer : std::get<1>(installed)) {
+      if (tracer->m_aggregation != NONE) {
+        tracer->WriteHistograms();
+      }
+    }
+  }
+
   g_tracers.clear();
 }
 
 void
 AppDelayTracer::InstallAll(const std::string& file)
 {
-  using namespace boost;
-  using namespace std;
+  InstallAll(file, NONE);
+}
 
+void
+AppDelayTracer::InstallAll(const std::string& file, Aggregation aggregation,
+                           Time period/* = Seconds(1.0)*/)
+{
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file);
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, sink, aggregation, period);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->writeHeader(aggregation == NONE ? GetColumns() : GetHistogramColumns());
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
 AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
 {
-  using namespace boost;
-  using namespace std;
+  Install(nodes, file, NONE);
+}
 
+void
+AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        Aggregation aggregation, Time period/* = Seconds(1.0)*/)
+{
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file);
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    Ptr<AppDelayTracer> trace = Install(*node, sink, aggregation, period);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->writeHeader(aggregation == NONE ? GetColumns() : GetHistogramColumns());
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
 AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file);
+  if (sink == nullptr) {
+    return;
   }
 
-  Ptr<AppDelayTracer> trace = Install(node, outputStream);
+  Ptr<AppDelayTracer> trace = Install(node, sink);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  sink->writeHeader(GetColumns());
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 Ptr<AppDelayTracer>
 AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+{
+  return Install(node, make_shared<TextTraceSink>(outputStream));
+}
+
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink)
+{
+  return Install(node, sink, NONE);
+}
+
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Aggregation aggregation,
+                        Time period/* = Seconds(1.0)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(outputStream, node);
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(sink, node);
+  trace->SetAggregation(aggregation, period);
 
   return trace;
 }
@@ -172,8 +161,22 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 //////////////////////////////////////////////////////////////////////////////
 
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : AppDelayTracer(make_shared<TextTraceSink>(os), node)
+{
+}
+
+AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : m_node(node)
+  , m_sink(make_shared<TextTraceSink>(os))
+  , m_aggregation(NONE)
+{
+  Connect();
+}
+
+AppDelayTracer::AppDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : m_nodePtr(node)
-  , m_os(os)
+  , m_sink(sink)
+  , m_aggregation(NONE)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -185,15 +188,11 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   }
 }
 
-AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
-  : m_node(node)
-  , m_os(os)
+AppDelayTracer::~AppDelayTracer()
 {
-  Connect();
+  m_printEvent.Cancel();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
-
 void
 AppDelayTracer::Connect()
 {
@@ -206,50 +205,222 @@ AppDelayTracer::Connect()
                                 MakeCallback(&AppDelayTracer::FirstInterestDataDelay, this));
 }
 
+const std::vector<TraceSink::Column>&
+AppDelayTracer::GetColumns()
+{
+  static const std::vector<TraceSink::Column> columns = {
+    {"Time", TraceSink::DOUBLE},
+    {"Node", TraceSink::STRING},
+    {"AppId", TraceSink::INTEGER},
+    {"SeqNo", TraceSink::INTEGER},
+    {"Type", TraceSink::STRING},
+    {"DelayS", TraceSink::DOUBLE},
+    {"DelayUS", TraceSink::DOUBLE},
+    {"RetxCount", TraceSink::INTEGER},
+    {"HopCount", TraceSink::INTEGER},
+  };
+  return columns;
+}
+
+const std::vector<TraceSink::Column>&
+AppDelayTracer::GetHistogramColumns()
+{
+  static const std::vector<TraceSink::Column> columns = {
+    {"Time", TraceSink::DOUBLE},
+    {"Node", TraceSink::STRING},
+    {"AppId", TraceSink::INTEGER},
+    {"Prefix", TraceSink::STRING},
+    {"Type", TraceSink::STRING},
+    {"Count", TraceSink::INTEGER},
+    {"Min", TraceSink::INTEGER},
+    {"Mean", TraceSink::DOUBLE},
+    {"P50", TraceSink::INTEGER},
+    {"P90", TraceSink::INTEGER},
+    {"P99", TraceSink::INTEGER},
+    {"P99.9", TraceSink::INTEGER},
+    {"Max", TraceSink::INTEGER},
+  };
+  return columns;
+}
+
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-     << "Node"
-     << "\t"
-     << "AppId"
-     << "\t"
-     << "SeqNo"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "DelayS"
-     << "\t"
-     << "DelayUS"
-     << "\t"
-     << "RetxCount"
-     << "\t"
-     << "HopCount"
-     << "";
+  TextTraceSink::printColumnNames(os, GetColumns());
+}
+
+static const std::string LAST_DELAY = "LastDelay";
+static const std::string FULL_DELAY = "FullDelay";
+
+static const std::string METRIC_TYPES[] = {"FullDelayUS", "LastDelayUS", "HopCount", "RetxCount"};
+
+static size_t
+GetMetric(const std::string& type)
+{
+  const std::string* metric = std::find(std::begin(METRIC_TYPES), std::end(METRIC_TYPES), type);
+  if (metric == std::end(METRIC_TYPES)) {
+    NS_FATAL_ERROR("Unknown type of histogram: " << type);
+  }
+  return metric - std::begin(METRIC_TYPES);
+}
+
+static uint64_t
+ToMicroSeconds(Time delay)
+{
+  return static_cast<uint64_t>(std::max<int64_t>(delay.GetMicroSeconds(), 0));
+}
+
+void
+AppDelayTracer::SetAggregation(Aggregation aggregation, Time period)
+{
+  m_aggregation = aggregation;
+  m_period = period;
+
+  m_printEvent.Cancel();
+  if (m_aggregation != NONE) {
+    m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+  }
+}
+
+void
+AppDelayTracer::PeriodicPrinter()
+{
+  WriteHistograms();
+
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::WriteHistograms()
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+
+  for (Aggregate& aggregate : m_aggregates) {
+    for (size_t metric = 0; metric < N_METRICS; ++metric) {
+      Histogram& histogram = aggregate.period[metric];
+      if (histogram.getCount() == 0)
+        continue;
+
+      m_sink->write({time, m_node, aggregate.appId, aggregate.prefix, METRIC_TYPES[metric],
+                     histogram.getCount(), histogram.getMin(), histogram.getMean(),
+                     histogram.getPercentile(50), histogram.getPercentile(90),
+                     histogram.getPercentile(99), histogram.getPercentile(99.9),
+                     histogram.getMax()});
+
+      aggregate.total[metric].merge(histogram);
+      histogram.reset();
+    }
+  }
+}
+
+size_t
+AppDelayTracer::GetAggregate(Ptr<App> app)
+{
+  auto it = m_appAggregates.find(app->GetId());
+  if (it != m_appAggregates.end()) {
+    return it->second;
+  }
+
+  std::string prefix;
+  StringValue prefixValue;
+  if (app->GetAttributeFailSafe("Prefix", prefixValue)) {
+    prefix = prefixValue.Get();
+  }
+
+  size_t index = m_aggregates.size();
+  if (m_aggregation == PER_PREFIX) {
+    for (size_t i = 0; i < m_aggregates.size(); ++i) {
+      if (m_aggregates[i].prefix == prefix) {
+        index = i;
+        break;
+      }
+    }
+  }
+
+  if (index == m_aggregates.size()) {
+    m_aggregates.emplace_back();
+    m_aggregates.back().appId = m_aggregation == PER_APP ? static_cast<int64_t>(app->GetId()) : -1;
+    m_aggregates.back().prefix = prefix;
+  }
+  m_appAggregates.emplace(app->GetId(), index);
+  return index;
+}
+
+Histogram
+AppDelayTracer::GetAppHistogram(Ptr<Node> node, uint32_t appId, const std::string& type)
+{
+  size_t metric = GetMetric(type);
+
+  Histogram histogram;
+  for (const auto& installed : g_tracers) {
+    for (const Ptr<AppDelayTracer>& tracer : std::get<1>(installed)) {
+      if (tracer->m_nodePtr != node || tracer->m_aggregation == NONE)
+        continue;
+
+      auto it = tracer->m_appAggregates.find(appId);
+      if (it != tracer->m_appAggregates.end()) {
+        const Aggregate& aggregate = tracer->m_aggregates[it->second];
+        histogram.merge(aggregate.total[metric]);
+        histogram.merge(aggregate.period[metric]);
+      }
+    }
+  }
+  return histogram;
+}
+
+Histogram
+AppDelayTracer::GetPrefixHistogram(Ptr<Node> node, const std::string& prefix,
+                                   const std::string& type)
+{
+  size_t metric = GetMetric(type);
+
+  Histogram histogram;
+  for (const auto& installed : g_tracers) {
+    for (const Ptr<AppDelayTracer>& tracer : std::get<1>(installed)) {
+      if (tracer->m_nodePtr != node || tracer->m_aggregation == NONE)
+        continue;
+
+      for (const Aggregate& aggregate : tracer->m_aggregates) {
+        if (aggregate.prefix == prefix) {
+          histogram.merge(aggregate.total[metric]);
+          histogram.merge(aggregate.period[metric]);
+        }
+      }
+    }
+  }
+  return histogram;
 }
 
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "LastDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << 1 << "\t"
-        << hopCount << "\n";
+  if (m_aggregation != NONE) {
+    // hop count is recorded once, with the full delay
+    m_aggregates[GetAggregate(app)].period[LAST_DELAY_US].record(ToMicroSeconds(delay));
+    return;
+  }
+
+  m_sink->write({Simulator::Now().ToDouble(Time::S), m_node, app->GetId(), seqno, LAST_DELAY,
+                 delay.ToDouble(Time::S), delay.ToDouble(Time::US), 1, hopCount});
 }
 
 void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "FullDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << retxCount
-        << "\t" << hopCount << "\n";
+  if (m_aggregation != NONE) {
+    Aggregate& aggregate = m_aggregates[GetAggregate(app)];
+    aggregate.period[FULL_DELAY_US].record(ToMicroSeconds(delay));
+    aggregate.period[RETX_COUNT].record(retxCount);
+    if (hopCount >= 0) {
+      aggregate.period[HOP_COUNT].record(hopCount);
+    }
+    return;
+  }
+
+  m_sink->write({Simulator::Now().ToDouble(Time::S), m_node, app->GetId(), seqno, FULL_DELAY,
+                 delay.ToDouble(Time::S), delay.ToDouble(Time::US), retxCount, hopCount});
 }
 
 } // namespace ndn
@@ -22,6 +22,9 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-trace-sink.hpp"
+#include "ns3/ndnSIM/utils/ndn-histogram.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
@@ -30,6 +33,8 @@
 
 #include <tuple>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3 {
 
@@ -43,18 +48,48 @@ class App;
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to obtain application-level delays
+ *
+ * By default, a row is written for every Data packet received by an application.  Alternatively,
+ * delays (in microseconds), hop counts, and retransmission counts can be aggregated into
+ * histograms (see Histogram), of each application or of all applications of a node that request
+ * the same prefix.  Then only a summary of each histogram is written every period (and for the
+ * last, partial period by Destroy()), and histograms of the whole simulation can be queried
+ * using GetAppHistogram() and GetPrefixHistogram().
  */
 class AppDelayTracer : public SimpleRefCount<AppDelayTracer> {
 public:
+  /**
+   * @brief Aggregation of the traced values
+   */
+  enum Aggregation {
+    NONE,      ///< @brief write a row for every Data packet
+    PER_APP,   ///< @brief aggregate values of each application
+    PER_PREFIX ///< @brief aggregate values of all applications of a node with the same prefix
+  };
+
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with ".bin", traces are written in binary format
+   *             (see BinaryTraceSink)
    *
    */
   static void
   InstallAll(const std::string& file);
 
+  /**
+   * @brief Helper method to install tracers on all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with ".bin", traces are written in binary format
+   *             (see BinaryTraceSink)
+   * @param aggregation Aggregation of the traced values
+   * @param period How often summaries of histograms will be written into the trace file
+   */
+  static void
+  InstallAll(const std::string& file, Aggregation aggregation, Time period = Seconds(1.0));
+
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
    *
@@ -65,6 +100,18 @@ public:
   static void
   Install(const NodeContainer& nodes, const std::string& file);
 
+  /**
+   * @brief Helper method to install tracers on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param aggregation Aggregation of the traced values
+   * @param period How often summaries of histograms will be written into the trace file
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, Aggregation aggregation,
+          Time period = Seconds(1.0));
+
   /**
    * @brief Helper method to install tracers on a specific simulation node
    *
@@ -91,9 +138,62 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param sink Sink to which rows are written.  Its header needs to be written with GetColumns()
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink);
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param sink Sink to which rows are written.  Its header needs to be written with GetColumns()
+   *             if \p aggregation is NONE, and with GetHistogramColumns() otherwise
+   * @param aggregation Aggregation of the traced values
+   * @param period How often summaries of histograms will be written into the trace file
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Aggregation aggregation,
+          Time period = Seconds(1.0));
+
+  /**
+   * @brief Get histogram of an application since the start of the simulation
+   *
+   * With PER_PREFIX aggregation, the histogram of all applications with the same prefix as the
+   * application is returned.
+   *
+   * @param node Node of the application, on which an aggregating tracer is installed using
+   *             InstallAll() or Install() with a file
+   * @param appId Id of the application
+   * @param type "FullDelayUS", "LastDelayUS", "HopCount", or "RetxCount"
+   * @returns the histogram, which is empty if nothing was traced
+   */
+  static Histogram
+  GetAppHistogram(Ptr<Node> node, uint32_t appId, const std::string& type);
+
+  /**
+   * @brief Get histogram of all applications of a node with a prefix since the start of the
+   *        simulation
+   *
+   * @param node Node of the applications, on which an aggregating tracer is installed using
+   *             InstallAll() or Install() with a file
+   * @param prefix Prefix of the applications
+   * @param type "FullDelayUS", "LastDelayUS", "HopCount", or "RetxCount"
+   * @returns the histogram, which is empty if nothing was traced
+   */
+  static Histogram
+  GetPrefixHistogram(Ptr<Node> node, const std::string& prefix, const std::string& type);
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
+   * Summaries of histograms of the current, partial period are written before the tracers are
+   * removed.
+   *
    * This method can be helpful if simulation scenario contains several independent run,
    * or if it is desired to do a postprocessing of the resulting data
    */
@@ -114,6 +214,13 @@ public:
    */
   AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's pointer
+   * @param sink  sink to which rows are written
+   * @param node  pointer to the node
+   */
+  AppDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -127,10 +234,38 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Get columns of the trace
+   */
+  static const std::vector<TraceSink::Column>&
+  GetColumns();
+
+  /**
+   * @brief Get columns of the trace with aggregated values
+   */
+  static const std::vector<TraceSink::Column>&
+  GetHistogramColumns();
+
 private:
   void
   Connect();
 
+  void
+  SetAggregation(Aggregation aggregation, Time period);
+
+  void
+  PeriodicPrinter();
+
+  /**
+   * @brief Write a summary of each non-empty histogram of the current period, and start a new
+   *        period
+   */
+  void
+  WriteHistograms();
+
+  size_t
+  GetAggregate(Ptr<App> app);
+
   void
   LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
 
@@ -142,7 +277,29 @@ private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
+
+  enum Metric {
+    FULL_DELAY_US,
+    LAST_DELAY_US,
+    HOP_COUNT,
+    RETX_COUNT,
+    N_METRICS
+  };
+
+  struct Aggregate {
+    int64_t appId; ///< @brief -1 if values of several applications are aggregated
+    std::string prefix;
+    Histogram period[N_METRICS]; ///< @brief values of the current period
+    Histogram total[N_METRICS];  ///< @brief values of the previous periods
+  };
+
+  Aggregation m_aggregation;
+  Time m_period;
+  EventId m_printEvent;
+
+  std::vector<Aggregate> m_aggregates;
+  std::unordered_map<uint32_t, size_t> m_appAggregates; ///< @brief aggregate of each app id
 };
 
 } // namespace ndn
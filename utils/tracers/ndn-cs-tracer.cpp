@@ -31,14 +31,12 @@
 
 #include <boost/lexical_cast.hpp>
 
-#include <fstream>
-
 NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<CsTracer>>>> g_tracers;
+static std::list<std::tuple<shared_ptr<TraceSink>, std::list<Ptr<CsTracer>>>> g_tracers;
 
 void
 CsTracer::Destroy()
@@ -49,121 +47,78 @@ CsTracer::Destroy()
 void
 CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file);
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<CsTracer> trace = Install(*node, sink, averagingPeriod);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->writeHeader(GetColumns());
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
 CsTracer::Install(const NodeContainer& nodes, const std::string& file,
                   Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file);
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<CsTracer> trace = Install(*node, sink, averagingPeriod);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->writeHeader(GetColumns());
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
 CsTracer::Install(Ptr<Node> node, const std::string& file,
                   Time averagingPeriod /* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file);
+  if (sink == nullptr) {
+    return;
   }
 
-  Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
+  Ptr<CsTracer> trace = Install(node, sink, averagingPeriod);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  sink->writeHeader(GetColumns());
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 Ptr<CsTracer>
 CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                   Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  return Install(node, make_shared<TextTraceSink>(outputStream), averagingPeriod);
+}
+
+Ptr<CsTracer>
+CsTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                  Time averagingPeriod /* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<CsTracer> trace = Create<CsTracer>(outputStream, node);
+  Ptr<CsTracer> trace = Create<CsTracer>(sink, node);
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
@@ -174,8 +129,20 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 //////////////////////////////////////////////////////////////////////////////
 
 CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : CsTracer(make_shared<TextTraceSink>(os), node)
+{
+}
+
+CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : m_node(node)
+  , m_sink(make_shared<TextTraceSink>(os))
+{
+  Connect();
+}
+
+CsTracer::CsTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : m_nodePtr(node)
-  , m_os(os)
+  , m_sink(sink)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -187,13 +154,6 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   }
 }
 
-CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
-  : m_node(node)
-  , m_os(os)
-{
-  Connect();
-}
-
 CsTracer::~CsTracer(){};
 
 void
@@ -218,25 +178,28 @@ CsTracer::SetAveragingPeriod(const Time& period)
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  Print(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
 }
 
+const std::vector<TraceSink::Column>&
+CsTracer::GetColumns()
+{
+  static const std::vector<TraceSink::Column> columns = {
+    {"Time", TraceSink::DOUBLE},
+    {"Node", TraceSink::STRING},
+    {"Type", TraceSink::STRING},
+    {"Packets", TraceSink::DOUBLE},
+  };
+  return columns;
+}
+
 void
 CsTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t";
+  TextTraceSink::printColumnNames(os, GetColumns());
 }
 
 void
@@ -246,13 +209,22 @@ CsTracer::Reset()
 }
 
 #define PRINTER(printName, fieldName)                                                              \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << m_stats.fieldName \
-     << "\n";
+  {                                                                                                \
+    static const std::string type(printName);                                                      \
+    sink.write({time, m_node, type, m_stats.fieldName});                                           \
+  }
 
 void
 CsTracer::Print(std::ostream& os) const
 {
-  Time time = Simulator::Now();
+  TextTraceSink sink(shared_ptr<std::ostream>(&os, std::bind([]{})));
+  Print(sink);
+}
+
+void
+CsTracer::Print(TraceSink& sink) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
 
   PRINTER("CacheHits", m_cacheHits);
   PRINTER("CacheMisses", m_cacheMisses);
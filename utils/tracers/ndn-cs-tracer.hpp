@@ -22,6 +22,8 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-trace-sink.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
@@ -64,7 +66,9 @@ public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with ".bin", traces are written in binary format
+   *             (see BinaryTraceSink)
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
    *
@@ -124,6 +128,16 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param sink Sink to which rows are written.  Its header needs to be written with GetColumns()
+   * @param averagingPeriod How often data will be written into the trace file
+   */
+  static Ptr<CsTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time averagingPeriod = Seconds(0.5));
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -147,6 +161,13 @@ public:
    */
   CsTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  sink to which rows are written
+   * @param node  pointer to the node
+   */
+  CsTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -168,6 +189,18 @@ public:
   void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data into a sink
+   */
+  void
+  Print(TraceSink& sink) const;
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const std::vector<TraceSink::Column>&
+  GetColumns();
+
 private:
   void
   Connect();
@@ -192,7 +225,7 @@ private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
 
   Time m_period;
   EventId m_printEvent;
@@ -27,18 +27,19 @@
 #include "ns3/node-list.h"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 
+#include "daemon/fw/face-table.hpp"
 #include "daemon/table/pit-entry.hpp"
 
-#include <fstream>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer>>>>
-  g_tracers;
+static std::list<std::tuple<shared_ptr<TraceSink>, std::list<Ptr<L3RateTracer>>>> g_tracers;
 
 void
 L3RateTracer::Destroy()
@@ -47,136 +48,125 @@ L3RateTracer::Destroy()
 }
 
 void
-L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                         const L3TracerFilter& filter/* = L3TracerFilter()*/)
 {
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file);
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<L3RateTracer> trace = Install(*node, sink, averagingPeriod, filter);
     tracers.push_back(trace);
   }
 
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->writeHeader(GetColumns());
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
 L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      const L3TracerFilter& filter/* = L3TracerFilter()*/)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file);
+  if (sink == nullptr) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<L3RateTracer> trace = Install(*node, sink, averagingPeriod, filter);
     tracers.push_back(trace);
   }
-  
+
   if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    sink->writeHeader(GetColumns());
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 void
 L3RateTracer::Install(Ptr<Node> node, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      const L3TracerFilter& filter/* = L3TracerFilter()*/)
 {
-  using namespace boost;
-  using namespace std;
-
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file);
+  if (sink == nullptr) {
+    return;
   }
 
-  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
+  Ptr<L3RateTracer> trace = Install(node, sink, averagingPeriod, filter);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  sink->writeHeader(GetColumns());
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(std::make_tuple(sink, tracers));
 }
 
 Ptr<L3RateTracer>
 L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                       Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  return Install(node, make_shared<TextTraceSink>(outputStream), averagingPeriod);
+}
+
+Ptr<L3RateTracer>
+L3RateTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      const L3TracerFilter& filter/* = L3TracerFilter()*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, node);
+  Ptr<L3RateTracer> trace = Create<L3RateTracer>(sink, node, filter);
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
 }
 
+const size_t L3RateTracer::ALL_FACES_SLOT;
+
+static const std::string ALL_FACES = "all";
+
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
-  : L3Tracer(node)
-  , m_os(os)
+  : L3RateTracer(make_shared<TextTraceSink>(os), node)
 {
-  SetAveragingPeriod(Seconds(1.0));
 }
 
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
-  , m_os(os)
+  , m_sink(make_shared<TextTraceSink>(os))
 {
+  NewSlot(nfd::face::INVALID_FACEID, ALL_FACES);
+  SetAveragingPeriod(Seconds(1.0));
+}
+
+L3RateTracer::L3RateTracer(shared_ptr<TraceSink> sink, Ptr<Node> node,
+                           const L3TracerFilter& filter/* = L3TracerFilter()*/)
+  : L3Tracer(node, filter)
+  , m_sink(sink)
+{
+  NewSlot(nfd::face::INVALID_FACEID, ALL_FACES);
+
+  nfd::FaceTable& faceTable = m_nodePtr->GetObject<L3Protocol>()->getFaceTable();
+  for (const Face& face : faceTable) {
+    if (IsFaceTraced(face)) {
+      AddSlot(face);
+    }
+  }
+  m_afterAddFace = faceTable.afterAdd.connect([this] (const Face& face) {
+      if (IsFaceTraced(face)) {
+        AddSlot(face);
+      }
+    });
+
   SetAveragingPeriod(Seconds(1.0));
 }
 
@@ -196,192 +186,218 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  UpdateRates();
+  Print(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
 
+const std::vector<TraceSink::Column>&
+L3RateTracer::GetColumns()
+{
+  static const std::vector<TraceSink::Column> columns = {
+    {"Time", TraceSink::DOUBLE},
+    {"Node", TraceSink::STRING},
+    {"FaceId", TraceSink::INTEGER},
+    {"FaceDescr", TraceSink::STRING},
+    {"Type", TraceSink::STRING},
+    {"Packets", TraceSink::DOUBLE},
+    {"Kilobytes", TraceSink::DOUBLE},
+    {"PacketRaw", TraceSink::DOUBLE},
+    {"KilobytesRaw", TraceSink::DOUBLE},
+  };
+  return columns;
+}
+
 void
 L3RateTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-     << "FaceId"
-     << "\t"
-     << "FaceDescr"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t"
-     << "Kilobytes"
-     << "\t"
-     << "PacketRaw"
-     << "\t"
-     << "KilobytesRaw";
+  TextTraceSink::printColumnNames(os, GetColumns());
 }
 
+const double alpha = 0.8;
+
 void
-L3RateTracer::Reset()
+L3RateTracer::UpdateRates()
 {
-  for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
+  const double period = m_period.ToDouble(Time::S);
+  const size_t n = m_packets.size();
+  const double* packets = m_packets.data();
+  const double* bytes = m_bytes.data();
+  double* packetRates = m_packetRates.data();
+  double* kilobyteRates = m_kilobyteRates.data();
+
+  // one pass over all counters of all faces, which the compiler can vectorize
+  for (size_t i = 0; i < n; ++i) {
+    packetRates[i] = /*new value*/ alpha * packets[i] / period
+                     + /*old value*/ (1 - alpha) * packetRates[i];
+    kilobyteRates[i] = /*new value*/ alpha * bytes[i] / period / 1024.0
+                       + /*old value*/ (1 - alpha) * kilobyteRates[i];
   }
 }
 
-const double alpha = 0.8;
+void
+L3RateTracer::Reset()
+{
+  std::fill(m_packets.begin(), m_packets.end(), 0.0);
+  std::fill(m_bytes.begin(), m_bytes.end(), 0.0);
+}
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
-#define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
-
-#define PRINTER(printName, fieldName)                                                              \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
-                                                                                                   \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+#define PRINTER(printName, counter)                                                                \
+  {                                                                                                \
+    static const std::string type(printName);                                                      \
+    size_t i = slot * N_COUNTERS + counter;                                                        \
+    sink.write({time, m_node, faceId, m_slotFaceInfos[slot], type, m_packetRates[i],               \
+                m_kilobyteRates[i], m_packets[i], m_bytes[i] / 1024.0});                           \
+  }
 
 void
 L3RateTracer::Print(std::ostream& os) const
 {
-  Time time = Simulator::Now();
+  TextTraceSink sink(shared_ptr<std::ostream>(&os, std::bind([]{})));
+  Print(sink);
+}
+
+void
+L3RateTracer::Print(TraceSink& sink) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
 
-  for (auto& stats : m_stats) {
-    if (stats.first == nfd::face::INVALID_FACEID)
+  // in the order of face ids
+  for (size_t slot : m_faceSlots) {
+    if (slot == ALL_FACES_SLOT || !m_isSlotUsed[slot])
       continue;
 
-    PRINTER("InInterests", m_inInterests);
-    PRINTER("OutInterests", m_outInterests);
+    int64_t faceId = static_cast<int64_t>(m_slotFaceIds[slot]);
 
-    PRINTER("InData", m_inData);
-    PRINTER("OutData", m_outData);
+    PRINTER("InInterests", IN_INTERESTS);
+    PRINTER("OutInterests", OUT_INTERESTS);
 
-    PRINTER("InNacks", m_inNack);
-    PRINTER("OutNacks", m_outNack);
+    PRINTER("InData", IN_DATA);
+    PRINTER("OutData", OUT_DATA);
 
-    PRINTER("InSatisfiedInterests", m_satisfiedInterests);
-    PRINTER("InTimedOutInterests", m_timedOutInterests);
+    PRINTER("InNacks", IN_NACKS);
+    PRINTER("OutNacks", OUT_NACKS);
 
-    PRINTER("OutSatisfiedInterests", m_outSatisfiedInterests);
-    PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
+    PRINTER("InSatisfiedInterests", SATISFIED_INTERESTS);
+    PRINTER("InTimedOutInterests", TIMED_OUT_INTERESTS);
+
+    PRINTER("OutSatisfiedInterests", OUT_SATISFIED_INTERESTS);
+    PRINTER("OutTimedOutInterests", OUT_TIMED_OUT_INTERESTS);
   }
 
-  {
-    auto i = m_stats.find(nfd::face::INVALID_FACEID);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
-    }
+  if (m_isSlotUsed[ALL_FACES_SLOT]) {
+    size_t slot = ALL_FACES_SLOT;
+    int64_t faceId = -1;
+    PRINTER("SatisfiedInterests", SATISFIED_INTERESTS);
+    PRINTER("TimedOutInterests", TIMED_OUT_INTERESTS);
   }
 }
 
+size_t
+L3RateTracer::NewSlot(nfd::FaceId faceId, const std::string& faceInfo)
+{
+  size_t slot = m_slotFaceIds.size();
+  m_slotFaceIds.push_back(faceId);
+  m_slotFaceInfos.push_back(faceInfo);
+  m_isSlotUsed.push_back(0);
+
+  size_t size = (slot + 1) * N_COUNTERS;
+  m_packets.resize(size, 0.0);
+  m_bytes.resize(size, 0.0);
+  m_packetRates.resize(size, 0.0);
+  m_kilobyteRates.resize(size, 0.0);
+  return slot;
+}
+
+size_t
+L3RateTracer::AddSlot(const Face& face)
+{
+  nfd::FaceId faceId = face.getId();
+  if (faceId >= m_faceSlots.size()) {
+    m_faceSlots.resize(faceId + 1, ALL_FACES_SLOT);
+  }
+  if (m_faceSlots[faceId] == ALL_FACES_SLOT) {
+    m_faceSlots[faceId] = NewSlot(faceId, boost::lexical_cast<std::string>(face.getLocalUri()));
+  }
+  return m_faceSlots[faceId];
+}
+
+size_t
+L3RateTracer::GetSlot(const Face& face)
+{
+  nfd::FaceId faceId = face.getId();
+  if (faceId < m_faceSlots.size() && m_faceSlots[faceId] != ALL_FACES_SLOT) {
+    return m_faceSlots[faceId];
+  }
+  // face was not added to the FaceTable of the node
+  return AddSlot(face);
+}
+
+void
+L3RateTracer::Count(size_t slot, size_t counter, size_t size/* = 0*/)
+{
+  // with sampling, each traced packet stands for several packets
+  size_t i = slot * N_COUNTERS + counter;
+  m_packets[i] += m_filter.sampling;
+  m_bytes[i] += static_cast<double>(size) * m_filter.sampling;
+  m_isSlotUsed[slot] = 1;
+}
+
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  if (CheckName(interest.getName())) {
-    AddInfo(face);
-    std::get<0>(m_stats[face.getId()]).m_outInterests++;
-    if (interest.hasWire()) {
-      std::get<1>(m_stats[face.getId()]).m_outInterests +=
-        interest.wireEncode().size();
-    }
-  }
+  Count(GetSlot(face), OUT_INTERESTS, interest.hasWire() ? interest.wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  if (CheckName(interest.getName())) {
-    AddInfo(face);
-    std::get<0>(m_stats[face.getId()]).m_inInterests++;
-    if (interest.hasWire()) {
-      std::get<1>(m_stats[face.getId()]).m_inInterests +=
-        interest.wireEncode().size();
-    }
-  }
+  Count(GetSlot(face), IN_INTERESTS, interest.hasWire() ? interest.wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  if (CheckName(data.getName())) {
-    AddInfo(face);
-    std::get<0>(m_stats[face.getId()]).m_outData++;
-    if (data.hasWire()) {
-      std::get<1>(m_stats[face.getId()]).m_outData +=
-        data.wireEncode().size();
-    }
-  }
+  Count(GetSlot(face), OUT_DATA, data.hasWire() ? data.wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  if (CheckName(data.getName())) {
-    AddInfo(face);
-    std::get<0>(m_stats[face.getId()]).m_inData++;
-    if (data.hasWire()) {
-      std::get<1>(m_stats[face.getId()]).m_inData +=
-        data.wireEncode().size();
-    }
-  } 
+  Count(GetSlot(face), IN_DATA, data.hasWire() ? data.wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::OutNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outNack++;
-  if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outNack +=
-      nack.getInterest().wireEncode().size();
-  }
+  const Interest& interest = nack.getInterest();
+  Count(GetSlot(face), OUT_NACKS, interest.hasWire() ? interest.wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::InNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inNack++;
-  if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inNack +=
-      nack.getInterest().wireEncode().size();
-  }
+  const Interest& interest = nack.getInterest();
+  Count(GetSlot(face), IN_NACKS, interest.hasWire() ? interest.wireEncode().size() : 0);
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  if (CheckName(entry.getName())) {
-    std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_satisfiedInterests++;
-    // no "size" stats
+  // no "size" stats
+  Count(ALL_FACES_SLOT, SATISFIED_INTERESTS);
 
-    for (const auto& in : entry.getInRecords()) {
-      AddInfo(in.getFace());
-      std::get<0>(m_stats[(in.getFace()).getId()]).m_satisfiedInterests ++;
+  for (const auto& in : entry.getInRecords()) {
+    if (IsFaceTraced(in.getFace())) {
+      Count(GetSlot(in.getFace()), SATISFIED_INTERESTS);
     }
+  }
 
-    for (const auto& out : entry.getOutRecords()) {
-      AddInfo(out.getFace());
-      std::get<0>(m_stats[(out.getFace()).getId()]).m_outSatisfiedInterests ++;
+  for (const auto& out : entry.getOutRecords()) {
+    if (IsFaceTraced(out.getFace())) {
+      Count(GetSlot(out.getFace()), OUT_SATISFIED_INTERESTS);
     }
   }
 }
@@ -389,35 +405,21 @@ L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, cons
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  if (CheckName(entry.getName())) {
-    std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_timedOutInterests++;
-    // no "size" stats
+  // no "size" stats
+  Count(ALL_FACES_SLOT, TIMED_OUT_INTERESTS);
 
-    for (const auto& in : entry.getInRecords()) {
-      AddInfo(in.getFace());
-      std::get<0>(m_stats[(in.getFace()).getId()]).m_timedOutInterests++;
-    }
-
-    for (const auto& out : entry.getOutRecords()) {
-      AddInfo(out.getFace());
-      std::get<0>(m_stats[(out.getFace()).getId()]).m_outTimedOutInterests++;
+  for (const auto& in : entry.getInRecords()) {
+    if (IsFaceTraced(in.getFace())) {
+      Count(GetSlot(in.getFace()), TIMED_OUT_INTERESTS);
     }
   }
-}
 
-void
-L3RateTracer::AddInfo(const Face& face)
-{
-  if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
-    m_faceInfos.insert(make_pair(face.getId(), boost::lexical_cast<std::string>(face.getLocalUri())));
+  for (const auto& out : entry.getOutRecords()) {
+    if (IsFaceTraced(out.getFace())) {
+      Count(GetSlot(out.getFace()), OUT_TIMED_OUT_INTERESTS);
+    }
   }
 }
 
-bool
-L3RateTracer::CheckName(const Name& name){
-    return (( name.getPrefix(1).compare("/parkinglot1") == 0 ) ||
-            ( name.getPrefix(1).compare("/parkinglot2") == 0 ));
-}
-
 } // namespace ndn
 } // namespace ns3
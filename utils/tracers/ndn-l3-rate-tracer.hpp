@@ -23,14 +23,17 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
 #include "ndn-l3-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 #include "ns3/node-container.h"
 
+#include <ndn-cxx/util/signal.hpp>
+
 #include <tuple>
-#include <map>
 #include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -38,19 +41,27 @@ namespace ndn {
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
+ *
+ * Counters of all faces are kept in flat arrays, with one slot of counters per face.  Slots are
+ * allocated when faces are added to the FaceTable, so that tracing a packet only needs to
+ * increment counters of the slot found by the face id.
  */
 class L3RateTracer : public L3Tracer {
 public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with ".bin", traces are written in binary format
+   *             (see BinaryTraceSink)
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
+   * @param filter Selection of the traced packets
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             const L3TracerFilter& filter = L3TracerFilter());
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -59,9 +70,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param filter Selection of the traced packets
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          const L3TracerFilter& filter = L3TracerFilter());
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -70,9 +83,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param filter Selection of the traced packets
    */
   static void
-  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          const L3TracerFilter& filter = L3TracerFilter());
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -97,6 +112,15 @@ public:
    */
   L3RateTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  sink to which rows are written
+   * @param node  pointer to the node
+   * @param filter  selection of the traced packets
+   */
+  L3RateTracer(shared_ptr<TraceSink> sink, Ptr<Node> node,
+               const L3TracerFilter& filter = L3TracerFilter());
+
   /**
    * @brief Destructor
    */
@@ -118,6 +142,24 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param sink Sink to which rows are written.  Its header needs to be written with GetColumns()
+   * @param averagingPeriod How often data will be written into the trace file
+   * @param filter Selection of the traced packets
+   */
+  static Ptr<L3RateTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time averagingPeriod = Seconds(0.5),
+          const L3TracerFilter& filter = L3TracerFilter());
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const std::vector<TraceSink::Column>&
+  GetColumns();
+
   // from L3Tracer
   virtual void
   PrintHeader(std::ostream& os) const;
@@ -125,6 +167,12 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data into a sink
+   */
+  void
+  Print(TraceSink& sink) const;
+
 protected:
   // from L3Tracer
   virtual void
@@ -159,21 +207,65 @@ private:
   PeriodicPrinter();
 
   void
-  Reset();
+  UpdateRates();
 
   void
-  AddInfo(const Face& face);
+  Reset();
+
+  /**
+   * @brief Get slot of counters of the face, allocating it if needed
+   */
+  size_t
+  GetSlot(const Face& face);
+
+  size_t
+  AddSlot(const Face& face);
+
+  size_t
+  NewSlot(nfd::FaceId faceId, const std::string& faceInfo);
 
-  bool
-  CheckName(const Name& name);  //Method to verify Interests/Data names
+  /**
+   * @brief Count a packet of \p size bytes in \p counter of the slot
+   */
+  void
+  Count(size_t slot, size_t counter, size_t size = 0);
 
 private:
-  shared_ptr<std::ostream> m_os;
+  enum Counter {
+    IN_INTERESTS,
+    OUT_INTERESTS,
+    IN_DATA,
+    OUT_DATA,
+    IN_NACKS,
+    OUT_NACKS,
+    SATISFIED_INTERESTS,
+    TIMED_OUT_INTERESTS,
+    OUT_SATISFIED_INTERESTS,
+    OUT_TIMED_OUT_INTERESTS,
+    N_COUNTERS
+  };
+
+  /**
+   * @brief Slot of counters that are not specific to a face (FaceId -1 in the trace)
+   */
+  static const size_t ALL_FACES_SLOT = 0;
+
+  shared_ptr<TraceSink> m_sink;
   Time m_period;
   EventId m_printEvent;
 
-  mutable std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
-  std::map<nfd::FaceId, std::string> m_faceInfos; // needed, because face may no longer exists at the time of stat printing
+  std::vector<size_t> m_faceSlots; ///< @brief slot of each face id, 0 if none
+  std::vector<nfd::FaceId> m_slotFaceIds;
+  std::vector<std::string> m_slotFaceInfos; // needed, because face may no longer exists at the time of stat printing
+  std::vector<uint8_t> m_isSlotUsed; ///< @brief whether anything was counted in the slot
+
+  // N_COUNTERS values for each slot
+  std::vector<double> m_packets;
+  std::vector<double> m_bytes;
+  std::vector<double> m_packetRates;
+  std::vector<double> m_kilobyteRates;
+
+  ::ndn::util::signal::ScopedConnection m_afterAddFace;
 };
 
 } // namespace ndn
@@ -23,20 +23,47 @@
 #include "ns3/config.h"
 #include "ns3/names.h"
 #include "ns3/callback.h"
+#include "ns3/simulator.h"
+#include "ns3/assert.h"
 
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 
 namespace ns3 {
 namespace ndn {
 
-L3Tracer::L3Tracer(Ptr<Node> node)
+L3Tracer::L3Tracer(Ptr<Node> node, const L3TracerFilter& filter/* = L3TracerFilter()*/)
   : m_nodePtr(node)
+  , m_filter(filter)
+  , m_isConnected(false)
 {
+  NS_ASSERT_MSG(m_filter.sampling > 0, "Sampling must be at least 1");
+
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
-  Connect();
+  if (!m_filter.faces.empty()) {
+    m_isFaceTraced.resize(*m_filter.faces.rbegin() + 1, 0);
+    for (nfd::FaceId faceId : m_filter.faces) {
+      m_isFaceTraced[faceId] = 1;
+    }
+  }
+
+  Time now = Simulator::Now();
+  if (m_filter.start < m_filter.stop && now < m_filter.stop) {
+    if (now < m_filter.start) {
+      m_startEvent = Simulator::Schedule(m_filter.start - now, &L3Tracer::Connect, this);
+    }
+    else {
+      Connect();
+    }
+
+    if (m_filter.stop != Time::Max()) {
+      m_stopEvent = Simulator::Schedule(m_filter.stop - now, &L3Tracer::Disconnect, this);
+    }
+  }
 
   std::string name = Names::FindName(node);
   if (!name.empty()) {
@@ -46,30 +73,163 @@ L3Tracer::L3Tracer(Ptr<Node> node)
 
 L3Tracer::L3Tracer(const std::string& node)
   : m_node(node)
+  , m_filter()
+  , m_isConnected(false)
 {
   Connect();
 }
 
-L3Tracer::~L3Tracer(){};
+L3Tracer::~L3Tracer()
+{
+  m_startEvent.Cancel();
+  m_stopEvent.Cancel();
+}
 
 void
 L3Tracer::Connect()
 {
+  if (m_isConnected) {
+    return;
+  }
+  m_isConnected = true;
+
   Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
 
-  l3->TraceConnectWithoutContext("OutInterests", MakeCallback(&L3Tracer::OutInterests, this));
-  l3->TraceConnectWithoutContext("InInterests", MakeCallback(&L3Tracer::InInterests, this));
-  l3->TraceConnectWithoutContext("OutData", MakeCallback(&L3Tracer::OutData, this));
-  l3->TraceConnectWithoutContext("InData", MakeCallback(&L3Tracer::InData, this));
-  l3->TraceConnectWithoutContext("OutNack", MakeCallback(&L3Tracer::OutNack, this));
-  l3->TraceConnectWithoutContext("InNack", MakeCallback(&L3Tracer::InNack, this));
+  l3->TraceConnectWithoutContext("OutInterests", MakeCallback(&L3Tracer::FilterOutInterests, this));
+  l3->TraceConnectWithoutContext("InInterests", MakeCallback(&L3Tracer::FilterInInterests, this));
+  l3->TraceConnectWithoutContext("OutData", MakeCallback(&L3Tracer::FilterOutData, this));
+  l3->TraceConnectWithoutContext("InData", MakeCallback(&L3Tracer::FilterInData, this));
+  l3->TraceConnectWithoutContext("OutNack", MakeCallback(&L3Tracer::FilterOutNack, this));
+  l3->TraceConnectWithoutContext("InNack", MakeCallback(&L3Tracer::FilterInNack, this));
 
   // satisfied/timed out PIs
   l3->TraceConnectWithoutContext("SatisfiedInterests",
-                                 MakeCallback(&L3Tracer::SatisfiedInterests, this));
+                                 MakeCallback(&L3Tracer::FilterSatisfiedInterests, this));
 
   l3->TraceConnectWithoutContext("TimedOutInterests",
-                                 MakeCallback(&L3Tracer::TimedOutInterests, this));
+                                 MakeCallback(&L3Tracer::FilterTimedOutInterests, this));
+}
+
+void
+L3Tracer::Disconnect()
+{
+  if (!m_isConnected) {
+    return;
+  }
+  m_isConnected = false;
+
+  Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
+
+  l3->TraceDisconnectWithoutContext("OutInterests",
+                                    MakeCallback(&L3Tracer::FilterOutInterests, this));
+  l3->TraceDisconnectWithoutContext("InInterests",
+                                    MakeCallback(&L3Tracer::FilterInInterests, this));
+  l3->TraceDisconnectWithoutContext("OutData", MakeCallback(&L3Tracer::FilterOutData, this));
+  l3->TraceDisconnectWithoutContext("InData", MakeCallback(&L3Tracer::FilterInData, this));
+  l3->TraceDisconnectWithoutContext("OutNack", MakeCallback(&L3Tracer::FilterOutNack, this));
+  l3->TraceDisconnectWithoutContext("InNack", MakeCallback(&L3Tracer::FilterInNack, this));
+
+  l3->TraceDisconnectWithoutContext("SatisfiedInterests",
+                                    MakeCallback(&L3Tracer::FilterSatisfiedInterests, this));
+
+  l3->TraceDisconnectWithoutContext("TimedOutInterests",
+                                    MakeCallback(&L3Tracer::FilterTimedOutInterests, this));
+}
+
+bool
+L3Tracer::IsTraced(TraceSource source, const Name& name, const Face* face)
+{
+  if (face != nullptr && !IsFaceTraced(*face)) {
+    return false;
+  }
+
+  if (!m_filter.prefixes.empty() &&
+      std::none_of(m_filter.prefixes.begin(), m_filter.prefixes.end(),
+                   [&name] (const Name& prefix) { return prefix.isPrefixOf(name); })) {
+    return false;
+  }
+
+  // packets of one exchange pass the trace sources in a fixed order, so a single counter
+  // would always pick the same trace source
+  if (m_filter.sampling > 1) {
+    nfd::FaceId faceId = face != nullptr ? face->getId() : nfd::face::INVALID_FACEID;
+    if (faceId >= m_nUntilSample.size()) {
+      m_nUntilSample.resize(faceId + 1, {});
+    }
+    uint32_t& nUntilSample = m_nUntilSample[faceId][source];
+    if (nUntilSample > 0) {
+      --nUntilSample;
+      return false;
+    }
+    nUntilSample = m_filter.sampling - 1;
+  }
+  return true;
+}
+
+void
+L3Tracer::FilterOutInterests(const Interest& interest, const Face& face)
+{
+  if (IsTraced(OUT_INTERESTS, interest.getName(), &face)) {
+    OutInterests(interest, face);
+  }
+}
+
+void
+L3Tracer::FilterInInterests(const Interest& interest, const Face& face)
+{
+  if (IsTraced(IN_INTERESTS, interest.getName(), &face)) {
+    InInterests(interest, face);
+  }
+}
+
+void
+L3Tracer::FilterOutData(const Data& data, const Face& face)
+{
+  if (IsTraced(OUT_DATA, data.getName(), &face)) {
+    OutData(data, face);
+  }
+}
+
+void
+L3Tracer::FilterInData(const Data& data, const Face& face)
+{
+  if (IsTraced(IN_DATA, data.getName(), &face)) {
+    InData(data, face);
+  }
+}
+
+void
+L3Tracer::FilterOutNack(const lp::Nack& nack, const Face& face)
+{
+  if (IsTraced(OUT_NACK, nack.getInterest().getName(), &face)) {
+    OutNack(nack, face);
+  }
+}
+
+void
+L3Tracer::FilterInNack(const lp::Nack& nack, const Face& face)
+{
+  if (IsTraced(IN_NACK, nack.getInterest().getName(), &face)) {
+    InNack(nack, face);
+  }
+}
+
+void
+L3Tracer::FilterSatisfiedInterests(const nfd::pit::Entry& entry, const Face& face,
+                                   const Data& data)
+{
+  // faces of the PIT entry are checked by the tracer
+  if (IsTraced(SATISFIED_INTERESTS, entry.getName(), nullptr)) {
+    SatisfiedInterests(entry, face, data);
+  }
+}
+
+void
+L3Tracer::FilterTimedOutInterests(const nfd::pit::Entry& entry)
+{
+  if (IsTraced(TIMED_OUT_INTERESTS, entry.getName(), nullptr)) {
+    TimedOutInterests(entry);
+  }
 }
 
 } // namespace ndn
@@ -25,6 +25,12 @@
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <array>
+#include <set>
+#include <vector>
 
 namespace ns3 {
 
@@ -33,6 +39,40 @@ class Packet;
 
 namespace ndn {
 
+/**
+ * @ingroup ndn-tracers
+ * @brief Selection of packets traced by network-layer tracers
+ *
+ * The filter is applied before any packet reaches the tracer.  Outside of the time window, the
+ * tracer is not even connected to the trace sources of L3Protocol.  Nodes are selected by
+ * installing tracers only on them.
+ */
+struct L3TracerFilter {
+  /**
+   * @brief Trace only packets with names under one of these prefixes (all packets if empty)
+   *
+   * For satisfied and timed out Interests, the name of the PIT entry is used.
+   */
+  std::vector<Name> prefixes;
+
+  /**
+   * @brief Trace only packets on faces with these ids (all faces if empty)
+   */
+  std::set<nfd::FaceId> faces;
+
+  /**
+   * @brief Trace one of every \p sampling packets
+   *
+   * Packets that pass the other filters are sampled separately for each trace source and face,
+   * so that each traced packet then stands for \p sampling packets of the same type on the same
+   * face.  Satisfied and timed out Interests are sampled per trace source only.
+   */
+  uint32_t sampling = 1;
+
+  Time start = Seconds(0);   ///< @brief start of tracing
+  Time stop = Time::Max();   ///< @brief end of tracing
+};
+
 /**
  * @ingroup ndn-tracers
  * @brief Base class for network-layer (incoming/outgoing Interests and Data) tracing of NDN stack
@@ -42,8 +82,9 @@ public:
   /**
    * @brief Trace constructor that attaches to the node using node pointer
    * @param node  pointer to the node
+   * @param filter  selection of the traced packets
    */
-  L3Tracer(Ptr<Node> node);
+  L3Tracer(Ptr<Node> node, const L3TracerFilter& filter = L3TracerFilter());
 
   /**
    * @brief Trace constructor that attaches to the node using node name
@@ -76,6 +117,19 @@ protected:
   void
   Connect();
 
+  void
+  Disconnect();
+
+  /**
+   * @brief Check whether packets on the face are traced
+   */
+  bool
+  IsFaceTraced(const Face& face) const
+  {
+    return m_filter.faces.empty()
+           || (face.getId() < m_isFaceTraced.size() && m_isFaceTraced[face.getId()]);
+  }
+
   virtual void
   OutInterests(const Interest&, const Face&) = 0;
 
@@ -100,10 +154,69 @@ protected:
   virtual void
   TimedOutInterests(const nfd::pit::Entry&) = 0;
 
+private:
+  enum TraceSource {
+    OUT_INTERESTS,
+    IN_INTERESTS,
+    OUT_DATA,
+    IN_DATA,
+    OUT_NACK,
+    IN_NACK,
+    SATISFIED_INTERESTS,
+    TIMED_OUT_INTERESTS,
+    N_TRACE_SOURCES
+  };
+
+  /**
+   * @brief Check whether a packet passes the filter, counting it for sampling
+   * @param face face of the packet, or nullptr if the face is not known
+   */
+  bool
+  IsTraced(TraceSource source, const Name& name, const Face* face);
+
+  void
+  FilterOutInterests(const Interest&, const Face&);
+
+  void
+  FilterInInterests(const Interest&, const Face&);
+
+  void
+  FilterOutData(const Data&, const Face&);
+
+  void
+  FilterInData(const Data&, const Face&);
+
+  void
+  FilterOutNack(const lp::Nack&, const Face&);
+
+  void
+  FilterInNack(const lp::Nack&, const Face&);
+
+  void
+  FilterSatisfiedInterests(const nfd::pit::Entry&, const Face&, const Data&);
+
+  void
+  FilterTimedOutInterests(const nfd::pit::Entry&);
+
 protected:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
+  const L3TracerFilter m_filter;
+
+private:
+  bool m_isConnected;
+  /**
+   * @brief Number of packets to skip before the next sample, by face id and trace source
+   *
+   * Packets without a known face use the slot of INVALID_FACEID.
+   */
+  std::vector<std::array<uint32_t, N_TRACE_SOURCES>> m_nUntilSample;
+  std::vector<uint8_t> m_isFaceTraced; ///< @brief by face id
+  EventId m_startEvent;
+  EventId m_stopEvent;
+
+protected:
   struct Stats {
     inline void
     Reset()
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-resource-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <sys/resource.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ResourceTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<TraceSink>, Ptr<ResourceTracer>>> g_tracers;
+
+/**
+ * @brief Get user and system CPU time used by the process, in seconds
+ *
+ * Unlike std::clock(), whose value wraps around after about 36 minutes where clock_t is 32 bits
+ * wide, this does not overflow in long simulations.
+ */
+static double
+GetCpuSeconds()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0.0;
+  }
+
+  auto toSeconds = [] (const struct timeval& tv) { return tv.tv_sec + tv.tv_usec / 1e6; };
+  return toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+}
+
+void
+ResourceTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+ResourceTracer::InstallAll(const std::string& file, Time period/* = Seconds(1.0)*/)
+{
+  Install(NodeContainer::GetGlobal(), file, period);
+}
+
+void
+ResourceTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        Time period/* = Seconds(1.0)*/)
+{
+  shared_ptr<TraceSink> sink = TraceSink::Open(file);
+  if (sink == nullptr) {
+    return;
+  }
+
+  Ptr<ResourceTracer> trace = Install(nodes, sink, period);
+
+  sink->writeHeader(GetColumns());
+
+  g_tracers.push_back(std::make_tuple(sink, trace));
+}
+
+Ptr<ResourceTracer>
+ResourceTracer::Install(const NodeContainer& nodes, shared_ptr<TraceSink> sink,
+                        Time period/* = Seconds(1.0)*/)
+{
+  NS_LOG_DEBUG("Nodes: " << nodes.GetN());
+
+  return Create<ResourceTracer>(sink, nodes, period);
+}
+
+ResourceTracer::ResourceTracer(shared_ptr<TraceSink> sink, const NodeContainer& nodes,
+                               Time period/* = Seconds(1.0)*/)
+  : m_sink(sink)
+  , m_wallStart(std::chrono::steady_clock::now())
+  , m_cpuStart(GetCpuSeconds())
+  , m_lastWall(m_wallStart)
+  , m_lastSim(Simulator::Now())
+  , m_lastEvents(Simulator::GetEventCount())
+{
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    std::string name = Names::FindName(*node);
+    if (name.empty()) {
+      name = boost::lexical_cast<std::string>((*node)->GetId());
+    }
+    m_nodes.push_back(std::make_tuple(*node, name));
+  }
+
+  SetPeriod(period);
+}
+
+ResourceTracer::~ResourceTracer()
+{
+  m_printEvent.Cancel();
+}
+
+void
+ResourceTracer::SetPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &ResourceTracer::PeriodicPrinter, this);
+}
+
+void
+ResourceTracer::PeriodicPrinter()
+{
+  Print(*m_sink);
+
+  m_printEvent = Simulator::Schedule(m_period, &ResourceTracer::PeriodicPrinter, this);
+}
+
+const std::vector<TraceSink::Column>&
+ResourceTracer::GetColumns()
+{
+  static const std::vector<TraceSink::Column> columns = {
+    {"Time", TraceSink::DOUBLE},
+    {"Node", TraceSink::STRING},
+    {"Type", TraceSink::STRING},
+    {"Value", TraceSink::DOUBLE},
+  };
+  return columns;
+}
+
+static const std::string PROCESS = "process";
+
+#define PRINTER(printName, value)                                                                  \
+  {                                                                                                \
+    static const std::string type(printName);                                                      \
+    sink.write({time, node, type, static_cast<double>(value)});                                    \
+  }
+
+void
+ResourceTracer::Print(TraceSink& sink)
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+
+  auto wallNow = std::chrono::steady_clock::now();
+  double wallPeriod = std::chrono::duration<double>(wallNow - m_lastWall).count();
+  double simPeriod = (Simulator::Now() - m_lastSim).ToDouble(Time::S);
+  uint64_t events = Simulator::GetEventCount();
+
+  {
+    const std::string& node = PROCESS;
+
+    PRINTER("RssBytes", MemUsage::Get());
+    PRINTER("PeakRssBytes", MemUsage::GetPeak());
+    PRINTER("HeapBytes", MemUsage::GetHeap());
+
+    PRINTER("CpuS", GetCpuSeconds() - m_cpuStart);
+    PRINTER("WallS", std::chrono::duration<double>(wallNow - m_wallStart).count());
+    PRINTER("SimRate", wallPeriod > 0 ? simPeriod / wallPeriod : 0.0);
+
+    PRINTER("Events", events);
+    PRINTER("EventRate", wallPeriod > 0 ? (events - m_lastEvents) / wallPeriod : 0.0);
+  }
+
+  m_lastWall = wallNow;
+  m_lastSim = Simulator::Now();
+  m_lastEvents = events;
+
+  for (const auto& node : m_nodes) {
+    PrintNode(sink, time, std::get<0>(node), std::get<1>(node));
+  }
+}
+
+void
+ResourceTracer::PrintNode(TraceSink& sink, double time, Ptr<Node> nodePtr,
+                          const std::string& node)
+{
+  Ptr<L3Protocol> l3 = nodePtr->GetObject<L3Protocol>();
+  if (l3 == 0) {
+    return;
+  }
+  shared_ptr<nfd::Forwarder> forwarder = l3->getForwarder();
+
+  PRINTER("Pit", forwarder->getPit().size());
+  PRINTER("Cs", forwarder->getCs().size());
+  PRINTER("Fib", forwarder->getFib().size());
+  PRINTER("Measurements", forwarder->getMeasurements().size());
+  PRINTER("DeadNonceList", forwarder->getDeadNonceList().size());
+  PRINTER("NameTree", forwarder->getNameTree().size());
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RESOURCE_TRACER_H
+#define NDN_RESOURCE_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-trace-sink.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/node-container.h>
+
+#include <chrono>
+#include <list>
+#include <tuple>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Tracer of resources used by the simulation
+ *
+ * Every period, the tracer writes one row for each of the following values of the simulation
+ * process (with "process" as Node):
+ *
+ * - ``RssBytes`` and ``PeakRssBytes``: resident set size (see MemUsage)
+ * - ``HeapBytes``: bytes allocated on the heap, if supported
+ * - ``CpuS`` and ``WallS``: CPU and wall-clock time since the tracer was installed, in seconds
+ * - ``SimRate``: simulated seconds per wall-clock second during the last period
+ * - ``Events`` and ``EventRate``: number of executed simulation events, in total and per
+ *   wall-clock second during the last period
+ *
+ * and, for each traced node, the number of entries of its tables: ``Pit``, ``Cs``, ``Fib``,
+ * ``Measurements``, ``DeadNonceList``, and ``NameTree``.
+ */
+class ResourceTracer : public SimpleRefCount<ResourceTracer> {
+public:
+  /**
+   * @brief Helper method to install tracer of the process and all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used.
+   *             If filename ends with ".bin", traces are written in binary format
+   *             (see BinaryTraceSink)
+   * @param period How often data will be written into the trace file (default, every second)
+   */
+  static void
+  InstallAll(const std::string& file, Time period = Seconds(1.0));
+
+  /**
+   * @brief Helper method to install tracer of the process and the selected simulation nodes
+   *
+   * @param nodes Nodes whose tables are traced (can be empty)
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often data will be written into the trace file (default, every second)
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, Time period = Seconds(1.0));
+
+  /**
+   * @brief Helper method to install tracer of the process and the selected simulation nodes
+   *
+   * @param nodes Nodes whose tables are traced (can be empty)
+   * @param sink Sink to which rows are written.  Its header needs to be written with GetColumns()
+   * @param period How often data will be written into the trace file (default, every second)
+   */
+  static Ptr<ResourceTracer>
+  Install(const NodeContainer& nodes, shared_ptr<TraceSink> sink, Time period = Seconds(1.0));
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Trace constructor
+   * @param sink   sink to which rows are written
+   * @param nodes  nodes whose tables are traced
+   * @param period how often rows will be written into the sink
+   */
+  ResourceTracer(shared_ptr<TraceSink> sink, const NodeContainer& nodes,
+                 Time period = Seconds(1.0));
+
+  /**
+   * @brief Destructor
+   */
+  ~ResourceTracer();
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const std::vector<TraceSink::Column>&
+  GetColumns();
+
+  /**
+   * @brief Write current usage of resources into a sink
+   */
+  void
+  Print(TraceSink& sink);
+
+private:
+  void
+  SetPeriod(const Time& period);
+
+  void
+  PeriodicPrinter();
+
+  void
+  PrintNode(TraceSink& sink, double time, Ptr<Node> node, const std::string& name);
+
+private:
+  shared_ptr<TraceSink> m_sink;
+  Time m_period;
+  EventId m_printEvent;
+
+  std::vector<std::tuple<Ptr<Node>, std::string>> m_nodes;
+
+  std::chrono::steady_clock::time_point m_wallStart;
+  double m_cpuStart; ///< @brief CPU time used by the process when the tracer was created
+
+  std::chrono::steady_clock::time_point m_lastWall;
+  Time m_lastSim;
+  uint64_t m_lastEvents;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RESOURCE_TRACER_H
@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-sink.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceSink");
+
+namespace ns3 {
+namespace ndn {
+
+const char BINARY_MAGIC[8] = {'N', 'D', 'N', 'T', 'R', 'C', '1', '\n'};
+
+const size_t BinaryTraceSink::DEFAULT_ROWS_PER_BLOCK = 4096;
+
+shared_ptr<TraceSink>
+TraceSink::Open(const std::string& file)
+{
+  if (file == "-") {
+    return make_shared<TextTraceSink>(shared_ptr<std::ostream>(&std::cout, std::bind([]{})));
+  }
+
+  const std::string binarySuffix = ".bin";
+  bool isBinary = file.size() >= binarySuffix.size()
+                  && file.compare(file.size() - binarySuffix.size(), binarySuffix.size(),
+                                  binarySuffix) == 0;
+
+  shared_ptr<std::ofstream> os(new std::ofstream());
+  os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc
+                         | (isBinary ? std::ios_base::binary : std::ios_base::openmode()));
+  if (!os->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+
+  if (isBinary) {
+    return make_shared<BinaryTraceSink>(os);
+  }
+  return make_shared<TextTraceSink>(os);
+}
+
+TextTraceSink::TextTraceSink(shared_ptr<std::ostream> os)
+  : m_os(std::move(os))
+{
+}
+
+void
+TextTraceSink::printColumnNames(std::ostream& os, const std::vector<Column>& columns)
+{
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (i > 0) {
+      os << "\t";
+    }
+    os << columns[i].name;
+  }
+}
+
+void
+TextTraceSink::writeHeader(const std::vector<Column>& columns)
+{
+  printColumnNames(*m_os, columns);
+  *m_os << "\n";
+}
+
+void
+TextTraceSink::write(std::initializer_list<Value> row)
+{
+  std::ostream& os = *m_os;
+  bool isFirst = true;
+  for (const Value& value : row) {
+    if (!isFirst) {
+      os << "\t";
+    }
+    isFirst = false;
+
+    switch (value.getType()) {
+    case DOUBLE:
+      os << value.getDouble();
+      break;
+    case INTEGER:
+      os << value.getInteger();
+      break;
+    case STRING:
+      os << value.getString();
+      break;
+    }
+  }
+  os << "\n";
+}
+
+void
+TextTraceSink::flush()
+{
+  m_os->flush();
+}
+
+BinaryTraceSink::BinaryTraceSink(shared_ptr<std::ostream> os, size_t rowsPerBlock)
+  : m_os(std::move(os))
+  , m_rowsPerBlock(rowsPerBlock)
+  , m_nRows(0)
+{
+  NS_ASSERT(m_rowsPerBlock > 0);
+}
+
+BinaryTraceSink::~BinaryTraceSink()
+{
+  flush();
+}
+
+template<typename T>
+static void
+append(std::vector<char>& buffer, const T& value)
+{
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+void
+BinaryTraceSink::writeHeader(const std::vector<Column>& columns)
+{
+  NS_ASSERT_MSG(m_types.empty(), "Header of the trace is already written");
+
+  std::vector<char> header(BINARY_MAGIC, BINARY_MAGIC + sizeof(BINARY_MAGIC));
+  append(header, static_cast<uint32_t>(columns.size()));
+  for (const Column& column : columns) {
+    append(header, static_cast<uint8_t>(column.type));
+    append(header, static_cast<uint32_t>(column.name.size()));
+    header.insert(header.end(), column.name.begin(), column.name.end());
+    m_types.push_back(column.type);
+  }
+  m_os->write(header.data(), header.size());
+
+  m_columns.resize(m_types.size());
+  for (size_t i = 0; i < m_types.size(); ++i) {
+    m_columns[i].reserve(m_rowsPerBlock * (m_types[i] == STRING ? sizeof(uint32_t) : 8));
+  }
+}
+
+void
+BinaryTraceSink::write(std::initializer_list<Value> row)
+{
+  NS_ASSERT_MSG(row.size() == m_types.size(), "Row does not match the header of the trace");
+
+  size_t i = 0;
+  for (const Value& value : row) {
+    NS_ASSERT_MSG(value.getType() == m_types[i], "Value does not match type of its column");
+    std::vector<char>& column = m_columns[i++];
+    switch (value.getType()) {
+    case DOUBLE:
+      append(column, value.getDouble());
+      break;
+    case INTEGER:
+      append(column, value.getInteger());
+      break;
+    case STRING:
+      append(column, intern(value.getString()));
+      break;
+    }
+  }
+
+  if (++m_nRows == m_rowsPerBlock) {
+    writeBlock();
+  }
+}
+
+void
+BinaryTraceSink::flush()
+{
+  writeBlock();
+  m_os->flush();
+}
+
+uint32_t
+BinaryTraceSink::intern(const std::string& str)
+{
+  // tracers keep their node and face names, so the same strings are written from the same
+  // addresses over and over
+  auto recent = m_recentIds.find(&str);
+  if (recent != m_recentIds.end() && m_strings[recent->second] == str) {
+    return recent->second;
+  }
+
+  auto it = m_stringIds.find(str);
+  if (it == m_stringIds.end()) {
+    it = m_stringIds.emplace(str, static_cast<uint32_t>(m_strings.size())).first;
+    m_strings.push_back(str);
+
+    m_newStrings.push_back('S');
+    append(m_newStrings, static_cast<uint32_t>(str.size()));
+    m_newStrings.insert(m_newStrings.end(), str.begin(), str.end());
+  }
+  m_recentIds[&str] = it->second;
+  return it->second;
+}
+
+void
+BinaryTraceSink::writeBlock()
+{
+  if (!m_newStrings.empty()) {
+    m_os->write(m_newStrings.data(), m_newStrings.size());
+    m_newStrings.clear();
+  }
+  if (m_nRows == 0) {
+    return;
+  }
+
+  std::vector<char> header;
+  header.push_back('R');
+  append(header, static_cast<uint32_t>(m_nRows));
+  m_os->write(header.data(), header.size());
+  for (std::vector<char>& column : m_columns) {
+    m_os->write(column.data(), column.size());
+    column.clear();
+  }
+  m_nRows = 0;
+}
+
+} // namespace ndn
+} // namespace ns3
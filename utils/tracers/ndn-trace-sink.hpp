@@ -0,0 +1,251 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_SINK_H
+#define NDN_TRACE_SINK_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <initializer_list>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Destination of rows written by tracers
+ *
+ * All tracers that share a file share one sink.  The columns are declared once, using
+ * writeHeader(), and then every row provides one value for each column, in the same order.
+ */
+class TraceSink {
+public:
+  enum ColumnType : uint8_t {
+    DOUBLE = 0,
+    INTEGER = 1,
+    STRING = 2
+  };
+
+  struct Column {
+    std::string name;
+    ColumnType type;
+  };
+
+  /**
+   * @brief Value of one column of a row
+   *
+   * A string value only refers to the string, which needs to exist until the row is written.
+   */
+  class Value {
+  public:
+    Value(double value)
+      : m_type(DOUBLE)
+    {
+      m_double = value;
+    }
+
+    Value(int32_t value)
+      : Value(static_cast<int64_t>(value))
+    {
+    }
+
+    Value(uint32_t value)
+      : Value(static_cast<int64_t>(value))
+    {
+    }
+
+    Value(uint64_t value)
+      : Value(static_cast<int64_t>(value))
+    {
+    }
+
+    Value(int64_t value)
+      : m_type(INTEGER)
+    {
+      m_integer = value;
+    }
+
+    Value(const std::string& value)
+      : m_type(STRING)
+    {
+      m_string = &value;
+    }
+
+    ColumnType
+    getType() const
+    {
+      return m_type;
+    }
+
+    double
+    getDouble() const
+    {
+      return m_double;
+    }
+
+    int64_t
+    getInteger() const
+    {
+      return m_integer;
+    }
+
+    const std::string&
+    getString() const
+    {
+      return *m_string;
+    }
+
+  private:
+    ColumnType m_type;
+    union {
+      double m_double;
+      int64_t m_integer;
+      const std::string* m_string;
+    };
+  };
+
+  /**
+   * @brief Open a sink that writes into a file
+   *
+   * If the name of the file ends with ".bin", rows are written in the binary format of
+   * BinaryTraceSink.  Otherwise, and when \p file is "-" (std::cout), they are written as
+   * tab-separated values.
+   *
+   * @returns the sink, or nullptr if the file cannot be opened for writing
+   */
+  static shared_ptr<TraceSink>
+  Open(const std::string& file);
+
+  virtual
+  ~TraceSink() = default;
+
+  /**
+   * @brief Declare the columns of all rows
+   */
+  virtual void
+  writeHeader(const std::vector<Column>& columns) = 0;
+
+  /**
+   * @brief Write a row with one value for each column
+   */
+  virtual void
+  write(std::initializer_list<Value> row) = 0;
+
+  /**
+   * @brief Write all buffered rows
+   */
+  virtual void
+  flush() = 0;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Trace sink that writes rows as tab-separated values
+ *
+ * The first line contains the names of the columns.  Numbers are formatted by the stream.
+ */
+class TextTraceSink : public TraceSink {
+public:
+  explicit
+  TextTraceSink(shared_ptr<std::ostream> os);
+
+  void
+  writeHeader(const std::vector<Column>& columns) override;
+
+  void
+  write(std::initializer_list<Value> row) override;
+
+  void
+  flush() override;
+
+  /**
+   * @brief Print names of the columns, separated by tabs and without end of line
+   */
+  static void
+  printColumnNames(std::ostream& os, const std::vector<Column>& columns);
+
+private:
+  shared_ptr<std::ostream> m_os;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Trace sink that writes rows in a compact binary format
+ *
+ * Rows are buffered and written in blocks, in which all values of a column are stored
+ * together.  Each distinct string is written only once and then referenced by its index.
+ * scripts/convert-trace.py converts the file into the tab-separated values that
+ * TextTraceSink would have written.
+ *
+ * All numbers are in host byte order.  The file starts with the "NDNTRC1\n" magic, followed by
+ * the uint32 number of columns and, for each column, its uint8 ColumnType and its name as
+ * uint32 length and characters.  Then follow chunks, each starting with a character:
+ *
+ * - 'S' defines the next string: uint32 length and characters
+ * - 'R' is a block of rows: uint32 number of rows, followed by the values of each column in
+ *   turn, as doubles, int64 integers, or uint32 indexes of strings
+ */
+class BinaryTraceSink : public TraceSink {
+public:
+  explicit
+  BinaryTraceSink(shared_ptr<std::ostream> os, size_t rowsPerBlock = DEFAULT_ROWS_PER_BLOCK);
+
+  ~BinaryTraceSink() override;
+
+  void
+  writeHeader(const std::vector<Column>& columns) override;
+
+  void
+  write(std::initializer_list<Value> row) override;
+
+  void
+  flush() override;
+
+public:
+  static const size_t DEFAULT_ROWS_PER_BLOCK;
+
+private:
+  uint32_t
+  intern(const std::string& str);
+
+  void
+  writeBlock();
+
+private:
+  shared_ptr<std::ostream> m_os;
+  const size_t m_rowsPerBlock;
+
+  std::vector<ColumnType> m_types;
+  std::vector<std::vector<char>> m_columns;
+  size_t m_nRows;
+
+  std::vector<std::string> m_strings;
+  std::unordered_map<std::string, uint32_t> m_stringIds;
+  std::unordered_map<const std::string*, uint32_t> m_recentIds; ///< @brief by address of the value
+  std::vector<char> m_newStrings; ///< @brief definitions of strings not yet written
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_SINK_H